@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace bench {
+/**
+ * @brief prevent the compiler from optimizing away a value
+ */
+template <typename T> inline void doNotOptimize(const T& value) { asm volatile("" : : "r,m"(value) : "memory"); }
+
+/**
+ * @brief time a single batch of calls to a function
+ *
+ * Every function is timed by this same loop, through a pointer, so where the loop happens to be placed in the binary
+ * affects every function the same way. A kernel which compiles to the same instructions as its baseline could
+ * otherwise look a quarter slower, just because its loop was aligned differently.
+ *
+ * @return double the time taken by a single call, in nanoseconds
+ */
+[[gnu::noinline]] inline double timeBatch(void (*call)(void*, int), void* f, int iterations) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) call(f, i);
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+/**
+ * @brief time a single batch of calls to a function
+ *
+ * @return double the time taken by a single call, in nanoseconds
+ */
+template <typename F> double timeBatch(F& f, int iterations) {
+    return timeBatch([](void* f, int i) { (*static_cast<F*>(f))(i); }, &f, iterations);
+}
+
+/**
+ * @brief get the median of a list of times
+ */
+inline double median(std::vector<double> times) {
+    std::sort(times.begin(), times.end());
+    const std::size_t middle = times.size() / 2;
+    return times.size() % 2 ? times[middle] : (times[middle - 1] + times[middle]) / 2;
+}
+
+/**
+ * @brief measure how long two functions take to run
+ *
+ * The functions are run in alternating batches, so both are equally affected by other processes running on the host,
+ * and the median batch of each is used, so a few batches slowed down by the host don't decide the result.
+ *
+ * @param a the first function to measure
+ * @param b the second function to measure
+ * @param iterations how many times to run each function in a batch
+ * @param batches how many batches of each function to run
+ * @return std::pair<double, double> the time taken by a single call of each function, in nanoseconds
+ */
+template <typename F, typename G>
+std::pair<double, double> measure(F&& a, G&& b, int iterations = 1000000, int batches = 31) {
+    std::vector<double> timesA;
+    std::vector<double> timesB;
+    for (int batch = 0; batch < batches; batch++) {
+        timesA.push_back(timeBatch(a, iterations));
+        timesB.push_back(timeBatch(b, iterations));
+    }
+    return {median(timesA), median(timesB)};
+}
+
+/**
+ * @brief compare the time taken by a kernel against a baseline, and print the result
+ *
+ * Shared hosts are noisy, so a kernel which looks slower than the tolerance is measured again, up to 3 times, before
+ * it is reported as a regression. A real regression is slower every time.
+ *
+ * @param name the name of the kernel
+ * @param kernel the kernel to measure
+ * @param baseline the baseline to compare against
+ * @param tolerance how much slower the kernel can be than the baseline before it is reported as a regression
+ * @param iterations how many times to run each function in a batch
+ * @return true if the kernel is within the tolerance
+ */
+template <typename F, typename G>
+bool compare(const char* name, F&& kernel, G&& baseline, double tolerance, int iterations = 1000000) {
+    double kernelTime = 0;
+    double baselineTime = 0;
+    bool pass = false;
+    for (int attempt = 0; attempt < 3 && !pass; attempt++) {
+        std::tie(kernelTime, baselineTime) = measure(kernel, baseline, iterations);
+        pass = kernelTime / baselineTime <= 1 + tolerance;
+    }
+    std::printf("%-18s %9.3f ns  baseline %9.3f ns  ratio %5.3f  %s\n", name, kernelTime, baselineTime,
+                kernelTime / baselineTime, pass ? "ok" : "REGRESSION");
+    return pass;
+}
+} // namespace bench
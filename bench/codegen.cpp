@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * Checks that every units_<kernel> function in an assembly file compiles to the same instructions as raw_<kernel>.
+ *
+ * Register allocation and scheduling can differ between two otherwise identical functions, so instead of comparing
+ * the listings line by line, the multiset of floating point operations and calls of each function is compared. Moves,
+ * integer instructions and stack frame setup are ignored, since they only differ when registers are allocated
+ * differently. Tail calls are treated the same as calls, since a function returning a class type is sometimes not tail
+ * called when the same function returning a double is.
+ *
+ * Fixed point kernels, named units_<kernel>Fixed, are hand written Q16.16 math on the raw side, so their integer
+ * instructions differ from the units kernel by design. Comparing their floating point operations would always pass with
+ * none on either side, so instead the units kernel is checked to have no floating point operations or calls at all.
+ *
+ * Works with x86 and ARM assembly generated by GCC.
+ *
+ * usage: codegen <file.s>
+ */
+
+/**
+ * @brief whether an instruction is a floating point operation other than a move
+ */
+static bool isFloatingPoint(const std::string& mnemonic) {
+    if (mnemonic.rfind("mov", 0) == 0 || mnemonic.rfind("vmov", 0) == 0 || mnemonic == "vpush" || mnemonic == "vpop" ||
+        mnemonic.rfind("vldr", 0) == 0 || mnemonic.rfind("vstr", 0) == 0 || mnemonic.rfind("vldm", 0) == 0 ||
+        mnemonic.rfind("vstm", 0) == 0) {
+        return false;
+    }
+    // SSE scalar and packed operations
+    const bool x86 = mnemonic.ends_with("sd") || mnemonic.ends_with("pd") || mnemonic.ends_with("ss") ||
+                     mnemonic.ends_with("ps") || mnemonic.rfind("ucomi", 0) == 0 ||
+                     mnemonic.rfind("comi", 0) == 0 || mnemonic.rfind("cvt", 0) == 0;
+    // VFP and NEON operations
+    const bool arm = mnemonic[0] == 'v';
+    return x86 || arm;
+}
+
+/**
+ * @brief parse the instructions of every function in an assembly file
+ */
+static std::map<std::string, std::vector<std::string>> parse(std::istream& in) {
+    std::map<std::string, std::vector<std::string>> functions;
+    std::vector<std::string>* current = nullptr;
+    std::string line;
+    while (std::getline(in, line)) {
+        const auto comment = line.find_first_of("@#");
+        // '#' also starts immediate operands on ARM, so only strip it when followed by a space
+        if (comment != std::string::npos && (line[comment] == '@' || line.compare(comment, 2, "# ") == 0)) {
+            line.erase(comment);
+        }
+        if (line.empty()) continue;
+        if (line[0] != '\t' && line[0] != ' ') {
+            // a label. Local labels (.L) are branch targets inside the current function
+            const auto colon = line.find(':');
+            if (colon != std::string::npos && line[0] != '.') current = &functions[line.substr(0, colon)];
+            continue;
+        }
+        std::istringstream words(line);
+        std::string mnemonic, operands;
+        words >> mnemonic;
+        std::getline(words >> std::ws, operands);
+        if (current == nullptr || mnemonic.empty() || mnemonic[0] == '.') continue;
+        // tail calls to other functions are jumps. Branches to local labels are ignored
+        const bool jump = mnemonic == "jmp" || mnemonic == "b";
+        if ((jump && operands.rfind(".L", 0) != 0) || mnemonic == "call" || mnemonic == "bl") {
+            current->push_back("call " + operands);
+        } else if (isFloatingPoint(mnemonic)) {
+            current->push_back(mnemonic);
+        }
+    }
+    return functions;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::fprintf(stderr, "usage: %s <file.s>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    std::ifstream file(argv[1]);
+    if (!file) {
+        std::fprintf(stderr, "could not open %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    std::map<std::string, std::vector<std::string>> functions = parse(file);
+
+    bool pass = true;
+    int kernels = 0;
+    for (auto& [name, instructions] : functions) {
+        if (name.rfind("units_", 0) != 0) continue;
+        const std::string kernel = name.substr(6);
+        if (kernel.ends_with("Fixed")) {
+            kernels++;
+            std::printf("%-16s units %3zu  integer only  %s\n", kernel.c_str(), instructions.size(),
+                        instructions.empty() ? "ok" : "FLOATING POINT");
+            for (const std::string& i : instructions) std::printf("    + %s\n", i.c_str());
+            pass &= instructions.empty();
+            continue;
+        }
+        auto raw = functions.find("raw_" + kernel);
+        if (raw == functions.end()) {
+            std::printf("%-16s no raw_%s to compare against\n", kernel.c_str(), kernel.c_str());
+            pass = false;
+            continue;
+        }
+        kernels++;
+        std::vector<std::string> a = instructions;
+        std::vector<std::string> b = raw->second;
+        std::sort(a.begin(), a.end());
+        std::sort(b.begin(), b.end());
+        const bool same = a == b;
+        std::printf("%-16s units %3zu  raw %3zu  %s\n", kernel.c_str(), a.size(), b.size(),
+                    same ? "ok" : "DIFFERENT");
+        if (!same) {
+            // show which instructions only appear in one of the functions
+            std::vector<std::string> onlyUnits, onlyRaw;
+            std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(onlyUnits));
+            std::set_difference(b.begin(), b.end(), a.begin(), a.end(), std::back_inserter(onlyRaw));
+            for (const std::string& i : onlyUnits) std::printf("    + %s\n", i.c_str());
+            for (const std::string& i : onlyRaw) std::printf("    - %s\n", i.c_str());
+            pass = false;
+        }
+    }
+    if (kernels == 0) {
+        std::printf("no kernels found in %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,233 @@
+#include "bench.hpp"
+#include "lemlib/DrivetrainCharacterization.hpp"
+#include "lemlib/FeedforwardCharacterization.hpp"
+#include "lemlib/sim/DifferentialDrive.hpp"
+#include "lemlib/sim/SimEncoder.hpp"
+#include "lemlib/sim/SimImu.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace units;
+
+/**
+ * Characterizes a simulated drivetrain and checks that the fitted constants match the model, both as they are logged
+ * and from the recorded telemetry, then checks that the PID of the velocity controller corrects the error left by a
+ * feedforward with a wrong kV. Also measures the cost of a controller update against the same controller written by
+ * hand with raw doubles.
+ */
+constexpr double TOLERANCE = 0.25;
+
+// the telemetry clock is a plain function, so the simulation it reads has to be global
+static lemlib::sim::Simulation drivetrainSim;
+
+static bool check(const char* name, double value, double bound) {
+    const bool pass = value <= bound;
+    std::printf("%-18s error %9.3g  bound %9.3g  %s\n", name, value, bound, pass ? "ok" : "INACCURATE");
+    return pass;
+}
+
+/**
+ * @brief get the relative error of a quantity
+ */
+template <isQuantity Q> static double relative(Q value, Q expected) {
+    return std::abs(value.internal() / expected.internal() - 1);
+}
+
+struct RawController {
+        double kS, kV, kA, kP, kI, kD, maxVoltage;
+        double integral = 0, previousError = 0;
+        bool started = false;
+
+        // the library update is called out of line, so the baseline can't fold the constant inputs of the bench either.
+        // Quantities have a user provided copy constructor, so they are passed and returned through memory, and the
+        // baseline does the same
+        [[gnu::noinline]] void update(const double& target, const double& targetAcceleration, const double& measured,
+                                      const double& dt, double& result) {
+            if (!std::isfinite(target) || !std::isfinite(targetAcceleration) || !std::isfinite(measured) ||
+                !std::isfinite(dt) || !(dt > 0)) {
+                result = INFINITY;
+                return;
+            }
+            const double error = target - measured;
+            const double derivative = started ? (error - previousError) / dt : 0;
+            const double friction = target == 0 ? 0 : (target < 0 ? -kS : kS);
+            const double partial =
+                friction + kV * target + kA * targetAcceleration + kP * error + kD * derivative;
+            const double output = partial + kI * (integral + error * dt);
+            if (std::abs(output) <= maxVoltage || (output < 0) != (error < 0)) integral += error * dt;
+            previousError = error;
+            started = true;
+            result = std::clamp(partial + kI * integral, -maxVoltage, maxVoltage);
+        }
+};
+
+/**
+ * @brief run a velocity controller on the left side of a simulated drivetrain, and measure how well it tracks a
+ * trapezoidal velocity
+ *
+ * @return double the root mean square velocity error, in rad/s
+ */
+static double track(lemlib::sim::DifferentialDriveModel model, lemlib::VelocityController controller) {
+    lemlib::sim::Simulation sim;
+    lemlib::sim::DifferentialDrive drive(model);
+    sim.add(drive);
+    const double radius = to_m(model.wheelDiameter) / 2;
+    // accelerate to 30 rad/s over 0.5 s, cruise for 1 s, then decelerate over 0.5 s
+    const auto target = [](double t) { return 30 * std::clamp(std::min(t, 2 - t) / 0.5, 0.0, 1.0); };
+    double error = 0;
+    int count = 0;
+    for (int i = 0; i < 200; i++) {
+        const double t = i * 0.01;
+        const AngularVelocity measured = from_radps(to_mps(drive.getLeftVelocity()) / radius);
+        const AngularVelocity velocity = from_radps(target(t));
+        const AngularAcceleration acceleration = from_radps2((target(t + 0.01) - target(t)) / 0.01);
+        const Voltage output = controller.update(velocity, acceleration, measured, 10_msec);
+        drive.setVoltage(output, output);
+        sim.advance(10_msec);
+        const double difference = to_mps(drive.getLeftVelocity()) / radius - target(t + 0.01);
+        error += difference * difference;
+        count++;
+    }
+    return std::sqrt(error / count);
+}
+
+int main() {
+    bool pass = true;
+
+    // samples which follow the model exactly are fitted exactly
+    lemlib::FeedforwardFit exact;
+    for (int i = 0; i < 100; i++) {
+        const double v = (i % 2 ? -1 : 1) * (1 + i * 0.3);
+        const double a = std::sin(i * 0.7) * 20;
+        exact.add(from_volt(0.7 * (v < 0 ? -1 : 1) + 0.15 * v + 0.03 * a), from_radps(v), from_radps2(a));
+    }
+    const lemlib::FeedforwardGains exactGains = exact.solve();
+    pass &= check("exact kS", std::abs(to_volt(exactGains.kS) - 0.7), 1e-9);
+    pass &= check("exact kV", std::abs(to_volt(exactGains.kV * 1_radps) - 0.15), 1e-9);
+    pass &= check("exact kA", std::abs(to_volt(exactGains.kA * 1_radps2) - 0.03), 1e-9);
+    pass &= check("exact rms", to_volt(exact.rmsError(exactGains)), 1e-6);
+
+    // samples with a single velocity can't separate kS from kV
+    lemlib::FeedforwardFit constant;
+    for (int i = 0; i < 100; i++) constant.add(3_volt, 10_radps, 0_radps2);
+    pass &= check("singular fit", to_volt(constant.solve().kS) == INFINITY ? 0 : INFINITY, 0);
+
+    // characterize the left side of a simulated drivetrain, sampled at 100 Hz. The model is linear, so the wheel
+    // constants are the linear constants scaled by the radius of the wheel
+    const lemlib::sim::DifferentialDriveModel model;
+    lemlib::sim::Simulation sim;
+    lemlib::sim::DifferentialDrive drive(model);
+    sim.add(drive);
+    lemlib::FeedforwardCharacterization characterization;
+    while (!characterization.isDone()) {
+        const Voltage output = characterization.update(drive.getLeftAngle(), sim.getTime());
+        drive.setVoltage(output, output);
+        sim.advance(10_msec);
+    }
+    const lemlib::FeedforwardGains gains = characterization.getGains();
+    const double radius = to_m(model.wheelDiameter) / 2;
+    const double kS = to_volt(model.kS);
+    const double kV = to_volt(model.kV * 1_mps) * radius;
+    const double kA = to_volt(model.kA * 1_mps2) * radius;
+    std::printf("%-18s kS %.4f V  kV %.4f V/(rad/s)  kA %.4f V/(rad/s^2)  from %zu samples\n", "characterized",
+                to_volt(gains.kS), to_volt(gains.kV * 1_radps), to_volt(gains.kA * 1_radps2),
+                characterization.getFit().getCount());
+    pass &= check("sim kS", std::abs(to_volt(gains.kS) / kS - 1), 0.05);
+    pass &= check("sim kV", std::abs(to_volt(gains.kV * 1_radps) / kV - 1), 0.05);
+    pass &= check("sim kA", std::abs(to_volt(gains.kA * 1_radps2) / kA - 1), 0.05);
+
+    // characterize a whole drivetrain with smaller wheels, recording the telemetry, and fit the recording again
+    const lemlib::sim::DifferentialDriveModel small = {.trackWidth = 10.5_in, .wheelDiameter = 2.75_in,
+                                                       .kV = 4_volt / 1_mps, .kA = 1_volt / 1_mps2};
+    lemlib::sim::DifferentialDrive smallDrive(small);
+    lemlib::sim::SimEncoder leftEncoder([&] { return smallDrive.getLeftAngle(); });
+    lemlib::sim::SimEncoder rightEncoder([&] { return smallDrive.getRightAngle(); });
+    lemlib::sim::SimImu imu([&] { return smallDrive.getHeading(); }, 0_sec);
+    drivetrainSim.add(smallDrive);
+    drivetrainSim.add(imu);
+    std::FILE* recording = std::tmpfile();
+    logger::Telemetry telemetry(recording,
+                                [] { return std::uint32_t(std::llround(to_sec(drivetrainSim.getTime()) * 1e6)); });
+    lemlib::DrivetrainCharacterization drivetrain(leftEncoder, rightEncoder, imu, telemetry);
+    Length distance = 0_in;
+    while (!drivetrain.isDone()) {
+        const auto [left, right] = drivetrain.update(drivetrainSim.getTime());
+        if (drivetrain.getTest() == lemlib::DrivetrainTest::QUASISTATIC_BACKWARD && distance == 0_in) {
+            distance = units::abs(smallDrive.getPose().getX());
+        }
+        smallDrive.setVoltage(left, right);
+        drivetrainSim.advance(10_msec);
+    }
+    lemlib::DrivetrainFit recorded;
+    logger::TelemetryDecoder decoder([](const logger::TelemetryDecoder::Schema&) {},
+                                     [&](const logger::TelemetryDecoder::Schema&, std::uint32_t timestamp,
+                                         const std::vector<double>& values) {
+                                         recorded.add({.test = lemlib::DrivetrainTest(values[0]),
+                                                       .leftVoltage = from_volt(values[1]),
+                                                       .rightVoltage = from_volt(values[2]),
+                                                       .leftAngle = Angle(values[3]),
+                                                       .rightAngle = Angle(values[4]),
+                                                       .rotation = Angle(values[5]),
+                                                       .time = from_sec(timestamp / 1e6)});
+                                     });
+    std::rewind(recording);
+    std::uint8_t buffer[4096];
+    std::size_t read;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), recording)) > 0) decoder.feed(buffer, read);
+    std::fclose(recording);
+    // a wrong nominal diameter is corrected by the measured distance
+    const lemlib::DrivetrainConstants online = drivetrain.getFit().solve(3.25_in, distance);
+    const lemlib::DrivetrainConstants offline = recorded.solve(3.25_in, distance);
+    for (const auto& [name, constants] : {std::pair("drivetrain", online), std::pair("recorded", offline)}) {
+        std::printf("%-18s kS %.4f V  kV %.4f V/(m/s)  kA %.4f V/(m/s^2)  track %.3f in  wheel %.3f in\n", name,
+                    to_volt(constants.kS), to_volt(constants.kV * 1_mps), to_volt(constants.kA * 1_mps2),
+                    to_in(constants.trackWidth), to_in(constants.wheelDiameter));
+    }
+    pass &= check("drivetrain kS", relative(online.kS, small.kS), 0.05);
+    pass &= check("drivetrain kV", relative(online.kV, small.kV), 0.05);
+    pass &= check("drivetrain kA", relative(online.kA, small.kA), 0.05);
+    pass &= check("track width", relative(online.trackWidth, small.trackWidth), 1e-3);
+    pass &= check("wheel diameter", relative(online.wheelDiameter, small.wheelDiameter), 1e-3);
+    // the recording stores 32 bit floats, which barely changes the fit
+    pass &= check("recorded kV", relative(offline.kV, online.kV), 1e-3);
+    pass &= check("recorded kA", relative(offline.kA, online.kA), 1e-2);
+    pass &= check("recorded track", relative(offline.trackWidth, online.trackWidth), 1e-3);
+
+    // a drivetrain which needs 20% more voltage than the characterized one, like when it is carrying game elements.
+    // The feedforward alone falls behind, and the PID catches up
+    lemlib::sim::DifferentialDriveModel heavy = model;
+    heavy.kV = 1.2 * model.kV;
+    const lemlib::VelocityPidGains pid = {.kP = 0.5_volt / 1_radps, .kI = 2_volt / 1_stRad};
+    const double feedforwardError = track(heavy, lemlib::VelocityController(gains));
+    const double pidError = track(heavy, lemlib::VelocityController(gains, pid));
+    std::printf("%-18s rms %9.3g rad/s  with pid %9.3g rad/s\n", "tracking", feedforwardError, pidError);
+    pass &= check("tracking ratio", pidError / feedforwardError, 0.5);
+    pass &= check("matched tracking", track(model, lemlib::VelocityController(gains, pid)), 0.5);
+
+    // samples are read from memory, so updates can't be evaluated at compile time
+    constexpr int SIZE = 1024;
+    std::vector<double> targets, measurements;
+    for (int i = 0; i < SIZE; i++) {
+        targets.push_back((i * 7919 % 100) / 2.0 - 25);
+        measurements.push_back(targets.back() + (i * 104729 % 21) / 10.0 - 1);
+    }
+    lemlib::VelocityController controller(gains, pid);
+    RawController raw {to_volt(gains.kS), to_volt(gains.kV * 1_radps), to_volt(gains.kA * 1_radps2), 0.5, 2, 0, 12};
+    pass &= bench::compare(
+        "controller",
+        [&](int i) {
+            bench::doNotOptimize(controller.update(from_radps(targets[i % SIZE]), 0_radps2,
+                                                   from_radps(measurements[i % SIZE]), 10_msec));
+        },
+        [&](int i) {
+            const double target = targets[i % SIZE];
+            const double measured = measurements[i % SIZE];
+            double output;
+            raw.update(target, 0, measured, 0.01, output);
+            bench::doNotOptimize(output);
+        },
+        TOLERANCE);
+    return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
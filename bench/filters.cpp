@@ -0,0 +1,210 @@
+#include "bench.hpp"
+#include "lemlib/filters/BiquadFilter.hpp"
+#include "lemlib/filters/EmaFilter.hpp"
+#include "lemlib/filters/KalmanFilter1D.hpp"
+#include "lemlib/filters/MedianFilter.hpp"
+#include "lemlib/filters/SavitzkyGolayDerivative.hpp"
+#include "units/Angle.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+/**
+ * Measures the cost of a single sample through each filter in lemlib/filters, against the same filter written by hand
+ * with raw doubles. The median and derivative baselines compute the output directly from the window, which is how
+ * they are usually written. Also checks each filter against a reference calculation.
+ */
+constexpr double TOLERANCE = 0.25;
+constexpr int SIZE = 1024;
+constexpr std::size_t MEDIAN_SIZE = 5;
+constexpr std::size_t DERIVATIVE_SIZE = 15;
+
+/**
+ * Filters written by hand with raw doubles, the way each consumer would write them without lemlib/filters
+ */
+struct RawEma {
+        double alpha;
+        double value = 0;
+        bool initialized = false;
+
+        double update(double sample) {
+            if (!initialized) {
+                value = sample;
+                initialized = true;
+            } else {
+                value += (sample - value) * alpha;
+            }
+            return value;
+        }
+};
+
+struct RawBiquad {
+        double b0, b1, b2, a1, a2;
+        double z1 = 0, z2 = 0;
+        bool initialized = false;
+
+        explicit RawBiquad(double normalizedCutoff) {
+            const double w0 = 2 * M_PI * normalizedCutoff;
+            const double alpha = std::sin(w0) / (2 * M_SQRT1_2);
+            const double a0 = 1 + alpha;
+            b0 = (1 - std::cos(w0)) / 2 / a0;
+            b1 = 2 * b0;
+            b2 = b0;
+            a1 = -2 * std::cos(w0) / a0;
+            a2 = (1 - alpha) / a0;
+        }
+
+        double update(double x) {
+            if (!initialized) {
+                z1 = x * (1 - b0);
+                z2 = x * (b2 - a2);
+                initialized = true;
+            }
+            const double y = b0 * x + z1;
+            z1 = b1 * x - a1 * y + z2;
+            z2 = b2 * x - a2 * y;
+            return y;
+        }
+};
+
+struct RawKalman {
+        double processVariance;
+        double measurementVariance;
+        double estimate = 0, variance = 0;
+        bool initialized = false;
+
+        double update(double measurement) {
+            if (!initialized) {
+                estimate = measurement;
+                variance = measurementVariance;
+                initialized = true;
+                return estimate;
+            }
+            variance += processVariance;
+            const double gain = variance / (variance + measurementVariance);
+            estimate += gain * (measurement - estimate);
+            variance = (1 - gain) * variance;
+            return estimate;
+        }
+};
+
+static bool check(const char* name, double error, double bound) {
+    const bool pass = error <= bound;
+    std::printf("%-18s max error %9.3g  bound %9.3g  %s\n", name, error, bound, pass ? "ok" : "INACCURATE");
+    return pass;
+}
+
+int main() {
+    // samples are read from memory, so filters can't be evaluated at compile time
+    std::vector<double> samples(SIZE);
+    for (int i = 0; i < SIZE; i++) samples[i] = std::sin(i * 0.05) + (i * 7919 % 200 - 100) / 1000.0;
+    bool pass = true;
+
+    // the median matches sorting the window
+    {
+        lemlib::MedianFilter<Angle, MEDIAN_SIZE> filter;
+        double error = 0;
+        for (int i = 0; i < SIZE; i++) {
+            const double median = to_stRad(filter.update(Angle(samples[i])));
+            const int count = std::min<int>(i + 1, MEDIAN_SIZE);
+            std::array<double, MEDIAN_SIZE> window {};
+            std::copy(samples.begin() + i + 1 - count, samples.begin() + i + 1, window.begin());
+            std::sort(window.begin(), window.begin() + count);
+            error = std::max(error, std::abs(median - window[(count - 1) / 2]));
+        }
+        pass &= check("median", error, 0);
+    }
+    // samples which aren't finite are ignored, instead of corrupting the sorted window
+    {
+        lemlib::MedianFilter<Angle, MEDIAN_SIZE> filter;
+        const std::array<double, 9> input = {1, NAN, 5, INFINITY, 3, -INFINITY, 2, 4, NAN};
+        double output = 0;
+        for (const double sample : input) output = to_stRad(filter.update(Angle(sample)));
+        // the window is 1, 5, 3, 2, 4
+        pass &= check("median non-finite", std::abs(output - 3), 0);
+    }
+    // the running sums match the weighted sum of the window, and the derivative of a line is its slope
+    {
+        lemlib::SavitzkyGolayDerivative<Angle, DERIVATIVE_SIZE> filter(10_msec);
+        lemlib::SavitzkyGolayDerivative<Angle, DERIVATIVE_SIZE> line(10_msec);
+        constexpr int HALF = DERIVATIVE_SIZE / 2;
+        double error = 0, lineError = 0;
+        for (int i = 0; i < SIZE; i++) {
+            const double derivative = to_radps(filter.update(Angle(samples[i])));
+            const double slope = to_radps(line.update(Angle(3 + 0.02 * i)));
+            // the window starts full of the first sample, so the output is only exact once it has been replaced
+            if (i < int(DERIVATIVE_SIZE)) continue;
+            lineError = std::max(lineError, std::abs(slope - 2));
+            double weighted = 0;
+            for (int j = -HALF; j <= HALF; j++) weighted += j * samples[i - HALF + j];
+            const double expected = weighted / (HALF * (HALF + 1) * (2 * HALF + 1) / 3.0) / 0.01;
+            error = std::max(error, std::abs(derivative - expected));
+        }
+        pass &= check("savitzky-golay", error, 1e-9);
+        pass &= check("derivative of line", lineError, 1e-9);
+    }
+    // a low pass filter passes a constant input through unchanged from the first sample
+    {
+        auto filter = lemlib::BiquadFilter<Angle>::lowPass(5_Hz, 10_msec);
+        double error = 0;
+        for (int i = 0; i < 100; i++) error = std::max(error, std::abs(to_stRad(filter.update(Angle(1.5))) - 1.5));
+        pass &= check("biquad dc", error, 1e-12);
+    }
+    // the gain converges to the steady state solution of the Riccati equation
+    {
+        lemlib::KalmanFilter1D<Angle> filter(Angle(0.1), Angle(0.3));
+        for (int i = 0; i < 100; i++) filter.update(Angle(samples[i]));
+        const double q = 0.01, r = 0.09;
+        const double prior = (q + std::sqrt(q * q + 4 * q * r)) / 2;
+        const double posterior = prior * r / (prior + r);
+        const double deviation = filter.getStandardDeviation().internal();
+        pass &= check("kalman variance", std::abs(deviation * deviation - posterior), 1e-12);
+    }
+
+    lemlib::EmaFilter<Angle> ema(0.1);
+    RawEma rawEma {0.1};
+    pass &= bench::compare(
+        "ema", [&](int i) { bench::doNotOptimize(ema.update(Angle(samples[i % SIZE]))); },
+        [&](int i) { bench::doNotOptimize(rawEma.update(samples[i % SIZE])); }, TOLERANCE);
+
+    lemlib::MedianFilter<Angle, MEDIAN_SIZE> median;
+    std::array<double, MEDIAN_SIZE> rawWindow {};
+    pass &= bench::compare(
+        "median", [&](int i) { bench::doNotOptimize(median.update(Angle(samples[i % SIZE]))); },
+        [&](int i) {
+            rawWindow[i % MEDIAN_SIZE] = samples[i % SIZE];
+            std::array<double, MEDIAN_SIZE> sorted = rawWindow;
+            std::nth_element(sorted.begin(), sorted.begin() + MEDIAN_SIZE / 2, sorted.end());
+            bench::doNotOptimize(sorted[MEDIAN_SIZE / 2]);
+        },
+        TOLERANCE);
+
+    auto biquad = lemlib::BiquadFilter<Angle>::lowPass(5_Hz, 10_msec);
+    RawBiquad rawBiquad(0.05);
+    pass &= bench::compare(
+        "biquad", [&](int i) { bench::doNotOptimize(biquad.update(Angle(samples[i % SIZE]))); },
+        [&](int i) { bench::doNotOptimize(rawBiquad.update(samples[i % SIZE])); }, TOLERANCE);
+
+    lemlib::SavitzkyGolayDerivative<Angle, DERIVATIVE_SIZE> derivative(10_msec);
+    std::array<double, DERIVATIVE_SIZE> rawDerivativeWindow {};
+    pass &= bench::compare(
+        "savitzky-golay", [&](int i) { bench::doNotOptimize(derivative.update(Angle(samples[i % SIZE]))); },
+        [&](int i) {
+            rawDerivativeWindow[i % DERIVATIVE_SIZE] = samples[i % SIZE];
+            double weighted = 0;
+            for (std::size_t j = 0; j < DERIVATIVE_SIZE; j++) {
+                weighted += (int(j) - int(DERIVATIVE_SIZE / 2)) * rawDerivativeWindow[(i + 1 + j) % DERIVATIVE_SIZE];
+            }
+            bench::doNotOptimize(weighted / 280.0 / 0.01);
+        },
+        TOLERANCE);
+
+    lemlib::KalmanFilter1D<Angle> kalman(Angle(0.1), Angle(0.3));
+    RawKalman rawKalman {0.01, 0.09};
+    pass &= bench::compare(
+        "kalman", [&](int i) { bench::doNotOptimize(kalman.update(Angle(samples[i % SIZE]))); },
+        [&](int i) { bench::doNotOptimize(rawKalman.update(samples[i % SIZE])); }, TOLERANCE);
+    return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
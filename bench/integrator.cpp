@@ -0,0 +1,80 @@
+#include "bench.hpp"
+#include "units/Integrator.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace units;
+
+/**
+ * Measures the cost of a single tick of pose integration, against arc integration written by hand with raw doubles and
+ * libm, the way odometry has been written without the integrator. Also checks that integrating at a constant velocity
+ * reaches the same pose as the closed form solution.
+ */
+constexpr double TOLERANCE = 0.25;
+
+struct RawPose {
+        double x;
+        double y;
+        double theta;
+};
+
+static RawPose rawIntegrate(RawPose pose, double linear, double angular, double dt) {
+    const double distance = linear * dt;
+    const double deltaTheta = angular * dt;
+    double chord = distance;
+    if (deltaTheta != 0) chord = 2 * std::sin(deltaTheta / 2) * distance / deltaTheta;
+    const double chordAngle = pose.theta + deltaTheta / 2;
+    return {pose.x + chord * std::cos(chordAngle), pose.y + chord * std::sin(chordAngle), pose.theta + deltaTheta};
+}
+
+int main() {
+    constexpr int SIZE = 1024;
+    // velocities are read from memory, so ticks can't be evaluated at compile time
+    std::vector<VelocityPose> velocities;
+    std::vector<AccelerationPose> accelerations;
+    std::vector<double> linear(SIZE), angular(SIZE);
+    for (int i = 0; i < SIZE; i++) {
+        linear[i] = (i * 7919 % 200) / 100.0;
+        angular[i] = (i * 104729 % 200) / 50.0 - 2;
+        velocities.emplace_back(from_mps(linear[i]), 0_mps, from_radps(angular[i]));
+        accelerations.emplace_back(from_mps2(angular[i]), 0_mps2, from_radps2(linear[i]));
+    }
+    bool pass = true;
+
+    // a full circle at 100 Hz ends where it started
+    Transform2D pose;
+    for (int i = 0; i < 400; i++) pose = integrate(pose, VelocityPose(1_mps, 0_mps, 90_degps), 10_msec);
+    const double error = std::hypot(to_m(pose.getX()), to_m(pose.getY()));
+    std::printf("%-18s error %9.3g m  %s\n", "full circle", error, error < 1e-9 ? "ok" : "INACCURATE");
+    pass &= error < 1e-9;
+
+    Transform2D transform;
+    RawPose raw {0, 0, 0};
+    pass &= bench::compare(
+        "velocity tick",
+        [&](int i) {
+            transform = integrate(transform, velocities[i % SIZE], 5_msec);
+            bench::doNotOptimize(transform);
+        },
+        [&](int i) {
+            raw = rawIntegrate(raw, linear[i % SIZE], angular[i % SIZE], 0.005);
+            bench::doNotOptimize(raw);
+        },
+        TOLERANCE);
+    VelocityPose velocity(0_mps, 0_mps, 0_radps);
+    pass &= bench::compare(
+        "acceleration tick",
+        [&](int i) {
+            transform = integrate(transform, velocity, accelerations[i % SIZE], 5_msec);
+            bench::doNotOptimize(transform);
+        },
+        [&](int i) {
+            // the velocity is advanced by half a tick to integrate at the average velocity, like the integrator
+            raw = rawIntegrate(raw, linear[i % SIZE] + angular[i % SIZE] * 0.0025,
+                               angular[i % SIZE] + linear[i % SIZE] * 0.0025, 0.005);
+            bench::doNotOptimize(raw);
+        },
+        TOLERANCE);
+    return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
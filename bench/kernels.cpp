@@ -0,0 +1,96 @@
+#include "kernels.hpp"
+
+using namespace units;
+
+Length units_distance(Length x1, Length y1, Length x2, Length y2) {
+    V2Position a(x1, y1);
+    V2Position b(x2, y2);
+    return a.distanceTo(b);
+}
+
+void raw_distance(const double& x1, const double& y1, const double& x2, const double& y2, double* result) {
+    *result = std::sqrt((x1 - x2) * (x1 - x2) + (y1 - y2) * (y1 - y2));
+}
+
+Length units_magnitude(Length x, Length y) { return V2Position(x, y).magnitude(); }
+
+void raw_magnitude(const double& x, const double& y, double* result) { *result = std::sqrt(x * x + y * y); }
+
+Angle units_wrap(Angle angle) { return constrainAngle180(angle); }
+
+void raw_wrap(const double& angle, double* result) {
+    const double wrapped = std::fmod(angle + 180 * (M_PI / 180), M_TWOPI);
+    *result = wrapped < 0 ? wrapped + 180 * (M_PI / 180) : wrapped - 180 * (M_PI / 180);
+}
+
+Length units_transformX(Length poseX, Angle theta, Length x, Length y) {
+    return poseX + x * units::cos(theta) - y * units::sin(theta);
+}
+
+void raw_transformX(const double& poseX, const double& theta, const double& x, const double& y, double* result) {
+    *result = poseX + x * std::cos(theta) - y * std::sin(theta);
+}
+
+LinearVelocity units_arcVelocity(AngularVelocity left, AngularVelocity right, Length diameter) {
+    return toLinear<AngularVelocity>((left + right) / 2.0, diameter);
+}
+
+void raw_arcVelocity(const double& left, const double& right, const double& diameter, double* result) {
+    *result = (left + right) / 2.0 * (diameter / 2.0);
+}
+
+Length units_sumDistances(const Length* xs, const Length* ys, int count) {
+    Length total = 0_m;
+    for (int i = 1; i < count; i++) {
+        V2Position a(xs[i - 1], ys[i - 1]);
+        V2Position b(xs[i], ys[i]);
+        total += a.distanceTo(b);
+    }
+    // quantities are returned through memory, so returning the sum by name would accumulate in the return slot
+    return Length(total);
+}
+
+void raw_sumDistances(const double* xs, const double* ys, int count, double* result) {
+    double total = 0;
+    for (int i = 1; i < count; i++) {
+        total += std::sqrt((xs[i - 1] - xs[i]) * (xs[i - 1] - xs[i]) + (ys[i - 1] - ys[i]) * (ys[i - 1] - ys[i]));
+    }
+    *result = total;
+}
+
+LengthF units_distanceF(LengthF x1, LengthF y1, LengthF x2, LengthF y2) {
+    Vector2D<LengthF> a(x1, y1);
+    Vector2D<LengthF> b(x2, y2);
+    return a.distanceTo(b);
+}
+
+void raw_distanceF(const float& x1, const float& y1, const float& x2, const float& y2, float* result) {
+    *result = std::sqrt((x1 - x2) * (x1 - x2) + (y1 - y2) * (y1 - y2));
+}
+
+LengthF units_transformXF(LengthF poseX, AngleF theta, LengthF x, LengthF y) {
+    return poseX + x * units::cos(theta) - y * units::sin(theta);
+}
+
+void raw_transformXF(const float& poseX, const float& theta, const float& x, const float& y, float* result) {
+    *result = poseX + x * std::cos(theta) - y * std::sin(theta);
+}
+
+FixedAbsement units_integrateFixed(const FixedLength* errors, int count, FixedTime dt) {
+    FixedAbsement total(0);
+    for (int i = 0; i < count; i++) total += errors[i] * dt;
+    return FixedAbsement(total);
+}
+
+static int32_t saturate(int64_t value) { return value > INT32_MAX ? INT32_MAX : value < INT32_MIN ? INT32_MIN : value; }
+
+void raw_integrateFixed(const int32_t* errors, int count, const int32_t& dt, int32_t* result) {
+    int32_t total = 0;
+    for (int i = 0; i < count; i++) {
+        // round to nearest, with ties away from zero
+        const int64_t product = int64_t(errors[i]) * dt;
+        const int64_t rounded = product < 0 ? -((-product + 0x8000) >> 16) : (product + 0x8000) >> 16;
+        total = saturate(int64_t(total) + saturate(rounded));
+    }
+    *result = total;
+}
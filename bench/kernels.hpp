@@ -0,0 +1,50 @@
+#pragma once
+
+#include "units/Pose.hpp"
+#include <cstdint>
+
+using FixedLength = units::WithRep<Length, units::Q16_16>;
+using FixedTime = units::WithRep<Time, units::Q16_16>;
+using FixedAbsement = units::WithRep<Multiplied<Length, Time>, units::Q16_16>;
+
+/**
+ * Hot kernels written twice: once with the units library, and once by hand with raw doubles using the same
+ * algorithm. The units library adds no runtime cost if each pair compiles to the same instructions.
+ *
+ * Kernels are extern "C" so the codegen check can find them by name in the generated assembly. Each quantity kernel is
+ * named units_<kernel>, and its raw counterpart raw_<kernel>.
+ *
+ * Quantities have a user provided copy constructor, which the prebuilt hardware library was compiled against, so they
+ * are passed and returned through memory instead of in registers. The raw kernels take their inputs by reference and
+ * write their result through a pointer, so both kernels of a pair are called the same way.
+ */
+extern "C" {
+Length units_distance(Length x1, Length y1, Length x2, Length y2);
+void raw_distance(const double& x1, const double& y1, const double& x2, const double& y2, double* result);
+
+Length units_magnitude(Length x, Length y);
+void raw_magnitude(const double& x, const double& y, double* result);
+
+Angle units_wrap(Angle angle);
+void raw_wrap(const double& angle, double* result);
+
+Length units_transformX(Length poseX, Angle theta, Length x, Length y);
+void raw_transformX(const double& poseX, const double& theta, const double& x, const double& y, double* result);
+
+LinearVelocity units_arcVelocity(AngularVelocity left, AngularVelocity right, Length diameter);
+void raw_arcVelocity(const double& left, const double& right, const double& diameter, double* result);
+
+Length units_sumDistances(const Length* xs, const Length* ys, int count);
+void raw_sumDistances(const double* xs, const double* ys, int count, double* result);
+
+// float quantities must not be promoted to double
+LengthF units_distanceF(LengthF x1, LengthF y1, LengthF x2, LengthF y2);
+void raw_distanceF(const float& x1, const float& y1, const float& x2, const float& y2, float* result);
+
+LengthF units_transformXF(LengthF poseX, AngleF theta, LengthF x, LengthF y);
+void raw_transformXF(const float& poseX, const float& theta, const float& x, const float& y, float* result);
+
+// fixed point quantities must only use integer instructions. The raw kernel is Q16.16 math written by hand
+FixedAbsement units_integrateFixed(const FixedLength* errors, int count, FixedTime dt);
+void raw_integrateFixed(const int32_t* errors, int count, const int32_t& dt, int32_t* result);
+}
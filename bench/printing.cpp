@@ -0,0 +1,86 @@
+#include "LemLog/logger/topic.hpp"
+#include "bench.hpp"
+#include "units/Angle.hpp"
+#include <cstdlib>
+#include <sstream>
+#include <string_view>
+#include <vector>
+
+using Momentum = Multiplied<Mass, LinearVelocity>;
+using RootLength = Rooted<Length, std::ratio<2>>;
+
+// suffixes are generated at compile time
+static_assert(std::string_view(UnitSuffix<Momentum>::value) == "_kg_m_s^-1");
+static_assert(std::string_view(UnitSuffix<RootLength>::value) == "_m^1/2");
+static_assert(std::string_view(UnitSuffix<Exponentiated<Time, std::ratio<-3, 2>>>::value) == "_s^-3/2");
+static_assert(std::string_view(UnitSuffix<Length>::value) == " m");
+static_assert(std::string_view(UnitSuffix<AngleF>::value) == " rad");
+// named suffixes don't depend on the storage type
+static_assert(std::string_view(UnitSuffix<units::WithRep<Length, units::Q16_16>>::value) == " m");
+static_assert(std::string_view(UnitSuffix<units::WithRep<LinearVelocity, units::Q32_32>>::value) == " mps");
+static_assert(std::string_view(UnitSuffix<units::WithRep<Momentum, units::Q16_16>>::value) == "_kg_m_s^-1");
+// quantities are logged as their value and a pointer to their suffix, so records stay trivially copyable
+static_assert(std::is_same_v<decltype(logger::expandArg(1_m)), std::tuple<double, const char*>>);
+static_assert(std::is_same_v<decltype(logger::expandArg(1)), std::tuple<int>>);
+
+/**
+ * @brief print an unnamed quantity by looping over its dimensions, the way operator<< used to
+ */
+static void printRuntimeSuffix(std::ostream& os, double quantity,
+                               const std::array<std::pair<intmax_t, intmax_t>, 8>& dims) {
+    static constinit std::array<const char*, 8> prefixes {"_kg", "_m", "_s", "_A", "_rad", "_K", "_cd", "_mol"};
+    os << quantity;
+    for (size_t i = 0; i != 8; i++) {
+        if (dims[i].first != 0) {
+            os << prefixes[i];
+            if (dims[i].first != 1 || dims[i].second != 1) os << '^' << dims[i].first;
+            if (dims[i].second != 1) os << '/' << dims[i].second;
+        }
+    }
+}
+
+/**
+ * Measures the cost of printing a quantity with an unnamed unit to a stream, against printing its value followed by a
+ * string literal, and against building the suffix at runtime. Also checks the generated suffixes at compile time.
+ */
+int main() {
+    constexpr int SIZE = 1024;
+    constexpr double TOLERANCE = 0.25;
+    // values are read from memory, so they can't be formatted at compile time
+    std::vector<double> values(SIZE);
+    for (int i = 0; i < SIZE; i++) values[i] = (i * 7919 % 1000) / 10.0;
+    std::ostringstream os;
+    bool pass = true;
+
+    os << Momentum(2.5) << ' ' << RootLength(4.0);
+    const bool formatted = os.str() == "2.5_kg_m_s^-1 4_m^1/2";
+    std::printf("%-18s %s  %s\n", "format", os.str().c_str(), formatted ? "ok" : "INACCURATE");
+    pass &= formatted;
+
+    const auto rewind = [&] { os.seekp(0); };
+    pass &= bench::compare(
+        "print unnamed",
+        [&](int i) {
+            rewind();
+            os << Momentum(values[i % SIZE]);
+        },
+        [&](int i) {
+            rewind();
+            os << values[i % SIZE] << "_kg_m_s^-1";
+        },
+        TOLERANCE, 100000);
+    static constexpr std::array<std::pair<intmax_t, intmax_t>, 8> dims {{{1, 1}, {1, 1}, {-1, 1}}};
+    // the generated suffix must be faster than building it at runtime
+    pass &= bench::compare(
+        "runtime suffix",
+        [&](int i) {
+            rewind();
+            os << Momentum(values[i % SIZE]);
+        },
+        [&](int i) {
+            rewind();
+            printRuntimeSuffix(os, values[i % SIZE], dims);
+        },
+        0, 100000);
+    return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,152 @@
+#include "bench.hpp"
+#include "lemlib/MotionProfile.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace units;
+
+/**
+ * Checks motion profiles against their closed form durations and against their constraints, and measures the cost of
+ * looking up a setpoint against the same table lookup written by hand with raw floats. Also prints how long generating
+ * each profile takes.
+ */
+constexpr double TOLERANCE = 0.25;
+
+static bool check(const char* name, double value, double bound) {
+    const bool pass = value <= bound;
+    std::printf("%-18s error %9.3g  bound %9.3g  %s\n", name, value, bound, pass ? "ok" : "INACCURATE");
+    return pass;
+}
+
+/**
+ * @brief largest violation of the velocity, acceleration, and jerk limits, relative to each limit
+ */
+static double violation(const lemlib::MotionProfile& profile, const lemlib::ProfileConstraints& constraints) {
+    constexpr double dt = 0.01;
+    double worst = 0;
+    double previous = 0;
+    for (std::size_t i = 0; i < profile.size(); i++) {
+        const lemlib::ProfilePoint point = profile.sample(from_sec(i * dt));
+        const double a = point.acceleration.internal();
+        worst = std::max(worst, point.velocity.internal() / constraints.maxVelocity.internal() - 1);
+        worst = std::max(worst, std::abs(a) / constraints.maxAcceleration.internal() - 1);
+        if (i > 0 && !std::isinf(constraints.maxJerk.internal())) {
+            worst = std::max(worst, std::abs(a - previous) / dt / constraints.maxJerk.internal() - 1);
+        }
+        previous = a;
+    }
+    return worst;
+}
+
+template <typename F> static lemlib::MotionProfile timeGeneration(const char* name, F&& generate) {
+    const auto start = std::chrono::steady_clock::now();
+    lemlib::MotionProfile profile = generate();
+    const auto end = std::chrono::steady_clock::now();
+    std::printf("%-18s %9.3f us  %zu entries  %.3f s\n", name,
+                std::chrono::duration<double, std::micro>(end - start).count(), profile.size(),
+                to_sec(profile.getDuration()));
+    return profile;
+}
+
+struct RawEntry {
+        float distance, velocity, acceleration, curvature, x, y, heading;
+};
+
+struct RawPoint {
+        double time, distance, velocity, acceleration, curvature, x, y, heading;
+};
+
+int main() {
+    bool pass = true;
+    const lemlib::ProfileConstraints trapezoidal {.maxVelocity = 1.5_mps, .maxAcceleration = 3_mps2};
+    lemlib::ProfileConstraints sCurve = trapezoidal;
+    sCurve.maxJerk = 30_mps3;
+
+    // straight lines have a closed form duration: L / v + v / a, plus a / j for an S-curve. The velocity limits are
+    // interpolated between nodes 1 cm apart, which rounds the corners of a trapezoid by microseconds, and an S-curve
+    // chooses its jerk once per period, so it can take a few periods longer
+    const auto trapezoid = timeGeneration("generate trapezoid", [&] {
+        return lemlib::MotionProfile::generate(2_m, trapezoidal);
+    });
+    pass &= check("trapezoid time", std::abs(to_sec(trapezoid.getDuration()) - (2 / 1.5 + 1.5 / 3)), 1e-4);
+    pass &= check("trapezoid limits", violation(trapezoid, trapezoidal), 1e-5);
+    const auto curve = timeGeneration("generate s-curve", [&] { return lemlib::MotionProfile::generate(2_m, sCurve); });
+    pass &= check("s-curve time", std::abs(to_sec(curve.getDuration()) - (2 / 1.5 + 1.5 / 3 + 3.0 / 30)), 0.05);
+    pass &= check("s-curve limits", violation(curve, sCurve), 1e-5);
+    pass &= check("s-curve end", std::abs(to_m(curve.sample(curve.getDuration()).distance) - 2), 1e-6);
+
+    // a move shorter than the node spacing, from rest to rest, is a triangle: it accelerates for half the distance and
+    // brakes for the other half, taking 2 sqrt(L / a). A straight path of two points is the same move
+    const lemlib::ProfileConstraints shortMove {.maxVelocity = 1_mps, .maxAcceleration = 2_mps2};
+    const auto nudge = lemlib::MotionProfile::generate(0.5_cm, shortMove);
+    pass &= check("short move time", std::abs(to_sec(nudge.getDuration()) - 2 * std::sqrt(0.005 / 2)), 1e-6);
+    // one entry per period, and one at the end
+    pass &= check("short move entries", std::abs(double(nudge.size()) - (0.1 / 0.01 + 1)), 1);
+    Vector2DArray<Length> nudgePath;
+    nudgePath.push_back(V2Position(0_m, 0_m));
+    nudgePath.push_back(V2Position(0.5_cm, 0_m));
+    const auto nudgeAlong = lemlib::MotionProfile::generate(nudgePath, shortMove);
+    pass &= check("short path time", std::abs(to_sec(nudgeAlong.getDuration()) - 2 * std::sqrt(0.005 / 2)), 1e-6);
+    pass &= check("short path end", std::abs(to_m(nudgeAlong.sample(nudgeAlong.getDuration()).distance) - 0.005),
+                  1e-9);
+
+    // a quarter circle with a radius of 0.5 m, where the lateral acceleration limits the velocity to sqrt(0.5) m/s
+    Vector2DArray<Length> arc;
+    for (int i = 0; i <= 100; i++) {
+        const double theta = M_PI / 2 * i / 100;
+        arc.push_back(V2Position(from_m(0.5 * std::sin(theta)), from_m(0.5 - 0.5 * std::cos(theta))));
+    }
+    sCurve.maxLateralAcceleration = 1_mps2;
+    const auto turn = timeGeneration("generate arc", [&] { return lemlib::MotionProfile::generate(arc, sCurve); });
+    double fastest = 0, curvatureError = 0;
+    for (Time t = 0_sec; t < turn.getDuration(); t += 10_msec) {
+        const lemlib::ProfilePoint point = turn.sample(t);
+        fastest = std::max(fastest, point.velocity.internal());
+        curvatureError = std::max(curvatureError, std::abs(point.curvature.internal() - 2));
+    }
+    pass &= check("arc velocity", fastest - std::sqrt(0.5), 1e-3);
+    pass &= check("arc curvature", curvatureError, 1e-3);
+    pass &= check("arc limits", violation(turn, sCurve), 1e-5);
+    lemlib::ProfilePoint end = turn.sample(turn.getDuration());
+    pass &= check("arc end", std::hypot(to_m(end.pose.getX()) - 0.5, to_m(end.pose.getY()) - 0.5), 1e-3);
+
+    // lookups at times read from memory, so they can't be evaluated at compile time
+    constexpr int SIZE = 1024;
+    std::vector<Time> times;
+    std::vector<double> rawTimes;
+    for (int i = 0; i < SIZE; i++) {
+        times.push_back(turn.getDuration() * ((i * 7919 % SIZE) / double(SIZE)));
+        rawTimes.push_back(times.back().internal());
+    }
+    std::vector<RawEntry> table;
+    for (std::size_t i = 0; i < turn.size(); i++) {
+        lemlib::ProfilePoint point = turn.sample(from_sec(i * 0.01));
+        table.push_back({float(point.distance.internal()), float(point.velocity.internal()),
+                         float(point.acceleration.internal()), float(point.curvature.internal()),
+                         float(point.pose.getX().internal()), float(point.pose.getY().internal()),
+                         float(point.pose.getOrientation().internal())});
+    }
+    const double duration = to_sec(turn.getDuration());
+    pass &= bench::compare(
+        "sample", [&](int i) { bench::doNotOptimize(turn.sample(times[i % SIZE])); },
+        [&](int i) {
+            const double t = std::clamp(rawTimes[i % SIZE], 0.0, duration);
+            const std::size_t j = std::min(std::size_t(t / 0.01 + 1e-6), table.size() - 2);
+            const RawEntry& a = table[j];
+            const RawEntry& b = table[j + 1];
+            const float f = float(std::max(t - j * 0.01, 0.0) / std::min(0.01, duration - j * 0.01));
+            const RawPoint result {t,
+                                   a.distance + (b.distance - a.distance) * f,
+                                   a.velocity + (b.velocity - a.velocity) * f,
+                                   a.acceleration,
+                                   a.curvature + (b.curvature - a.curvature) * f,
+                                   a.x + (b.x - a.x) * f,
+                                   a.y + (b.y - a.y) * f,
+                                   a.heading + (b.heading - a.heading) * f};
+            bench::doNotOptimize(result);
+        },
+        TOLERANCE);
+    return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
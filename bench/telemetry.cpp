@@ -0,0 +1,75 @@
+#include "LemLog/logger/telemetry.hpp"
+#include "units/units.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/**
+ * Encodes telemetry into a temporary file and decodes it again, checking that schemas of exactly the maximum packet
+ * size survive the round trip, that larger schemas are dropped instead of overflowing the packet, and that samples
+ * decode to the values they were sent with.
+ */
+static bool check(const char* name, bool pass) {
+    std::printf("%-18s %s\n", name, pass ? "ok" : "FAILED");
+    return pass;
+}
+
+static std::uint32_t fixedClock() { return 1234; }
+
+struct Decoded {
+        std::vector<logger::TelemetryDecoder::Schema> schemas;
+        std::vector<std::vector<double>> samples;
+        std::uint32_t malformed = 0;
+};
+
+/**
+ * @brief decode everything written to a stream
+ */
+static Decoded decode(std::FILE* stream) {
+    Decoded decoded;
+    logger::TelemetryDecoder decoder(
+        [&](const logger::TelemetryDecoder::Schema& schema) { decoded.schemas.push_back(schema); },
+        [&](const logger::TelemetryDecoder::Schema&, std::uint32_t, const std::vector<double>& values) {
+            decoded.samples.push_back(values);
+        });
+    std::rewind(stream);
+    std::uint8_t buffer[256];
+    std::size_t read;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), stream)) > 0) decoder.feed(buffer, read);
+    decoded.malformed = decoder.getMalformed();
+    return decoded;
+}
+
+int main() {
+    bool pass = true;
+    std::FILE* stream = std::tmpfile();
+    if (stream == nullptr) {
+        std::perror("tmpfile");
+        return EXIT_FAILURE;
+    }
+    logger::Telemetry telemetry(stream, fixedClock);
+
+    // a schema is the stream ID, the packet type, the channel ID, the name and its length, the number of fields, and
+    // the type, length and name of each field. Two fields named "x" and "y" take 6 bytes
+    const std::size_t header = logger::telemetry::STREAM_ID.size() + 4 + 6;
+    const std::string largest(logger::MAX_TELEMETRY_PACKET - header, 'a');
+    const std::string tooLarge(logger::MAX_TELEMETRY_PACKET - header + 1, 'b');
+    logger::Telemetry::Channel<Length, int> channel(telemetry, largest, {"x", "y"});
+    pass &= check("largest schema", telemetry.getDropped() == 0);
+    logger::Telemetry::Channel<Length, int> dropped(telemetry, tooLarge, {"x", "y"});
+    pass &= check("schema too large", telemetry.getDropped() == 1);
+    channel.send(1.5_m, -3);
+    std::fflush(stream);
+
+    const Decoded decoded = decode(stream);
+    pass &= check("no malformed", decoded.malformed == 0);
+    pass &= check("schema round trip", decoded.schemas.size() == 1 && decoded.schemas[0].name == largest &&
+                                           decoded.schemas[0].fields.size() == 2 &&
+                                           decoded.schemas[0].fields[0].first == "x" &&
+                                           decoded.schemas[0].fields[1].first == "y");
+    pass &= check("sample round trip",
+                  decoded.samples.size() == 1 && decoded.samples[0] == std::vector<double> {1.5, -3});
+    std::fclose(stream);
+    return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
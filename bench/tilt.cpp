@@ -0,0 +1,90 @@
+#include "bench.hpp"
+#include "lemlib/TiltCompensator.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace units;
+
+/**
+ * Measures the cost of tilt compensating a single odometry sample, against the same fusion and projection written by
+ * hand with raw doubles and libm. Also checks that the filter removes a bias in the IMU pitch, and that displacements
+ * on a ramp are projected onto the level plane.
+ */
+constexpr double TOLERANCE = 0.25;
+constexpr double GRAVITY = 9.80665;
+
+struct RawTilt {
+        double rollOffset = 0;
+        double pitchOffset = 0;
+        double a00 = 1, a01 = 0, a10 = 0, a11 = 1;
+
+        void update(double roll, double pitch, double ax, double ay, double az) {
+            const double magnitude = std::sqrt(ax * ax + ay * ay + az * az);
+            if (std::abs(magnitude - GRAVITY) <= 0.1 * GRAVITY) {
+                rollOffset += 0.02 * std::remainder(std::atan2(ay, az) - (roll + rollOffset), 2 * M_PI);
+                pitchOffset += 0.02 * (std::atan2(-ax, std::sqrt(ay * ay + az * az)) - (pitch + pitchOffset));
+            }
+            roll += rollOffset;
+            pitch += pitchOffset;
+            a00 = std::cos(pitch);
+            a01 = std::sin(pitch) * std::sin(roll);
+            a11 = std::cos(roll);
+        }
+
+        void compensate(double& x, double& y) const {
+            const double levelX = x * a00 + y * a01;
+            y = x * a10 + y * a11;
+            x = levelX;
+        }
+};
+
+int main() {
+    constexpr int SIZE = 1024;
+    // samples are read from memory, so updates can't be evaluated at compile time
+    std::vector<double> rolls(SIZE), pitches(SIZE), ax(SIZE), ay(SIZE), az(SIZE), dx(SIZE), dy(SIZE);
+    for (int i = 0; i < SIZE; i++) {
+        rolls[i] = (i * 7919 % 200 - 100) / 1000.0;
+        pitches[i] = (i * 104729 % 200 - 100) / 1000.0;
+        ax[i] = -GRAVITY * std::sin(pitches[i]) + (i % 7 - 3) * 0.1;
+        ay[i] = GRAVITY * std::cos(pitches[i]) * std::sin(rolls[i]);
+        az[i] = GRAVITY * std::cos(pitches[i]) * std::cos(rolls[i]);
+        dx[i] = (i * 31 % 100) / 5000.0;
+        dy[i] = (i * 17 % 100 - 50) / 5000.0;
+    }
+    bool pass = true;
+
+    // parked on a 15 degree ramp, facing uphill, with an IMU which reads 2 degrees too much pitch
+    lemlib::TiltCompensator tilt;
+    const double ramp = -15 * M_PI / 180;
+    const V3Acceleration gravity(from_mps2(-GRAVITY * std::sin(ramp)), 0_mps2, from_mps2(GRAVITY * std::cos(ramp)));
+    for (int i = 0; i < 1000; i++) tilt.update(0_stRad, Angle(ramp + 2 * M_PI / 180), 0_stRad, gravity);
+    const double pitchError = std::abs(tilt.getPitch().internal() - ramp);
+    std::printf("%-18s error %9.3g rad  %s\n", "pitch bias", pitchError, pitchError < 1e-6 ? "ok" : "INACCURATE");
+    pass &= pitchError < 1e-6;
+    V2Position level = tilt.compensate(V2Position(1_m, 0_m));
+    const double levelError = std::hypot(level.getX().internal() - std::cos(ramp), level.getY().internal());
+    std::printf("%-18s error %9.3g m  %s\n", "ramp projection", levelError, levelError < 1e-6 ? "ok" : "INACCURATE");
+    pass &= levelError < 1e-6;
+
+    lemlib::TiltCompensator compensator;
+    RawTilt raw;
+    pass &= bench::compare(
+        "tilt sample",
+        [&](int i) {
+            const int j = i % SIZE;
+            compensator.update(Angle(rolls[j]), Angle(pitches[j]), 0_stRad,
+                               V3Acceleration(from_mps2(ax[j]), from_mps2(ay[j]), from_mps2(az[j])));
+            bench::doNotOptimize(compensator.compensate(V2Position(from_m(dx[j]), from_m(dy[j]))));
+        },
+        [&](int i) {
+            const int j = i % SIZE;
+            raw.update(rolls[j], pitches[j], ax[j], ay[j], az[j]);
+            double x = dx[j], y = dy[j];
+            raw.compensate(x, y);
+            bench::doNotOptimize(x);
+            bench::doNotOptimize(y);
+        },
+        TOLERANCE);
+    return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,107 @@
+#include "bench.hpp"
+#include "units/Angle.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+/**
+ * Measures the accuracy and throughput of the approximations in units/FastTrig.hpp against libm, for double and float.
+ * Fails if an approximation is less accurate than documented, or slower than libm.
+ *
+ * Errors are measured against libm in double precision, over angles within 1000 rotations of 0.
+ */
+constexpr int SIZE = 4096;
+
+/**
+ * @brief distance between two angles in radians, ignoring whole rotations
+ */
+static double angleError(double a, double b) { return std::abs(std::remainder(a - b, M_TWOPI)); }
+
+/**
+ * @brief print and check the maximum error of an approximation
+ */
+template <typename T, typename F, typename G>
+static bool accuracy(const char* name, const std::vector<T>& inputs, F&& fast, G&& reference, double bound) {
+    double worst = 0;
+    for (T input : inputs) worst = std::max(worst, fast(input, reference(static_cast<double>(input))));
+    const bool pass = worst <= bound;
+    std::printf("%-18s max error %9.3g  bound %9.3g  %s\n", name, worst, bound, pass ? "ok" : "INACCURATE");
+    return pass;
+}
+
+template <typename T> static bool run(const char* type, double trigBound, double wrapBound) {
+    using AngleT = units::AngleOf<units::WithRep<Number, T>>;
+    std::vector<T> angles(SIZE), small(SIZE), xs(SIZE), ys(SIZE);
+    for (int i = 0; i < SIZE; i++) {
+        // inputs are spread over the whole range, and read from memory so they aren't folded at compile time
+        angles[i] = T((i * 7919 % SIZE - SIZE / 2) * (1000 * M_TWOPI / (SIZE / 2)));
+        small[i] = T((i * 104729 % SIZE - SIZE / 2) * (2 * M_TWOPI / SIZE));
+        xs[i] = T(std::cos(i * 0.37) * (i % 7 + 1));
+        ys[i] = T(std::sin(i * 0.37) * (i % 5 + 1));
+    }
+    xs[0] = ys[0] = T(0);
+    xs[1] = T(0);
+    ys[2] = T(0);
+    char name[32];
+    bool pass = true;
+
+    const auto absolute = [](auto fast) {
+        return [=](auto x, double expected) { return std::abs(fast(x) - expected); };
+    };
+    std::snprintf(name, sizeof(name), "sin %s", type);
+    pass &= accuracy(name, angles, absolute([](T x) { return double(units::fast::sin(x)); }),
+                     [](double x) { return std::sin(x); }, trigBound);
+    std::snprintf(name, sizeof(name), "cos %s", type);
+    pass &= accuracy(name, angles, absolute([](T x) { return double(units::fast::cos(x)); }),
+                     [](double x) { return std::cos(x); }, trigBound);
+    std::snprintf(name, sizeof(name), "wrap180 %s", type);
+    pass &= accuracy(name, angles,
+                     [](T x, double expected) {
+                         const double wrapped = units::fast::wrap180(x);
+                         return std::abs(wrapped) > M_PI + 1e-6 ? INFINITY : angleError(wrapped, expected);
+                     },
+                     [](double x) { return x; }, wrapBound);
+    std::snprintf(name, sizeof(name), "wrap360 %s", type);
+    pass &= accuracy(name, angles,
+                     [](T x, double expected) {
+                         const double wrapped = units::fast::wrap360(x);
+                         return wrapped < 0 || wrapped > M_TWOPI + 1e-6 ? INFINITY : angleError(wrapped, expected);
+                     },
+                     [](double x) { return x; }, wrapBound);
+    double worst = 0;
+    for (int i = 0; i < SIZE; i++) {
+        worst = std::max(worst, std::abs(double(units::fast::atan2(ys[i], xs[i])) -
+                                         std::atan2(double(ys[i]), double(xs[i]))));
+    }
+    std::snprintf(name, sizeof(name), "atan2 %s", type);
+    std::printf("%-18s max error %9.3g  bound %9.3g  %s\n", name, worst, trigBound,
+                worst <= trigBound ? "ok" : "INACCURATE");
+    pass &= worst <= trigBound;
+
+    // an approximation is only worth using if it is faster than libm
+    constexpr double TOLERANCE = 0;
+    std::snprintf(name, sizeof(name), "sin %s", type);
+    pass &= bench::compare(
+        name, [&](int i) { bench::doNotOptimize(units::fast::sin(small[i % SIZE])); },
+        [&](int i) { bench::doNotOptimize(std::sin(small[i % SIZE])); }, TOLERANCE);
+    std::snprintf(name, sizeof(name), "cos %s", type);
+    pass &= bench::compare(
+        name, [&](int i) { bench::doNotOptimize(units::fast::cos(small[i % SIZE])); },
+        [&](int i) { bench::doNotOptimize(std::cos(small[i % SIZE])); }, TOLERANCE);
+    std::snprintf(name, sizeof(name), "atan2 %s", type);
+    pass &= bench::compare(
+        name, [&](int i) { bench::doNotOptimize(units::fast::atan2(ys[i % SIZE], xs[i % SIZE])); },
+        [&](int i) { bench::doNotOptimize(std::atan2(ys[i % SIZE], xs[i % SIZE])); }, TOLERANCE);
+    std::snprintf(name, sizeof(name), "wrap180 %s", type);
+    pass &= bench::compare(
+        name, [&](int i) { bench::doNotOptimize(units::fast::constrainAngle180(AngleT(angles[i % SIZE]))); },
+        [&](int i) { bench::doNotOptimize(units::constrainAngle180(AngleT(angles[i % SIZE]))); }, TOLERANCE);
+    return pass;
+}
+
+int main() {
+    bool pass = true;
+    pass &= run<double>("double", 1e-11, 1e-12);
+    pass &= run<float>("float", 5e-7, 1e-6);
+    return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
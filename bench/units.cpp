@@ -0,0 +1,102 @@
+#include "bench.hpp"
+#include "kernels.hpp"
+#include <cstdlib>
+#include <type_traits>
+#include <vector>
+
+// quantities must be no larger than the value they wrap
+static_assert(sizeof(Length) == sizeof(double));
+static_assert(sizeof(units::V2Position) == 2 * sizeof(double));
+static_assert(sizeof(FixedLength) == sizeof(int32_t));
+
+/**
+ * Runtime comparison of the kernels in kernels.cpp, using the raw kernels as the baseline. The codegen check is the
+ * precise test, this catches regressions which only show up when the kernels are called, like a quantity being copied
+ * where a double wouldn't be.
+ *
+ * usage: units [tolerance], where tolerance is how much slower a units kernel may be, defaulting to 0.25 (25%)
+ */
+int main(int argc, char** argv) {
+    const double tolerance = argc > 1 ? std::atof(argv[1]) : 0.25;
+    // inputs are read from memory, so the kernels can't be evaluated at compile time
+    constexpr int SIZE = 1024;
+    std::vector<double> a(SIZE), b(SIZE);
+    std::vector<Length> la(SIZE, 0_m), lb(SIZE, 0_m);
+    std::vector<int32_t> fa(SIZE);
+    std::vector<FixedLength> fla(SIZE);
+    for (int i = 0; i < SIZE; i++) {
+        a[i] = (i * 7919 % 1000) / 100.0 - 5;
+        b[i] = (i * 104729 % 1000) / 100.0 - 5;
+        la[i] = from_m(a[i]);
+        lb[i] = from_m(b[i]);
+        fla[i] = FixedLength(la[i]);
+        fa[i] = fla[i].internal().raw();
+    }
+    auto at = [&](int i) { return i % SIZE; };
+    auto next = [&](int i) { return (i + 1) % SIZE; };
+
+    bool pass = true;
+    pass &= bench::compare(
+        "distance",
+        [&](int i) { bench::doNotOptimize(units_distance(la[at(i)], lb[at(i)], la[next(i)], lb[next(i)])); },
+        [&](int i) {
+            double result;
+            raw_distance(a[at(i)], b[at(i)], a[next(i)], b[next(i)], &result);
+            bench::doNotOptimize(result);
+        },
+        tolerance);
+    pass &= bench::compare(
+        "magnitude", [&](int i) { bench::doNotOptimize(units_magnitude(la[at(i)], lb[at(i)])); },
+        [&](int i) {
+            double result;
+            raw_magnitude(a[at(i)], b[at(i)], &result);
+            bench::doNotOptimize(result);
+        },
+        tolerance);
+    pass &= bench::compare(
+        "wrap", [&](int i) { bench::doNotOptimize(units_wrap(from_stRad(a[at(i)] * 10))); },
+        [&](int i) {
+            double result;
+            raw_wrap(a[at(i)] * 10, &result);
+            bench::doNotOptimize(result);
+        },
+        tolerance);
+    pass &= bench::compare(
+        "transformX",
+        [&](int i) {
+            bench::doNotOptimize(units_transformX(la[at(i)], from_stRad(b[at(i)]), la[next(i)], lb[next(i)]));
+        },
+        [&](int i) {
+            double result;
+            raw_transformX(a[at(i)], b[at(i)], a[next(i)], b[next(i)], &result);
+            bench::doNotOptimize(result);
+        },
+        tolerance);
+    pass &= bench::compare(
+        "arcVelocity",
+        [&](int i) { bench::doNotOptimize(units_arcVelocity(from_radps(a[at(i)]), from_radps(b[at(i)]), 4_in)); },
+        [&](int i) {
+            double result;
+            raw_arcVelocity(a[at(i)], b[at(i)], to_m(4_in), &result);
+            bench::doNotOptimize(result);
+        },
+        tolerance);
+    pass &= bench::compare(
+        "sumDistances", [&](int) { bench::doNotOptimize(units_sumDistances(la.data(), lb.data(), SIZE)); },
+        [&](int) {
+            double result;
+            raw_sumDistances(a.data(), b.data(), SIZE, &result);
+            bench::doNotOptimize(result);
+        },
+        tolerance, 2000);
+    pass &= bench::compare(
+        "integrateFixed",
+        [&](int) { bench::doNotOptimize(units_integrateFixed(fla.data(), SIZE, FixedTime(10_msec))); },
+        [&](int) {
+            int32_t result;
+            raw_integrateFixed(fa.data(), SIZE, units::Q16_16(0.01).raw(), &result);
+            bench::doNotOptimize(result);
+        },
+        tolerance, 2000);
+    return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,80 @@
+#include "bench.hpp"
+#include "units/Transform2D.hpp"
+#include <cstdlib>
+#include <vector>
+
+using namespace units;
+
+/**
+ * Compares batched Vector2DArray operations against the same operations over a std::vector of Vector2D, for double and
+ * float quantities, and transforming a path with Transform2D against rotating each point on its own. Fails if a batched
+ * operation is much slower than the loop it replaces. Operations which are limited by memory bandwidth, like translate,
+ * are expected to be about as fast as the loop when it is vectorized too.
+ */
+constexpr double TOLERANCE = 0.25;
+
+template <isQuantity T> static bool run(const char* type) {
+    constexpr int SIZE = 4096;
+    std::vector<Vector2D<T>> points;
+    Vector2DArray<T> array;
+    for (int i = 0; i < SIZE; i++) {
+        const Vector2D<T> point(T((i * 7919 % 1000) / 10.0), T((i * 104729 % 1000) / 10.0));
+        points.push_back(point);
+        array.push_back(point);
+    }
+    std::vector<T> out(SIZE, T(0));
+    Vector2D<T> target(T(50), T(50));
+    char name[32];
+    bool pass = true;
+
+    std::snprintf(name, sizeof(name), "distance %s", type);
+    pass &= bench::compare(
+        name,
+        [&](int) {
+            array.distanceTo(target, out);
+            bench::doNotOptimize(out.data());
+        },
+        [&](int) {
+            for (int i = 0; i < SIZE; i++) out[i] = points[i].distanceTo(target);
+            bench::doNotOptimize(out.data());
+        },
+        TOLERANCE, 2000);
+
+    std::snprintf(name, sizeof(name), "translate %s", type);
+    pass &= bench::compare(
+        name,
+        [&](int) {
+            array.translateBy(target);
+            bench::doNotOptimize(array.xData());
+        },
+        [&](int) {
+            for (Vector2D<T>& point : points) point += target;
+            bench::doNotOptimize(points.data());
+        },
+        TOLERANCE, 2000);
+
+    // transforming a path into the robot's frame, against calculating the rotation for every point
+    const Transform2D robot(24_in, 12_in, 30_stDeg);
+    const AngleOf<T> heading(robot.getTheta());
+    Vector2D<T> position(T(robot.getX()), T(robot.getY()));
+    std::snprintf(name, sizeof(name), "toRobot %s", type);
+    pass &= bench::compare(
+        name,
+        [&](int) {
+            robot.applyInverse(array);
+            bench::doNotOptimize(array.xData());
+        },
+        [&](int) {
+            for (Vector2D<T>& point : points) point = Vector2D<T>(point - position).rotatedBy(AngleOf<T>(0) - heading);
+            bench::doNotOptimize(points.data());
+        },
+        TOLERANCE, 2000);
+    return pass;
+}
+
+int main() {
+    bool pass = true;
+    pass &= run<Length>("double");
+    pass &= run<LengthF>("float");
+    return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
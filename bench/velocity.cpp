@@ -0,0 +1,142 @@
+#include "bench.hpp"
+#include "hardware/encoder/VelocityEstimator.hpp"
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace units;
+
+/**
+ * Checks that the velocity estimators follow motions they can represent exactly, and that they reduce the noise of a
+ * quantized encoder compared to finite differences. Also measures the cost of a sample in a large window against a
+ * small window, which is the same if the update takes constant time, and the cost of the tracker against the same
+ * tracker written by hand with raw doubles.
+ */
+constexpr double TOLERANCE = 0.25;
+
+static bool check(const char* name, double value, double bound) {
+    const bool pass = value <= bound;
+    std::printf("%-18s error %9.3g  bound %9.3g  %s\n", name, value, bound, pass ? "ok" : "INACCURATE");
+    return pass;
+}
+
+struct RawTracker {
+        double alpha = 0.5, beta = 0.1, gamma = 0;
+        double angle = 0, velocity = 0, acceleration = 0, time = 0;
+        bool started = false;
+
+        bool update(double z, double t) {
+            if (!std::isfinite(z) || !std::isfinite(t) || (started && !(t > time))) return false;
+            if (started) {
+                const double dt = t - time;
+                const double predicted = angle + velocity * dt + acceleration * dt * dt / 2;
+                const double error = z - predicted;
+                angle = predicted + alpha * error;
+                velocity += acceleration * dt + beta * error / dt;
+                acceleration += 2 * gamma * error / (dt * dt);
+            } else {
+                angle = z;
+                started = true;
+            }
+            time = t;
+            return true;
+        }
+};
+
+int main() {
+    bool pass = true;
+    // 10 ms samples with up to 1 ms of jitter, for 100 s
+    constexpr int SAMPLES = 10000;
+    std::vector<double> times(SAMPLES);
+    for (int i = 0; i < SAMPLES; i++) times[i] = i * 0.01 + (i * 7919 % 11 - 5) * 1e-4;
+
+    // a constant acceleration is a parabola, so the window fits it exactly, even after the running sums have been
+    // updated and rebased thousands of times. The tracker settles on it once its initial error has decayed
+    lemlib::VelocityEstimator window = lemlib::VelocityEstimator::window(8);
+    lemlib::VelocityEstimator tracker = lemlib::VelocityEstimator::tracker(0.5, 0.1, 0.01);
+    double windowVelocity = 0, windowAcceleration = 0, trackerVelocity = 0, trackerAcceleration = 0;
+    for (int i = 0; i < SAMPLES; i++) {
+        const double t = times[i];
+        const Angle angle(1 + 2 * t + 1.5 * t * t);
+        window.update(angle, from_sec(t));
+        tracker.update(angle, from_sec(t));
+        if (i < 1000) continue;
+        windowVelocity = std::max(windowVelocity, std::abs(window.getVelocity().internal() - (2 + 3 * t)));
+        windowAcceleration = std::max(windowAcceleration, std::abs(window.getAcceleration().internal() - 3));
+        trackerVelocity = std::max(trackerVelocity, std::abs(tracker.getVelocity().internal() - (2 + 3 * t)));
+        trackerAcceleration = std::max(trackerAcceleration, std::abs(tracker.getAcceleration().internal() - 3));
+    }
+    pass &= check("window velocity", windowVelocity, 1e-6);
+    pass &= check("window accel", windowAcceleration, 1e-6);
+    pass &= check("tracker velocity", trackerVelocity, 1e-6);
+    pass &= check("tracker accel", trackerAcceleration, 1e-6);
+
+    // a 360 tick per rotation encoder spinning at 200 rpm. Finite differences jump between tick counts
+    lemlib::VelocityEstimator smooth = lemlib::VelocityEstimator::window(16);
+    const double tick = 2 * M_PI / 360;
+    const double speed = 200 * 2 * M_PI / 60;
+    double previous = 0, differenceError = 0, windowError = 0;
+    int count = 0;
+    for (int i = 0; i < SAMPLES; i++) {
+        const double t = i * 0.01;
+        const double measured = std::floor(speed * t / tick) * tick;
+        smooth.update(Angle(measured), from_sec(t));
+        if (i >= 100) {
+            const double difference = (measured - previous) / 0.01;
+            differenceError += (difference - speed) * (difference - speed);
+            windowError += (smooth.getVelocity().internal() - speed) * (smooth.getVelocity().internal() - speed);
+            count++;
+        }
+        previous = measured;
+    }
+    differenceError = std::sqrt(differenceError / count);
+    windowError = std::sqrt(windowError / count);
+    std::printf("%-18s rms %9.3g rad/s  window rms %9.3g rad/s\n", "quantized", differenceError, windowError);
+    pass &= check("quantized ratio", windowError / differenceError, 0.5);
+
+    // failed reads don't change the estimate
+    const double before = window.getVelocity().internal();
+    const bool rejected = window.update(Angle(INFINITY), from_sec(1000)) == INT_MAX &&
+                          window.update(Angle(0), from_sec(times.front())) == INT_MAX;
+    pass &= check("rejected samples", rejected ? std::abs(window.getVelocity().internal() - before) : INFINITY, 0);
+
+    // samples are read from memory, so updates can't be evaluated at compile time
+    constexpr int SIZE = 1024;
+    std::vector<Angle> angles;
+    std::vector<double> rawAngles;
+    for (int i = 0; i < SIZE; i++) {
+        rawAngles.push_back((i * 7919 % 100) / 1000.0 + i * 0.1);
+        angles.push_back(Angle(rawAngles.back()));
+    }
+    // every call is a later sample, so a batch starting again at i = 0 is still valid
+    lemlib::VelocityEstimator large = lemlib::VelocityEstimator::window(16);
+    lemlib::VelocityEstimator small = lemlib::VelocityEstimator::window(4);
+    double largeTime = 0, smallTime = 0;
+    pass &= bench::compare(
+        "window 16 vs 4",
+        [&](int i) {
+            large.update(angles[i % SIZE], Time(largeTime += 0.01));
+            bench::doNotOptimize(large.getVelocity());
+        },
+        [&](int i) {
+            small.update(angles[i % SIZE], Time(smallTime += 0.01));
+            bench::doNotOptimize(small.getVelocity());
+        },
+        TOLERANCE);
+    lemlib::VelocityEstimator alphaBeta = lemlib::VelocityEstimator::tracker(0.5, 0.1);
+    RawTracker raw;
+    double trackerTime = 0, rawTime = 0;
+    pass &= bench::compare(
+        "tracker",
+        [&](int i) {
+            alphaBeta.update(angles[i % SIZE], Time(trackerTime += 0.01));
+            bench::doNotOptimize(alphaBeta.getVelocity());
+        },
+        [&](int i) {
+            raw.update(rawAngles[i % SIZE], rawTime += 0.01);
+            bench::doNotOptimize(raw.velocity);
+        },
+        TOLERANCE);
+    return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
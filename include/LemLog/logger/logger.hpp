@@ -10,6 +10,9 @@ namespace logger {
  * Debug messages need their topic on the whitelist in order to be sent to the
  * sinks
  *
+ * Topics logged through a logger::Topic are filtered by
+ * logger::whitelistTopic() instead, which also calls this function
+ *
  * @param s the topic to add
  *
  * @b Example:
@@ -28,6 +31,9 @@ void addWhitelist(std::string s);
  * Messages with a level other than debug will be sent to the sinks unless the
  * topic is on the blacklist
  *
+ * Topics logged through a logger::Topic are filtered by
+ * logger::blacklistTopic() instead, which also calls this function
+ *
  * @param s the topic to add
  *
  * @b Example:
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "LemLog/logger/logger.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace logger {
+
+/**
+ * @brief maximum length of a topic stored in a Record, including the null terminator
+ *
+ * Longer topics are truncated.
+ */
+constexpr std::size_t MAX_TOPIC_LENGTH = 32;
+
+/**
+ * @brief maximum length of a message stored in a Record, including the null terminator
+ *
+ * Longer messages are truncated, and end with "..." so they can be told apart from complete messages.
+ */
+constexpr std::size_t MAX_MESSAGE_LENGTH = 92;
+
+/**
+ * @brief maximum length of a message formatted from a deferred record, including the null terminator
+ *
+ * Longer messages are truncated, and end with "...".
+ */
+constexpr std::size_t MAX_FORMATTED_LENGTH = 256;
+
+/**
+ * @brief function which formats packed arguments into a message
+ *
+ * @param out where to write the formatted message
+ * @param outSize the size of the output buffer
+ * @param format the printf-style format string
+ * @param args the packed arguments
+ * @return int the return value of snprintf
+ */
+using Formatter = int (*)(char* out, std::size_t outSize, const char* format, const void* args);
+
+/**
+ * @brief A fixed-size log record
+ *
+ * Records don't own any heap memory, so they can be copied in and out of a RingBuffer without allocating.
+ *
+ * A record either holds a message which has already been formatted, or a format string and packed arguments, in which
+ * case formatting is deferred until the record is read. See getMessage().
+ */
+struct Record {
+        Level level;
+        /** formats the packed arguments, or nullptr if the message has already been formatted */
+        Formatter formatter;
+        /** format string for the packed arguments */
+        const char* format;
+        char topic[MAX_TOPIC_LENGTH];
+        /** the formatted message, or the packed arguments if formatter isn't nullptr */
+        char message[MAX_MESSAGE_LENGTH];
+
+        /**
+         * @brief get the message of the record, formatting it if necessary
+         *
+         * @param out buffer which deferred messages are formatted into
+         * @param outSize the size of the output buffer
+         * @return const char* the formatted message
+         */
+        const char* getMessage(char* out, std::size_t outSize) const;
+};
+
+/**
+ * @brief Lock-free bounded queue of log records
+ *
+ * All memory used by the buffer is allocated when it is constructed. Pushing a record is a bounded copy into a
+ * preallocated slot, so it is safe to do from a time-critical control loop. If the buffer is full, the record is
+ * dropped and counted instead of blocking the caller.
+ *
+ * Any number of tasks may push records at the same time, but only a single task may pop records.
+ */
+class RingBuffer {
+    public:
+        /**
+         * @brief Construct a new Ring Buffer
+         *
+         * @param capacity the number of records the buffer can hold. Rounded up to the nearest power of 2
+         *
+         * @b Example:
+         * @code {.cpp}
+         * // ring buffer which can hold 64 records
+         * logger::RingBuffer buffer(64);
+         * @endcode
+         */
+        RingBuffer(std::size_t capacity);
+        /**
+         * @brief push a record into the buffer
+         *
+         * The topic and message are truncated if they don't fit in a record. A truncated message ends with "...", and
+         * is counted, see getTruncated().
+         *
+         * @param level the logging level of the message
+         * @param topic the topic of the message
+         * @param message the message
+         * @return true the record was pushed
+         * @return false the buffer was full, so the record was dropped
+         */
+        bool push(Level level, std::string_view topic, std::string_view message);
+        /**
+         * @brief push a record with deferred formatting into the buffer
+         *
+         * @param level the logging level of the message
+         * @param topic the topic of the message
+         * @param formatter function which formats the arguments
+         * @param format the format string, which must outlive the record
+         * @param args the packed arguments
+         * @param size the size of the packed arguments, at most MAX_MESSAGE_LENGTH
+         * @return true the record was pushed
+         * @return false the buffer was full, so the record was dropped
+         */
+        bool push(Level level, std::string_view topic, Formatter formatter, const char* format, const void* args,
+                  std::size_t size);
+        /**
+         * @brief pop the oldest record from the buffer
+         *
+         * This function must only be called by one task at a time.
+         *
+         * @param record where to copy the record to
+         * @return true a record was popped
+         * @return false the buffer was empty
+         */
+        bool pop(Record& record);
+        /**
+         * @brief Get the number of records dropped because the buffer was full
+         *
+         * @return std::uint32_t the number of dropped records
+         */
+        std::uint32_t getDropped() const;
+        /**
+         * @brief Get the number of messages which were truncated because they didn't fit in a record
+         *
+         * @return std::uint32_t the number of truncated messages
+         */
+        std::uint32_t getTruncated() const;
+        /**
+         * @brief Get the number of records the buffer can hold
+         *
+         * @return std::size_t the capacity of the buffer
+         */
+        std::size_t getCapacity() const;
+    private:
+        struct Slot {
+                /** tracks whether the slot is ready to be written to or read from */
+                std::atomic<std::size_t> sequence;
+                Record record;
+        };
+
+        /**
+         * @brief claim a slot to write a record to
+         *
+         * @return Slot* the slot, or nullptr if the buffer is full
+         */
+        Slot* claim(std::size_t& pos);
+        /**
+         * @brief make a slot claimed with claim() visible to the reader
+         */
+        void publish(Slot* slot, std::size_t pos);
+
+        const std::size_t m_mask;
+        std::unique_ptr<Slot[]> m_slots;
+        std::atomic<std::size_t> m_head = 0;
+        std::atomic<std::size_t> m_tail = 0;
+        std::atomic<std::uint32_t> m_dropped = 0;
+        std::atomic<std::uint32_t> m_truncated = 0;
+};
+} // namespace logger
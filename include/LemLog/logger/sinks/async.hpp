@@ -0,0 +1,152 @@
+#pragma once
+
+#include "LemLog/logger/topic.hpp"
+#include "pros/rtos.hpp"
+#include <string_view>
+#include <utility>
+
+namespace logger {
+/**
+ * @brief Asynchronous wrapper for a sink
+ *
+ * Sending a message to a sink like the Terminal blocks until the message has been written, which can take a long time
+ * compared to a 10 ms control loop. Async<S> is a sink of type S which instead copies messages into a preallocated
+ * RingBuffer. A low priority task drains the buffer and forwards the messages to S, so a task sending a message only
+ * pays for a bounded copy.
+ *
+ * Messages logged through a logger::Topic are pushed unformatted to the buffer of the first Async sink. Its task
+ * formats them, and sends them to every sink through a Helper, this sink and other Async sinks included, which queue
+ * them like any other message.
+ *
+ * If messages are sent faster than they can be drained, the buffer overflows and messages are dropped. The number of
+ * dropped messages can be checked with getDropped(). Messages longer than MAX_MESSAGE_LENGTH are cut off and end with
+ * "...", and are counted by getTruncated().
+ *
+ * @tparam S the type of sink to wrap, e.g logger::Terminal
+ *
+ * @b Example:
+ * @code {.cpp}
+ * void initialize() {
+ *   // terminal sink which buffers up to 64 messages
+ *   static logger::Async<logger::Terminal> terminal(64);
+ * }
+ * @endcode
+ */
+template <typename S> class Async : public S {
+    public:
+        /**
+         * @brief Construct a new Async sink
+         *
+         * @param capacity the number of messages that can be buffered
+         * @param args arguments passed to the constructor of the wrapped sink
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *   // terminal sink which buffers up to 128 messages, with COBS disabled
+         *   static logger::Async<logger::Terminal> terminal(128, true);
+         * }
+         * @endcode
+         */
+        template <typename... Args> Async(std::size_t capacity, Args&&... args)
+            : S(std::forward<Args>(args)...),
+              m_buffer(capacity),
+              m_task([this] { drain(); }, TASK_PRIORITY_MIN, TASK_STACK_DEPTH_DEFAULT, "LemLog async sink") {
+            registerDeferredBuffer(&m_buffer);
+        }
+
+        /**
+         * @brief queue a message to be sent by the wrapped sink
+         *
+         * @param level the logging level of the message
+         * @param topic the topic of the message
+         * @param message the message to be sent
+         */
+        void send(Level level, std::string topic, std::string message) override {
+            m_buffer.push(level, topic, message);
+        }
+
+        /**
+         * @brief queue a message to be sent by the wrapped sink, without allocating
+         *
+         * Sinks take the topic and message as a std::string, which the caller has to allocate. Calling the sink
+         * directly through this overload only copies the message into the buffer.
+         *
+         * @param level the logging level of the message
+         * @param topic the topic of the message
+         * @param message the message to be sent
+         *
+         * @b Example:
+         * @code {.cpp}
+         * logger::Async<logger::Terminal> terminal(64);
+         *
+         * void opcontrol() {
+         *   terminal.send(logger::Level::INFO, "robot/drive", "driver control started");
+         * }
+         * @endcode
+         */
+        void send(Level level, std::string_view topic, std::string_view message) {
+            m_buffer.push(level, topic, message);
+        }
+
+        /**
+         * @brief queue a message to be sent by the wrapped sink, without allocating
+         *
+         * @param level the logging level of the message
+         * @param topic the topic of the message
+         * @param message the message to be sent
+         */
+        void send(Level level, const char* topic, const char* message) {
+            m_buffer.push(level, topic, message);
+        }
+
+        /**
+         * @brief Get the number of messages dropped because the buffer was full
+         *
+         * @return std::uint32_t the number of dropped messages
+         */
+        std::uint32_t getDropped() const { return m_buffer.getDropped(); }
+
+        /**
+         * @brief Get the number of messages which were cut off to fit in the buffer
+         *
+         * Truncated messages end with "...".
+         *
+         * @return std::uint32_t the number of truncated messages
+         */
+        std::uint32_t getTruncated() const { return m_buffer.getTruncated(); }
+
+        /**
+         * @brief Destroy the Async sink
+         *
+         * The task draining the buffer is stopped before the buffer is destroyed. Any messages still in the buffer are
+         * discarded.
+         */
+        ~Async() {
+            unregisterDeferredBuffer(&m_buffer);
+            m_task.remove();
+        }
+    private:
+        /**
+         * @brief forward buffered messages to the wrapped sink, forever
+         */
+        void drain() {
+            Record record;
+            char formatted[MAX_FORMATTED_LENGTH];
+            while (true) {
+                while (m_buffer.pop(record)) {
+                    const char* message = record.getMessage(formatted, sizeof(formatted));
+                    // a record logged through a Topic goes to every sink, which queues it in this buffer again
+                    if (record.formatter != nullptr) Helper(record.topic).log(record.level, message);
+                    else S::send(record.level, record.topic, message);
+                }
+                pros::delay(DRAIN_PERIOD);
+            }
+        }
+
+        /** how often the buffer is drained, in milliseconds */
+        static constexpr std::uint32_t DRAIN_PERIOD = 10;
+        RingBuffer m_buffer;
+        pros::Task m_task;
+};
+} // namespace logger
@@ -0,0 +1,293 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace logger {
+
+/**
+ * @brief maximum size of a telemetry packet, before framing
+ */
+constexpr std::size_t MAX_TELEMETRY_PACKET = 254;
+
+/**
+ * @brief maximum number of fields in a telemetry channel
+ */
+constexpr std::size_t MAX_TELEMETRY_FIELDS = 16;
+
+/**
+ * @brief encode a buffer with Consistent Overhead Byte Stuffing
+ *
+ * The encoded data contains no zero bytes, so a zero byte can be used to mark the end of a frame. The output buffer
+ * must be able to hold at least length + length / 254 + 1 bytes.
+ *
+ * @param in the data to encode
+ * @param length the length of the data
+ * @param out where to write the encoded data
+ * @return std::size_t the length of the encoded data
+ */
+std::size_t cobsEncode(const std::uint8_t* in, std::size_t length, std::uint8_t* out);
+
+/**
+ * @brief decode a buffer encoded with Consistent Overhead Byte Stuffing
+ *
+ * The frame delimiter should not be included in the input. The output buffer must be at least as large as the input.
+ *
+ * @param in the encoded data
+ * @param length the length of the encoded data
+ * @param out where to write the decoded data
+ * @return std::size_t the length of the decoded data, or 0 if the data is malformed
+ */
+std::size_t cobsDecode(const std::uint8_t* in, std::size_t length, std::uint8_t* out);
+
+namespace telemetry {
+/**
+ * @brief the type of a field in a telemetry channel. Values are stored little endian
+ */
+enum class FieldType : std::uint8_t { F32 = 0, I32 = 1, U32 = 2 };
+
+/**
+ * @brief the type of a telemetry packet
+ */
+enum class PacketType : std::uint8_t { SCHEMA = 0, SAMPLE = 1 };
+
+/**
+ * @brief the stream ID telemetry frames are sent with, to tell them apart from text written by other sinks
+ */
+constexpr std::array<char, 4> STREAM_ID = {'t', 'l', 'm', 'y'};
+
+/**
+ * @brief the stream ID the PROS kernel uses for stdout when COBS is enabled
+ */
+constexpr std::array<char, 4> PROS_STDOUT_ID = {'s', 'o', 'u', 't'};
+
+template <typename T> constexpr FieldType fieldTypeOf() {
+    if constexpr (std::is_floating_point_v<T>) return FieldType::F32;
+    else if constexpr (std::is_signed_v<T>) return FieldType::I32;
+    else return FieldType::U32;
+}
+
+template <typename T> using FieldStorage = std::conditional_t<
+    std::is_floating_point_v<T>, float, std::conditional_t<std::is_signed_v<T>, std::int32_t, std::uint32_t>>;
+
+/**
+ * @brief the type a value is stored as in a channel. Quantities are stored in their base unit
+ */
+template <typename T> struct FieldOf {
+        using type = T;
+};
+
+template <typename T>
+    requires requires(T t) { t.internal(); }
+struct FieldOf<T> {
+        using type = decltype(std::declval<T>().internal());
+};
+} // namespace telemetry
+
+/**
+ * @brief Binary telemetry stream
+ *
+ * Text logs are too large to record data at 100 Hz or more over USB. Telemetry instead sends compact binary samples
+ * on named channels. Each channel is described once by a schema packet, and then each sample is a small packet
+ * containing only the channel ID, a timestamp, and the values of its fields.
+ *
+ * Every packet is prefixed with a 4 byte stream ID, encoded with COBS, and surrounded by zero bytes, so text written
+ * to the same stream by other sinks never corrupts a frame. If the PROS kernel also wraps stdout in COBS frames, the
+ * host decoder unwraps both layers.
+ *
+ * Channels should be created during initialization. After that, samples can be sent from any task, since each frame
+ * is written with a single call to fwrite.
+ *
+ * The `telemetry-decode` tool, built with `make -f sim.mk`, converts a recorded stream into one CSV file per channel.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * // telemetry written to stdout, timestamped with pros::micros
+ * logger::Telemetry telemetry(stdout, [] { return std::uint32_t(pros::micros()); });
+ * // channel with 3 fields
+ * logger::Telemetry::Channel<Length, Length, Angle> pose(telemetry, "pose", {"x_m", "y_m", "theta_rad"});
+ *
+ * void opcontrol() {
+ *   while (true) {
+ *     // quantities are sent in their base unit
+ *     pose.send(odomPose.getX(), odomPose.getY(), odomPose.getOrientation());
+ *     pros::delay(10);
+ *   }
+ * }
+ * @endcode
+ */
+class Telemetry {
+    public:
+        /**
+         * @brief A typed telemetry channel
+         *
+         * Floating point fields are sent as 32 bit floats, and integer fields are sent as 32 bit integers. Quantities
+         * are sent as their value in their base unit.
+         *
+         * @tparam Fields the types of the fields of the channel
+         */
+        template <typename... Fields> class Channel {
+                static_assert(sizeof...(Fields) <= MAX_TELEMETRY_FIELDS, "Too many fields in telemetry channel");
+            public:
+                /**
+                 * @brief Construct a new Channel, and send its schema
+                 *
+                 * @param telemetry the telemetry stream to send samples on
+                 * @param name the name of the channel
+                 * @param fieldNames the name of each field
+                 */
+                Channel(Telemetry& telemetry, std::string_view name,
+                        std::array<std::string_view, sizeof...(Fields)> fieldNames)
+                    : m_telemetry(telemetry),
+                      m_id(add(telemetry, name, fieldNames, std::index_sequence_for<Fields...>())) {}
+
+                /**
+                 * @brief send a sample
+                 *
+                 * @param values the value of each field
+                 */
+                void send(Fields... values) {
+                    std::uint8_t payload[(sizeof(std::uint32_t) * sizeof...(Fields)) + 1];
+                    std::size_t offset = 0;
+                    (write(payload, offset, values), ...);
+                    m_telemetry.sendSample(m_id, payload, offset);
+                }
+            private:
+                template <std::size_t... I>
+                static std::uint8_t add(Telemetry& stream, std::string_view name,
+                                        const std::array<std::string_view, sizeof...(Fields)>& fieldNames,
+                                        std::index_sequence<I...>) {
+                    return stream.addChannel(
+                        name, {std::pair(fieldNames[I],
+                                         telemetry::fieldTypeOf<typename telemetry::FieldOf<Fields>::type>())...});
+                }
+
+                template <typename T> static void write(std::uint8_t* payload, std::size_t& offset, T value) {
+                    using Raw = typename telemetry::FieldOf<T>::type;
+                    Raw raw;
+                    if constexpr (requires { value.internal(); }) raw = value.internal();
+                    else raw = value;
+                    const telemetry::FieldStorage<Raw> stored = telemetry::FieldStorage<Raw>(raw);
+                    std::memcpy(payload + offset, &stored, sizeof(stored));
+                    offset += sizeof(stored);
+                }
+
+                Telemetry& m_telemetry;
+                const std::uint8_t m_id;
+        };
+
+        /**
+         * @brief Construct a new Telemetry stream
+         *
+         * @param stream where to write the stream to, usually stdout
+         * @param clock function which returns the current time in microseconds, used to timestamp samples
+         */
+        Telemetry(std::FILE* stream, std::uint32_t (*clock)());
+        /**
+         * @brief send the schema of every channel again
+         *
+         * Useful if the host started recording after the channels were created.
+         */
+        void resendSchemas();
+        /**
+         * @brief Get the number of samples which could not be written
+         *
+         * @return std::uint32_t the number of dropped samples
+         */
+        std::uint32_t getDropped() const;
+    private:
+        struct ChannelInfo {
+                std::string name;
+                std::vector<std::pair<std::string, telemetry::FieldType>> fields;
+        };
+
+        /**
+         * @brief register a channel and send its schema
+         *
+         * @return std::uint8_t the ID of the channel
+         */
+        std::uint8_t addChannel(std::string_view name,
+                                std::initializer_list<std::pair<std::string_view, telemetry::FieldType>> fields);
+        void sendSchema(std::uint8_t id);
+        void sendSample(std::uint8_t id, const std::uint8_t* payload, std::size_t length);
+        /**
+         * @brief frame a packet and write it to the stream
+         */
+        bool writePacket(const std::uint8_t* packet, std::size_t length);
+
+        std::FILE* m_stream;
+        std::uint32_t (*m_clock)();
+        std::vector<ChannelInfo> m_channels;
+        std::atomic<std::uint32_t> m_dropped = 0;
+};
+
+/**
+ * @brief Decoder for a telemetry stream
+ *
+ * Bytes from the stream can be fed to the decoder in chunks of any size. Text written by other sinks and frames with
+ * other stream IDs are ignored.
+ */
+class TelemetryDecoder {
+    public:
+        /**
+         * @brief description of a decoded channel
+         */
+        struct Schema {
+                std::uint8_t id;
+                std::string name;
+                std::vector<std::pair<std::string, telemetry::FieldType>> fields;
+        };
+
+        /**
+         * @brief Construct a new Telemetry Decoder
+         *
+         * @param onSchema called when a channel schema is decoded
+         * @param onSample called when a sample is decoded, with the channel schema, the timestamp in microseconds, and
+         * the values of the fields
+         */
+        TelemetryDecoder(std::function<void(const Schema&)> onSchema,
+                         std::function<void(const Schema&, std::uint32_t, const std::vector<double>&)> onSample);
+        /**
+         * @brief decode a chunk of the stream
+         *
+         * @param data the bytes to decode
+         * @param length the number of bytes
+         */
+        void feed(const std::uint8_t* data, std::size_t length);
+        /**
+         * @brief Get the number of frames which could not be decoded
+         *
+         * @return std::uint32_t the number of malformed frames
+         */
+        std::uint32_t getMalformed() const;
+    private:
+        /**
+         * @brief decode a complete frame
+         *
+         * @param frame the COBS encoded frame, without the delimiter
+         * @param depth how many layers of framing have been removed
+         */
+        void decodeFrame(const std::vector<std::uint8_t>& frame, int depth);
+        void decodePacket(const std::uint8_t* packet, std::size_t length);
+
+        std::function<void(const Schema&)> m_onSchema;
+        std::function<void(const Schema&, std::uint32_t, const std::vector<double>&)> m_onSample;
+        std::vector<std::uint8_t> m_frame;
+        /** frames nested inside PROS stdout frames */
+        std::vector<std::uint8_t> m_innerFrame;
+        std::vector<Schema> m_schemas;
+        std::vector<double> m_values;
+        std::uint32_t m_malformed = 0;
+};
+} // namespace logger
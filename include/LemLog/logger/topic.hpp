@@ -0,0 +1,302 @@
+#pragma once
+
+#include "LemLog/logger/logger.hpp"
+#include "LemLog/logger/ringbuffer.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// messages below this level are removed at compile time when logged through a Topic
+#ifndef LEMLOG_MIN_LEVEL
+#define LEMLOG_MIN_LEVEL logger::Level::DEBUG
+#endif
+
+namespace logger {
+
+/**
+ * @brief maximum number of distinct topics that can be filtered
+ *
+ * Any topics interned after this limit has been reached share the last slot, and therefore its filter settings.
+ */
+constexpr std::size_t MAX_TOPICS = 64;
+
+/**
+ * @brief string which can be used as a template parameter
+ *
+ * @tparam N the length of the string, including the null terminator
+ */
+template <std::size_t N> struct FixedString {
+        constexpr FixedString(const char (&str)[N]) { std::copy_n(str, N, value); }
+
+        constexpr operator std::string_view() const { return std::string_view(value, N - 1); }
+
+        char value[N];
+};
+
+/**
+ * @brief hash a topic name into its ID
+ *
+ * This is the 32 bit FNV-1a hash. 0 is reserved to mark unused slots, so it is never returned.
+ *
+ * @param topic the name of the topic
+ * @return constexpr std::uint32_t the ID of the topic
+ */
+constexpr std::uint32_t hashTopic(std::string_view topic) {
+    std::uint32_t hash = 2166136261u;
+    for (const char c : topic) {
+        hash ^= std::uint8_t(c);
+        hash *= 16777619u;
+    }
+    return hash == 0 ? 1 : hash;
+}
+
+/**
+ * @brief get the filter slot of a topic, assigning one if the topic hasn't been seen before
+ *
+ * @param id the ID of the topic, from hashTopic()
+ * @return std::size_t the slot of the topic
+ */
+std::size_t internTopic(std::uint32_t id);
+
+/**
+ * @brief check whether messages with a given topic and level should be sent
+ *
+ * Same rules as the Helper class: debug messages are only sent if their topic is on the whitelist, and other messages
+ * are sent unless their topic is on the blacklist.
+ *
+ * @param slot the slot of the topic, from internTopic()
+ * @param level the logging level of the message
+ * @return true the message should be sent
+ * @return false the message should be discarded
+ */
+bool isTopicEnabled(std::size_t slot, Level level);
+
+/**
+ * @brief add a topic to the whitelist
+ *
+ * The interned topic filter is the filter for messages logged through a Topic. The topic is also added to the
+ * whitelist of the Helper class with addWhitelist(), so messages delivered through a Helper are filtered the same way.
+ * Use this instead of addWhitelist() for topics which are logged through a Topic.
+ *
+ * @param topic the name of the topic
+ *
+ * @b Example:
+ * @code {.cpp}
+ * void initialize() {
+ *   logger::whitelistTopic("lemlib/motions/boomerang");
+ * }
+ * @endcode
+ */
+void whitelistTopic(std::string_view topic);
+
+/**
+ * @brief add a topic to the blacklist
+ *
+ * The topic is also added to the blacklist of the Helper class with addBlacklist(), so both filters agree. Use this
+ * instead of addBlacklist() for topics which are logged through a Topic.
+ *
+ * @param topic the name of the topic
+ */
+void blacklistTopic(std::string_view topic);
+
+/**
+ * @brief register a ring buffer which records logged through a Topic can be pushed to
+ *
+ * This is called by Async sinks. Records are only pushed to the first registered buffer, and the task draining it
+ * formats them and sends them to every sink.
+ *
+ * @param buffer the buffer to register
+ */
+void registerDeferredBuffer(RingBuffer* buffer);
+
+/**
+ * @brief remove a ring buffer registered with registerDeferredBuffer()
+ *
+ * @param buffer the buffer to remove
+ */
+void unregisterDeferredBuffer(RingBuffer* buffer);
+
+/**
+ * @brief push a record to the first registered ring buffer
+ *
+ * @return true the record was pushed, or dropped because the buffer was full
+ * @return false there are no registered buffers
+ */
+bool pushDeferred(Level level, std::string_view topic, Formatter formatter, const char* format, const void* args,
+                  std::size_t size);
+
+/**
+ * @brief Packed format arguments
+ *
+ * Arguments are copied byte by byte into a record, and copied back out when the record is formatted, so they must be
+ * trivially copyable. Pointers (including strings) must point to memory that outlives the record, like a string
+ * literal.
+ *
+ * @tparam Args the types of the arguments
+ */
+template <typename... Args> struct PackedArgs {
+        static_assert((std::is_trivially_copyable_v<Args> && ...), "Log arguments must be trivially copyable");
+
+        /** offset of each argument in the packed buffer */
+        static constexpr std::array<std::size_t, sizeof...(Args)> offsets = [] {
+            std::array<std::size_t, sizeof...(Args)> result {};
+            std::size_t offset = 0;
+            std::size_t i = 0;
+            ((result[i++] = offset, offset += sizeof(Args)), ...);
+            return result;
+        }();
+        /** total size of the packed arguments */
+        static constexpr std::size_t size = (sizeof(Args) + ... + 0);
+        static_assert(size <= MAX_MESSAGE_LENGTH, "Too many log arguments to fit in a record");
+
+        static void pack(char* buffer, const Args&... args) {
+            std::size_t i = 0;
+            ((std::memcpy(buffer + offsets[i++], &args, sizeof(Args))), ...);
+        }
+
+        template <typename T> static T load(const char* buffer) {
+            T value;
+            std::memcpy(&value, buffer, sizeof(T));
+            return value;
+        }
+
+        static int format(char* out, std::size_t outSize, const char* format, const void* args) {
+            return formatIndexed(out, outSize, format, static_cast<const char*>(args),
+                                 std::index_sequence_for<Args...>());
+        }
+
+        template <std::size_t... I>
+        static int formatIndexed(char* out, std::size_t outSize, const char* format, const char* args,
+                                 std::index_sequence<I...>) {
+            return std::snprintf(out, outSize, format, load<Args>(args + offsets[I])...);
+        }
+};
+
+/**
+ * @brief expand a log argument into the values passed to the format string
+ *
+ * A quantity from the units library is expanded into its value as a double and its unit suffix, so it is formatted
+ * with %f%s or %g%s. The suffix is a string generated at compile time, so it doesn't need to be copied into the
+ * record. Other arguments are passed through unchanged.
+ */
+template <typename T> constexpr auto expandArg(const T& arg) {
+    if constexpr (requires { arg.internal(); unitSuffix(arg); }) {
+        return std::tuple<double, const char*>(static_cast<double>(arg.internal()), unitSuffix(arg));
+    } else {
+        return std::tuple<T>(arg);
+    }
+}
+
+/**
+ * @brief A logging topic which is interned at compile time
+ *
+ * The ID of the topic is computed at compile time, and the first time the topic is used it is given a slot in a fixed
+ * size filter table. After that, checking whether a message should be sent is a single bit test, and doesn't touch
+ * any strings.
+ *
+ * When an Async sink exists, the format string pointer and the arguments are copied into the ring buffer of the first
+ * Async sink, and the task draining that buffer formats the message and sends it to every sink. Logging a message
+ * then never formats it or allocates. Without an Async sink, the message is formatted and sent to the sinks right
+ * away. Messages are truncated to MAX_FORMATTED_LENGTH either way.
+ *
+ * Messages below LEMLOG_MIN_LEVEL are removed at compile time.
+ *
+ * @tparam Name the name of the topic
+ *
+ * @b Example:
+ * @code {.cpp}
+ * using BoomerangLog = logger::Topic<"lemlib/motions/boomerang">;
+ *
+ * void boomerang() {
+ *   BoomerangLog::debug("carrot: (%f, %f)", carrotX, carrotY);
+ *   BoomerangLog::info("motion finished after %d iterations", iterations);
+ *   // quantities are formatted as a number and a unit suffix, like "distance: 1.5 m"
+ *   BoomerangLog::info("distance: %g%s", distance);
+ * }
+ * @endcode
+ */
+template <FixedString Name> class Topic {
+    public:
+        /** the compile-time ID of the topic */
+        static constexpr std::uint32_t id = hashTopic(Name);
+
+        /**
+         * @brief get the filter slot of the topic
+         *
+         * @return std::size_t the slot of the topic
+         */
+        static std::size_t slot() {
+            static const std::size_t s = internTopic(id);
+            return s;
+        }
+
+        /**
+         * @brief check if a message with the given level would be sent
+         *
+         * @param level the logging level of the message
+         */
+        static bool enabled(Level level) { return isTopicEnabled(slot(), level); }
+
+        /**
+         * @brief add the topic to the whitelist, see whitelistTopic()
+         */
+        static void whitelist() { whitelistTopic(Name); }
+
+        /**
+         * @brief add the topic to the blacklist, see blacklistTopic()
+         */
+        static void blacklist() { blacklistTopic(Name); }
+
+        /**
+         * @brief send a printf-style message under this topic
+         *
+         * @param level the logging level of the message
+         * @param format the format string. Must be a string literal, or outlive the message
+         * @param args the format arguments. Quantities take two conversions, for the value and the unit suffix
+         */
+        template <typename... Args> static void log(Level level, const char* format, Args... args) {
+            if (!enabled(level)) return;
+            std::apply([&](auto... expanded) { logExpanded(level, format, expanded...); },
+                       std::tuple_cat(expandArg(args)...));
+        }
+
+        template <typename... Args> static void debug(const char* format, Args... args) {
+            if constexpr (LEMLOG_MIN_LEVEL <= Level::DEBUG) log(Level::DEBUG, format, args...);
+        }
+
+        template <typename... Args> static void info(const char* format, Args... args) {
+            if constexpr (LEMLOG_MIN_LEVEL <= Level::INFO) log(Level::INFO, format, args...);
+        }
+
+        template <typename... Args> static void warn(const char* format, Args... args) {
+            if constexpr (LEMLOG_MIN_LEVEL <= Level::WARN) log(Level::WARN, format, args...);
+        }
+
+        template <typename... Args> static void error(const char* format, Args... args) {
+            if constexpr (LEMLOG_MIN_LEVEL <= Level::ERROR) log(Level::ERROR, format, args...);
+        }
+    private:
+        /**
+         * @brief get the Helper which sends messages when there is no Async sink, so the topic is only copied once
+         */
+        static Helper& helper() {
+            static Helper h {std::string(std::string_view(Name))};
+            return h;
+        }
+
+        template <typename... Args> static void logExpanded(Level level, const char* format, Args... args) {
+            using Packed = PackedArgs<Args...>;
+            char buffer[Packed::size > 0 ? Packed::size : 1];
+            Packed::pack(buffer, args...);
+            if (pushDeferred(level, Name, &Packed::format, format, buffer, Packed::size)) return;
+            // there is no task to format the message later
+            char message[MAX_FORMATTED_LENGTH];
+            Packed::format(message, sizeof(message), format, buffer);
+            helper().log(level, message);
+        }
+};
+} // namespace logger
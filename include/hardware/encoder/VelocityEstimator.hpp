@@ -0,0 +1,140 @@
+#pragma once
+
+#include "units/Angle.hpp"
+#include <array>
+
+namespace lemlib {
+/**
+ * @brief maximum number of samples in the window of a least squares velocity estimator
+ */
+constexpr std::size_t MAX_VELOCITY_WINDOW = 16;
+
+/**
+ * @class VelocityEstimator
+ *
+ * @brief Estimates the velocity and acceleration of an encoder from timestamped angle samples
+ *
+ * Differentiating consecutive angles amplifies the quantization and noise of the encoder, especially when the samples
+ * are close together. The estimator offers two methods, which both take the time of each sample into account, so
+ * samples don't have to be evenly spaced:
+ *
+ * - a tracker, which predicts each sample from the previous estimate, and corrects the angle, velocity, and
+ *   acceleration by a fraction of the prediction error. It has almost no lag with high gains, and is smooth with low
+ *   gains. If gamma is 0, it is an alpha-beta tracker and the acceleration is always 0.
+ * - a window, which fits a parabola to the most recent samples with least squares, and evaluates its slope and
+ *   curvature at the newest sample. It follows constant accelerations exactly, and is smoother with larger windows.
+ *
+ * Both methods update in constant time. The window keeps running sums of the samples, which are recalculated from
+ * the samples once per window length so rounding errors can't accumulate.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * lemlib::VelocityEstimator estimator = lemlib::VelocityEstimator::window(8);
+ *
+ * while (true) {
+ *     estimator.update(encoder.getAngle(), from_sec(pros::micros() / 1e6));
+ *     std::cout << to_rpm(estimator.getVelocity()) << " rpm" << std::endl;
+ *     pros::delay(10);
+ * }
+ * @endcode
+ */
+class VelocityEstimator {
+    public:
+        /**
+         * @brief Create an alpha-beta-gamma tracker
+         *
+         * @param alpha fraction of the prediction error corrected on the angle, from 0 to 1
+         * @param beta fraction of the prediction error corrected on the velocity, from 0 to 1
+         * @param gamma fraction of the prediction error corrected on the acceleration, from 0 to 1. 0 doesn't estimate
+         * the acceleration
+         * @return VelocityEstimator
+         */
+        static VelocityEstimator tracker(double alpha = 0.5, double beta = 0.1, double gamma = 0);
+
+        /**
+         * @brief Create a least squares estimator over a window of samples
+         *
+         * @param size the number of samples in the window, clamped from 3 to MAX_VELOCITY_WINDOW
+         * @return VelocityEstimator
+         */
+        static VelocityEstimator window(std::size_t size = 8);
+
+        /**
+         * @brief add a sample
+         *
+         * @param angle the angle measured by the encoder
+         * @param time when the angle was measured. Must be later than the previous sample
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno. The estimate is not changed
+         *
+         * @b errno values:
+         * - EINVAL: the angle or time is not finite, like when the encoder couldn't be read, or the time is not later
+         *   than the previous sample
+         */
+        int update(Angle angle, Time time);
+
+        /**
+         * @brief get the estimated angle at the newest sample
+         *
+         * @return Angle the angle, or 0 if there are no samples
+         */
+        Angle getAngle() const;
+
+        /**
+         * @brief get the estimated velocity at the newest sample
+         *
+         * @return AngularVelocity the velocity, or 0 if there are less than 2 samples
+         */
+        AngularVelocity getVelocity() const;
+
+        /**
+         * @brief get the estimated acceleration at the newest sample
+         *
+         * @return AngularAcceleration the acceleration, or 0 if there are less than 3 samples
+         */
+        AngularAcceleration getAcceleration() const;
+
+        /**
+         * @brief discard every sample, like after the angle of the encoder has been set
+         */
+        void reset();
+    private:
+        enum class Method { TRACKER, WINDOW };
+
+        VelocityEstimator(Method method);
+
+        void updateTracker(double angle, double time);
+        void updateWindow(double angle, double time);
+
+        struct Sample {
+                double time;
+                double angle;
+        };
+
+        /** recalculate the running sums from the samples, relative to the newest sample */
+        void rebase();
+        /** add a sample to the running sums, or remove it if sign is -1 */
+        void accumulate(const Sample& sample, double sign);
+
+        Method m_method;
+        double m_alpha = 0;
+        double m_beta = 0;
+        double m_gamma = 0;
+        std::size_t m_size = 0;
+        /** estimate at the newest sample, in radians and seconds */
+        double m_angle = 0;
+        double m_velocity = 0;
+        double m_acceleration = 0;
+        double m_time = 0;
+        std::size_t m_count = 0;
+        /** ring buffer of the samples in the window, m_head is the index of the oldest sample */
+        std::array<Sample, MAX_VELOCITY_WINDOW> m_samples {};
+        std::size_t m_head = 0;
+        std::size_t m_sinceRebase = 0;
+        /** the running sums are relative to this sample, to keep them small */
+        Sample m_origin {0, 0};
+        /** sums of t^k and of angle * t^k over the window */
+        std::array<double, 5> m_timeSums {};
+        std::array<double, 3> m_angleSums {};
+};
+} // namespace lemlib
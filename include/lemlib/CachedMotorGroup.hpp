@@ -0,0 +1,765 @@
+#pragma once
+
+#include "pros/motor_group.hpp"
+#include "hardware/Motor/Motor.hpp"
+#include "hardware/encoder/VelocityEstimator.hpp"
+#include "lemlib/VelocityController.hpp"
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace lemlib {
+/**
+ * @brief maximum number of motors in a motor group
+ */
+constexpr std::size_t MAX_GROUP_MOTORS = 8;
+
+/**
+ * @brief make an array with an element for each motor a group can hold, all set to the same value
+ *
+ * Quantities have no default constructor, so arrays of them have to be filled explicitly.
+ */
+template <typename T> std::array<T, MAX_GROUP_MOTORS> fillGroupArray(T value) {
+    return [&]<std::size_t... I>(std::index_sequence<I...>) {
+        return std::array<T, MAX_GROUP_MOTORS> {((void)I, value)...};
+    }(std::make_index_sequence<MAX_GROUP_MOTORS>());
+}
+
+/**
+ * @brief longest time between calls to CachedMotorGroup::moveVelocity for its velocity controller to keep its state
+ */
+constexpr Time VELOCITY_CONTROL_TIMEOUT = 50_msec;
+
+/**
+ * @brief CachedMotorGroup class
+ *
+ * This class is a handler for a group of lemlib::Motor objects, like lemlib::MotorGroup, and has the same interface.
+ * Instead of reading every motor again in every getter, it reads the group once per tick, recovers from motors being
+ * unplugged in a single sweep, and can run a library side velocity controller. lemlib::MotorGroup is part of the
+ * prebuilt hardware library and can't change, so these features are a separate class.
+ *
+ * Error handling for the CachedMotorGroup class is a bit different from other hardware classes. This is because
+ * the CachedMotorGroup class represents a group of motors, any of which could fail. However, as long as one
+ * motor in the group is functioning properly, the CachedMotorGroup will not throw any errors. In addition, errno will
+ * be set to whatever error was thrown last, as there may be multiple motors in a motor group.
+ *
+ * Every motor in the group is read once per tick into a snapshot, and getters like getAngle(), isConnected(),
+ * getTemperatures() and getSize() are served from it. Calling several getters in the same millisecond only reads each
+ * motor once.
+ *
+ * A group holds up to MAX_GROUP_MOTORS motors in a fixed table. When a motor reconnects, like after its cable is
+ * knocked loose, the sweep that sees it again sets its angle to the median angle of the other motors from the same
+ * sweep, and sets its brake mode, so the group can use it right away without reading the other motors again.
+ */
+class CachedMotorGroup : public Encoder {
+    public:
+        /**
+         * @brief The state of every motor in the group, read in a single sweep
+         *
+         * Stored as a struct of fixed size arrays, so taking a snapshot never allocates. Index i of each array is the
+         * i-th motor in the group, in the order the motors were added. Measurements of disconnected motors are
+         * INFINITY.
+         */
+        struct Snapshot {
+                /** value of pros::millis() when the snapshot was taken */
+                std::uint32_t time = 0;
+                /** number of motors in the group. Only the first count elements of each array are used */
+                std::size_t count = 0;
+                /** signed ports of the motors */
+                std::array<int, MAX_GROUP_MOTORS> ports {};
+                /** 1 if the motor was connected and configured, 0 otherwise */
+                std::array<std::uint8_t, MAX_GROUP_MOTORS> connected {};
+                /** angles measured by the motors, after gearing */
+                std::array<Angle, MAX_GROUP_MOTORS> angles = fillGroupArray(from_stDeg(INFINITY));
+                /** velocities measured by the motors, after gearing */
+                std::array<AngularVelocity, MAX_GROUP_MOTORS> velocities = fillGroupArray(from_rpm(INFINITY));
+                /** current drawn by the motors, or INFINITY if it couldn't be read */
+                std::array<Current, MAX_GROUP_MOTORS> currents = fillGroupArray(from_amp(INFINITY));
+                /** temperatures of the motors */
+                std::array<Temperature, MAX_GROUP_MOTORS> temperatures = fillGroupArray(units::from_kelvin(INFINITY));
+        };
+
+        /**
+         * @brief Construct a new Motor Group
+         *
+         * @param ports list of ports of the motors in the group. Ports after the first MAX_GROUP_MOTORS are ignored
+         * @param outputVelocity the theoretical maximum output velocity of the motor group, after gearing
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     // motor group with motors on ports 1, -2, and 3
+         *     // max theoretical output is 360 rpm
+         *     lemlib::CachedMotorGroup motorGroup({1, -2, 3}, 360_rpm);
+         * }
+         * @endcode
+         */
+        CachedMotorGroup(std::initializer_list<int> ports, AngularVelocity outputVelocity);
+        /**
+         * @brief Construct a new Motor Group
+         *
+         * @param group the pros motor group to get the ports from. Ports after the first MAX_GROUP_MOTORS are ignored
+         * @param outputVelocity the theoretical maximum output velocity of the motor group, after gearing
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     // pros motor group with motors on ports 1, -2, and 3
+         *     pros::MotorGroup prosMotorGroup({1, -2, 3});
+         *     // motor group that uses the same motors as the pros motor group
+         *     // and spins at 600 rpm
+         *     lemlib::CachedMotorGroup motorGroup(prosMotorGroup, 600_rpm);
+         * }
+         * @endcode
+         */
+        CachedMotorGroup(const pros::MotorGroup group, AngularVelocity outputVelocity);
+        /**
+         * @brief move the motors at a percent power from -1.0 to +1.0
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: the port cannot be configured as a motor
+         *
+         * @param percent the power to move the motors at from -1.0 to +1.0
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::CachedMotorGroup motorGroup({1, -2, 3}, 360_rpm);
+         *
+         *     // move the motors forward at 50% power
+         *     motorGroup.move(0.5);
+         *     // move the motors backward at 50% power
+         *     motorGroup.move(-0.5);
+         *     // stop the motors
+         *     motorGroup.move(0);
+         * }
+         * @endcode
+         */
+        int move(double percent);
+        /**
+         * @brief move the motors at a given angular velocity
+         *
+         * By default, the target is passed to the internal velocity controllers of the motors. If a velocity controller
+         * has been set with setVelocityController, it calculates a voltage for the group instead, and the function has
+         * to be called periodically, at 100 Hz or faster, for the controller to run. The acceleration of the target is
+         * estimated from the change of the target since the last call, limited to the maximum acceleration of the
+         * controller so a step in the target doesn't kick the motors. Targets from a motion profile should pass its
+         * acceleration instead.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: the port cannot be configured as a motor, or no motor could be read for the velocity controller
+         *
+         * EINVAL: the velocity controller was given a velocity which is not finite
+         *
+         * @param velocity the target angular velocity to move the motors at
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::CachedMotorGroup motorGroup({1, -2, 3}, 360_rpm);
+         *
+         *     // move the motors forward at 50 degrees per second
+         *     motorGroup.moveVelocity(50_degps);
+         *     // move the motors backward at 50 degrees per second
+         *     motorGroup.moveVelocity(-50_degps);
+         *     // stop the motors
+         *     motorGroup.moveVelocity(0_degps);
+         * }
+         * @endcode
+         */
+        int moveVelocity(AngularVelocity velocity);
+        /**
+         * @brief move the motors at a given angular velocity, which is changing at a known rate
+         *
+         * Like moveVelocity(AngularVelocity), but the velocity controller is given the acceleration of the target
+         * instead of estimating it, like when following a motion profile. The acceleration is ignored if no velocity
+         * controller has been set.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: the port cannot be configured as a motor, or no motor could be read for the velocity controller
+         *
+         * EINVAL: the velocity controller was given a velocity or acceleration which is not finite
+         *
+         * @param velocity the target angular velocity to move the motors at
+         * @param acceleration the acceleration of the target
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void autonomous() {
+         *     // ramp up to 300 rpm over half a second
+         *     const AngularAcceleration acceleration = 300_rpm / 500_msec;
+         *     for (int i = 1; i <= 50; i++) {
+         *         motorGroup.moveVelocity(300_rpm * i / 50, acceleration);
+         *         pros::delay(10);
+         *     }
+         * }
+         * @endcode
+         */
+        int moveVelocity(AngularVelocity velocity, AngularAcceleration acceleration);
+        /**
+         * @brief set the velocity controller used by moveVelocity
+         *
+         * The gains of the controller are in terms of the output velocity of the group, so they should be measured
+         * with a FeedforwardCharacterization of the group, using its angle. The controller starts again from its
+         * feedforward whenever moveVelocity hasn't been called for VELOCITY_CONTROL_TIMEOUT, or after the motors have
+         * been moved some other way.
+         *
+         * @param controller the controller, or std::nullopt to use the internal velocity controllers of the motors
+         *
+         * @b Example:
+         * @code {.cpp}
+         * lemlib::CachedMotorGroup motorGroup({1, -2, 3}, 360_rpm);
+         *
+         * void initialize() {
+         *     motorGroup.setVelocityController(lemlib::VelocityController(
+         *         {.kS = 0.6_volt, .kV = 0.03_volt / 1_rpm, .kA = 0.005_volt / 1_rpm2}, {.kP = 0.01_volt / 1_rpm}));
+         * }
+         *
+         * void opcontrol() {
+         *     while (true) {
+         *         motorGroup.moveVelocity(300_rpm);
+         *         pros::delay(10);
+         *     }
+         * }
+         * @endcode
+         */
+        void setVelocityController(std::optional<VelocityController> controller);
+        /**
+         * @brief brake the motors
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: the port cannot be configured as a motor
+         *
+         * This function will stop the motors using the set brake mode
+         *
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::CachedMotorGroup motorGroup({1, -2, 3}, 360_rpm);
+         *
+         *     // move the motors forward at 50% power
+         *     motorGroup.move(0.5);
+         *     // brake the motors
+         *     motorGroup.brake();
+         * }
+         * @endcode
+         */
+        int brake();
+        /**
+         * @brief set the brake mode of the motors
+         *
+         * @param mode the brake mode to set the motors to
+         * @return 0 on success
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::CachedMotorGroup motorGroup({1, -2, 3}, 360_rpm);
+         *
+         *     // set the motors to brake when stopped
+         *     motorGroup.setBrakeMode(lemlib::BrakeMode::BRAKE);
+         *     // set the motors to coast when stopped
+         *     motorGroup.setBrakeMode(lemlib::BrakeMode::COAST);
+         *     // set the motors to hold when stopped
+         *     motorGroup.setBrakeMode(lemlib::BrakeMode::HOLD);
+         * }
+         * @endcode
+         */
+        int setBrakeMode(BrakeMode mode);
+        /**
+         * @brief get the brake mode of the motor group
+         *
+         * @return BrakeMode enum value of the brake mode
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::CachedMotorGroup motorGroup({1, -2, 3}, 360_rpm);
+         *
+         *     const lemlib::BrakeMode mode = motorGroup.getBrakeMode();
+         *     if (mode == lemlib::BrakeMode::BRAKE) {
+         *         std::cout << "Brake mode is set to BRAKE!" << std::endl;
+         *     } else if (mode == lemlib::BrakeMode::COAST) {
+         *         std::cout << "Brake mode is set to COAST!" << std::endl;
+         *     } else if (mode == lemlib::BrakeMode::HOLD) {
+         *         std::cout << "Brake mode is set to HOLD!" << std::endl;
+         *     } else {
+         *         std::cout << "Error getting brake mode!" << std::endl;
+         *     }
+         * }
+         * @endcode
+         */
+        BrakeMode getBrakeMode();
+        /**
+         * @brief whether any of the motors in the motor group are connected
+         *
+         * @return 0 no motors are connected
+         * @return 1 if at least one motor is connected
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::CachedMotorGroup motorGroup({1, -2, 3}, 360_rpm);
+         *
+         *     const int result = motorGroup.isConnected();
+         *     if (result == 1) {
+         *         std::cout << "Encoder is connected!" << std::endl;
+         *     } else if (result == 0) {
+         *         std::cout << "Encoder is not connected!" << std::endl;
+         *     } else {
+         *         std::cout << "Error checking if encoder is connected!" << std::endl;
+         *     }
+         * }
+         * @endcode
+         */
+        int isConnected() override;
+        /**
+         * @brief read every motor in the group into the snapshot
+         *
+         * Each motor is read exactly once. Motors which have reconnected since the last sweep are configured to match
+         * the rest of the group. This is called automatically by getters when the snapshot is older than 1 ms, but it
+         * can be called at the start of a control loop so every getter in the loop uses the same data.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: no motors in the group are connected
+         *
+         * @return 0 on success
+         * @return INT_MAX if no motors are connected, setting errno
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void opcontrol() {
+         *     lemlib::CachedMotorGroup motorGroup({1, -2, 3}, 360_rpm);
+         *
+         *     while (true) {
+         *         // read the motors once
+         *         motorGroup.update();
+         *         // both of these use the data read by update()
+         *         const Angle angle = motorGroup.getAngle();
+         *         const int size = motorGroup.getSize();
+         *         pros::delay(10);
+         *     }
+         * }
+         * @endcode
+         */
+        int update();
+        /**
+         * @brief Get the snapshot of the motor group, updating it if it is older than 1 ms
+         *
+         * @return const Snapshot& the latest snapshot
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::CachedMotorGroup motorGroup({1, -2, 3}, 360_rpm);
+         *
+         *     const lemlib::CachedMotorGroup::Snapshot& snapshot = motorGroup.getSnapshot();
+         *     for (std::size_t i = 0; i < snapshot.count; i++) {
+         *         std::cout << snapshot.ports[i] << ": " << to_amp(snapshot.currents[i]) << " amps" << std::endl;
+         *     }
+         * }
+         * @endcode
+         */
+        const Snapshot& getSnapshot();
+        /**
+         * @brief Get the average velocity measured by the motors, after gearing
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: no motors in the group are connected
+         *
+         * @return AngularVelocity the average velocity of the connected motors
+         * @return INFINITY if there is an error, setting errno
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::CachedMotorGroup motorGroup({1, -2, 3}, 360_rpm);
+         *
+         *     std::cout << "Velocity: " << to_rpm(motorGroup.getVelocity()) << " rpm" << std::endl;
+         * }
+         * @endcode
+         */
+        AngularVelocity getVelocity();
+        /**
+         * @brief Get the acceleration of the group, estimated from its average angle
+         *
+         * Every sweep adds the average angle of the connected motors to the velocity estimator of the group, so the
+         * estimate is updated at the rate the group is used. Use setVelocityEstimator() to change how it is estimated.
+         *
+         * @return AngularAcceleration the estimated acceleration, after gearing
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::CachedMotorGroup motorGroup({1, -2, 3}, 360_rpm);
+         *
+         *     std::cout << "Acceleration: " << to_rpm2(motorGroup.getAcceleration()) << " rpm/min" << std::endl;
+         * }
+         * @endcode
+         */
+        AngularAcceleration getAcceleration();
+        /**
+         * @brief Set how the acceleration of the group is estimated, discarding the previous samples
+         *
+         * @param estimator the estimator to use
+         */
+        void setVelocityEstimator(const VelocityEstimator& estimator);
+        /**
+         * @brief Get the average relative angle measured by the motors
+         *
+         * The relative angle measured by the encoder is the angle of the encoder relative to the last time the encoder
+         * was reset. As such, it is unbounded.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: the port cannot be configured as a motor
+         *
+         * @return Angle the relative angle measured by the encoder
+         * @return INFINITY if there is an error, setting errno
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::CachedMotorGroup motorGroup({1, -2, 3}, 360_rpm);
+         *
+         *     const Angle angle = motorGroup.getAngle();
+         *     if (angle == INFINITY) {
+         *         std::cout << "Error getting relative angle!" << std::endl;
+         *     } else {
+         *         std::cout << "Relative angle: " << to_sDeg(angle) << std::endl;
+         *     }
+         * }
+         * @endcode
+         */
+        Angle getAngle() override;
+        /**
+         * @brief Set the relative angle of all the motors
+         *
+         * This function sets the relative angle of the encoder. The relative angle is the number of rotations the
+         * encoder has measured since the last reset. This function is non-blocking.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: the port cannot be configured as a motor
+         *
+         * @param angle the relative angle to set the measured angle to
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::CachedMotorGroup motorGroup({1, -2, 3}, 360_rpm);
+         *
+         *     if (motorGroup.setAngle(0_stDeg) == 0) {
+         *         std::cout << "Relative angle set!" << std::endl;
+         *         std::cout < "Relative angle: " << motorGroup.getAngle().convert(deg) << std::endl; // outputs 0
+         *     } else {
+         *         std::cout << "Error setting relative angle!" << std::endl;
+         *     }
+         * }
+         * @endcode
+         */
+        int setAngle(Angle angle) override;
+        /**
+         * @brief Get the combined current limit of all motors in the group
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * TODO: see how overheating affects this value
+         *
+         * ENODEV: the port cannot be configured as a motor
+         *
+         * @return Current the combined current limit of the motor group
+         * @return INFINITY on failure, setting errno
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::CachedMotorGroup motorGroup({1, -2, 3}, 360_rpm);
+         *
+         *     // output the current limit to the console
+         *     Current limit = motorGroup.getCurrentLimit();
+         *     if (units::to_amp(limit) == INFINITY) {
+         *         std::cout << "Error getting motor group current limit" << std::endl;
+         *     } else {
+         *         std::cout << "Current Limit: " << units::to_amp(limit) << std::endl;
+         *     }
+         * }
+         * @endcode
+         */
+        Current getCurrentLimit();
+        /**
+         * @brief set the combined current limit of all motors in the group
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: the port cannot be configured as a motor
+         *
+         * @param limit the maximum allowed current
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::CachedMotorGroup motorGroup({1, -2, 3}, 360_rpm);
+         *     // set the current limit to 6 amp
+         *     // every motor in the group will have a current limit of 2 amp
+         *     // making for a total current limit of 6 amp
+         *     motorGroup.setCurrentLimit(6_amp);
+         * }
+         * @endcode
+         */
+        int setCurrentLimit(Current limit);
+        /**
+         * @brief Get the temperatures of the motors in the motor group
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: the port cannot be configured as a motor
+         *
+         * @return vector<Temperature> vector of the temperatures of the motors
+         * @return INFINITY on failure, setting errno
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::CachedMotorGroup motorGroup({1, -2, 3}, 360_rpm);
+         *
+         *     // output motor temperatures to the console
+         *     std::vector<Temperature> temperatures = motorGroup.getTemperatures();
+         *     for (lemlib::Motor motor : motorGroup) {
+         *         if (units::to_celsius(temperature) == INFINITY) {
+         *             std::cout << "Error getting motor temperature" << std::endl;
+         *         } else {
+         *             std::cout << "Motor Temperature: " << units::to_celsius(motor.getTemperature()) << std::endl;
+         *         }
+         *     }
+         * }
+         * @endcode
+         */
+        std::vector<Temperature> getTemperatures();
+        /**
+         * @brief Get the number of connected motors in the group
+         *
+         * @return int the number of connected motors in the group
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::CachedMotorGroup motorGroup({1, -2, 3}, 360_rpm);
+         *
+         *     std::cout << "Number of connected motors: " << motorGroup.getSize() << std::endl;
+         * }
+         * @endcode
+         */
+        int getSize();
+        /**
+         * @brief Add a motor to the motor group
+         *
+         * This function adds a motor to the motor group. If successful, it will set the angle measured by the motor to
+         * the median angle measured by the motor group. The next sweep sets its brake mode to that of the group. If
+         * there are any errors, the motor will still be added to the group and it will be configured as soon as it is
+         * functional again.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: the port cannot be configured as a motor
+         *
+         * EEXIST: the motor is already in the group
+         *
+         * ENOMEM: the group already has MAX_GROUP_MOTORS motors. The motor is not added
+         *
+         * @param port the signed port of the motor to be added to the group. Negative ports indicate the motor should
+         * be reversed
+         *
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::CachedMotorGroup motorGroup({1, -2, 3}, 360_rpm);
+         *
+         *     // add a motor to the group
+         *     motorGroup.addMotor(4);
+         * }
+         * @endcode
+         */
+        int addMotor(int port);
+        /**
+         * @brief Add a motor to the motor group
+         *
+         * This function adds a motor to the motor group. If successful, it will set the angle measured by the motor to
+         * the median angle measured by the motor group. The next sweep sets its brake mode to that of the group. If
+         * there are any errors, the motor will still be added to the group and it will be configured as soon as it is
+         * functional again.
+         *
+         * @param motor the motor to be added to the group
+         *
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::CachedMotorGroup motorGroup({1, -2, 3}, 360_rpm);
+         *
+         *     // add a motor to the group
+         *     pros::Motor motor4(4, pros::v5::MotorGears::green);
+         *     motorGroup.addMotor(motor4);
+         * }
+         * @endcode
+         */
+        int addMotor(Motor motor);
+        /**
+         * @brief Add a motor to the motor group
+         *
+         * This function adds a motor to the motor group. If successful, it will set the angle measured by the motor to
+         * the median angle measured by the motor group. The next sweep sets its brake mode to that of the group. If
+         * there are any errors, the motor will still be added to the group and it will be configured as soon as it is
+         * functional again.
+         *
+         * @param motor the motor to be added to the group
+         * @param reversed whether the motor should be reversed
+         *
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::CachedMotorGroup motorGroup({1, -2, 3}, 360_rpm);
+         *
+         *    // add a motor to the group, which should be reversed
+         *     pros::Motor motor4(4, pros::v5::MotorGears::green);
+         *     motorGroup.addMotor(motor4, true);
+         * }
+         * @endcode
+         */
+        int addMotor(Motor motor, bool reversed);
+        /**
+         * @brief Remove a motor from the motor group
+         *
+         * @param port the port of the motor to be removed from the group
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::CachedMotorGroup motorGroup({1, -2, 3}, 360_rpm);
+         *
+         *     // remove a motor from the group
+         *     motorGroup.removeMotor(4);
+         * }
+         * @endcode
+         */
+        void removeMotor(int port);
+        /**
+         * @brief Remove a motor from the motor group
+         *
+         * @param motor the motor to be removed from the group
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void initialize() {
+         *     lemlib::CachedMotorGroup motorGroup({1, -2, 3}, 360_rpm);
+         *
+         *     // remove a motor from the group
+         *     pros::Motor motor4(4, pros::v5::MotorGears::green);
+         *     motorGroup.removeMotor(motor4);
+         * }
+         * @endcode
+         */
+        void removeMotor(Motor motor);
+    private:
+        struct MotorInfo {
+                int port = 0;
+                Angle offset = 0_stDeg;
+        };
+
+        /**
+         * @brief Read the i-th motor into the snapshot, making sure it uses the brake mode of the group
+         *
+         * @param i the index of the motor in m_motors
+         * @param motor the motor, with its offset applied
+         * @return true if the motor was read
+         */
+        bool sample(std::size_t i, Motor& motor);
+        /**
+         * @brief Get the median angle of the connected motors in the snapshot
+         *
+         * Every motor which reconnects in the same sweep is set to the same angle, so the median is used instead of
+         * the average: a motor which reconnected with a bad angle can't pull the others with it.
+         *
+         * @return Angle the median angle, or the last median if no motors are connected
+         */
+        Angle medianAngle();
+        /**
+         * @brief run the velocity controller once, and apply its voltage to the motors
+         *
+         * @param target the target velocity
+         * @param acceleration the acceleration of the target, or std::nullopt to estimate it from the last target
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int controlVelocity(AngularVelocity target, std::optional<AngularAcceleration> acceleration);
+        BrakeMode m_brakeMode = BrakeMode::COAST;
+        /**
+         * @brief Get the i-th motor in the motor group as a lemlib::Motor object, with its offset applied
+         *
+         * This function exists to simplify logic in the CachedMotorGroup source code.
+         *
+         * @param i the index of the motor in m_motors
+         * @return Motor the motor
+         */
+        Motor makeMotor(std::size_t i) const;
+        /**
+         * @brief update the snapshot if it is stale or older than 1 ms
+         */
+        void refresh();
+        const AngularVelocity m_outputVelocity;
+        /**
+         * The motors of the group, in the order they were added. Only the first m_size entries are used.
+         *
+         * Ideally, we'd store lemlib::Motor objects, but the copy constructor of lemlib::Motor is implicitly deleted.
+         * Instead, every motor is stored as its signed port, where negative ports are reversed, and the offset of its
+         * angle, which has to be saved by the group as motor objects are created when they are used.
+         */
+        std::array<MotorInfo, MAX_GROUP_MOTORS> m_motors {};
+        std::size_t m_size = 0;
+        /** bit i is set if motor i was connected and configured in the last sweep */
+        std::uint8_t m_connected = 0;
+        /** bit i is set if motor i has to be re-zeroed against the group before it is used, like after it reconnects */
+        std::uint8_t m_unconfigured = 0;
+        /** median angle of the group in the last sweep with a connected motor */
+        Angle m_lastAngle = 0_stDeg;
+        Snapshot m_snapshot;
+        bool m_stale = true;
+        /** estimates the acceleration from the average angle of every sweep */
+        VelocityEstimator m_velocityEstimator = VelocityEstimator::window();
+        std::optional<VelocityController> m_velocityController;
+        /** whether the velocity controller has been running since the motors were last moved some other way */
+        bool m_controlling = false;
+        /** target and time of the last update of the velocity controller */
+        AngularVelocity m_lastTarget = 0_rpm;
+        Time m_lastControl = 0_sec;
+};
+}; // namespace lemlib
\ No newline at end of file
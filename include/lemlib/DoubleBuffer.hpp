@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace lemlib {
+/**
+ * @brief Lock-free single writer, multiple reader buffer
+ *
+ * The writer publishes a new value into whichever of the two slots readers aren't being directed to, then flips a
+ * sequence counter. Readers copy the published slot and check the counter didn't move while they were copying,
+ * retrying if it did. Neither side ever blocks, and readers always see a complete value, never half of one write and
+ * half of another.
+ *
+ * Only one task may call write(). T should be a plain aggregate, since it may be copied while being overwritten and the
+ * copy is discarded in that case.
+ *
+ * @tparam T the type of the value
+ *
+ * @b Example:
+ * @code {.cpp}
+ * lemlib::DoubleBuffer<Pose> pose;
+ *
+ * void writer() {
+ *     pose.write(Pose(0_in, 0_in, 0_stDeg));
+ * }
+ *
+ * void reader() {
+ *     const Pose current = pose.read();
+ * }
+ * @endcode
+ */
+template <typename T> class DoubleBuffer {
+    public:
+        DoubleBuffer() = default;
+
+        /**
+         * @brief Construct a new Double Buffer with an initial value
+         *
+         * @param initial the value read before the first write
+         */
+        DoubleBuffer(const T& initial)
+            : m_slots({initial, initial}) {}
+
+        /**
+         * @brief publish a new value
+         *
+         * Must only be called by a single task.
+         *
+         * @param value the new value
+         */
+        void write(const T& value) {
+            const std::uint32_t sequence = m_sequence.load(std::memory_order_relaxed);
+            // odd while the inactive slot is being written
+            m_sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_slots[slot(sequence + 2)] = value;
+            m_sequence.store(sequence + 2, std::memory_order_release);
+        }
+
+        /**
+         * @brief read the last published value
+         *
+         * @return T a consistent copy of the last published value
+         */
+        T read() const {
+            while (true) {
+                const std::uint32_t before = m_sequence.load(std::memory_order_acquire);
+                T value = m_slots[slot(before)];
+                std::atomic_thread_fence(std::memory_order_acquire);
+                // the slot read is only overwritten once the writer starts the second write after it was published
+                const std::uint32_t published = before & ~std::uint32_t(1);
+                if (m_sequence.load(std::memory_order_relaxed) - published < 3) return value;
+            }
+        }
+
+        /**
+         * @brief Get the number of values which have been published
+         *
+         * @return std::uint32_t the number of writes
+         */
+        std::uint32_t writes() const { return m_sequence.load(std::memory_order_acquire) / 2; }
+    private:
+        /**
+         * @brief the slot a sequence number refers to
+         */
+        static std::size_t slot(std::uint32_t sequence) { return (sequence / 2) % 2; }
+
+        std::array<T, 2> m_slots {};
+        std::atomic<std::uint32_t> m_sequence = 0;
+};
+} // namespace lemlib
@@ -0,0 +1,237 @@
+#pragma once
+
+#include "hardware/IMU/Imu.hpp"
+#include "hardware/encoder/Encoder.hpp"
+#include "lemlib/FeedforwardCharacterization.hpp"
+#include "LemLog/logger/telemetry.hpp"
+#include <cstdint>
+#include <utility>
+
+namespace lemlib {
+/**
+ * @brief the tests run by a drivetrain characterization, in the order they are run
+ *
+ * Every test is followed by a rest, where the drivetrain coasts to a stop.
+ */
+enum class DrivetrainTest : std::uint32_t {
+    /** both sides ramp up slowly, driving forwards */
+    QUASISTATIC_FORWARD,
+    /** both sides ramp up slowly, driving backwards */
+    QUASISTATIC_BACKWARD,
+    /** both sides step to a constant voltage, driving forwards */
+    DYNAMIC_FORWARD,
+    /** both sides step to a constant voltage, driving backwards */
+    DYNAMIC_BACKWARD,
+    /** the sides ramp up slowly in opposite directions, turning counterclockwise */
+    TURN_COUNTERCLOCKWISE,
+    /** the sides ramp up slowly in opposite directions, turning clockwise */
+    TURN_CLOCKWISE,
+    /** the drivetrain coasts between tests */
+    REST,
+    /** every test has finished */
+    DONE
+};
+
+/**
+ * @brief a sample logged by a drivetrain characterization
+ */
+struct DrivetrainRecord {
+        /** the test running when the sample was measured */
+        DrivetrainTest test = DrivetrainTest::REST;
+        /** voltages applied to each side from this sample until the next one */
+        Voltage leftVoltage = 0_volt;
+        Voltage rightVoltage = 0_volt;
+        /** angles of the wheels on each side */
+        Angle leftAngle = 0_stRad;
+        Angle rightAngle = 0_stRad;
+        /** unbounded rotation measured by the IMU */
+        Angle rotation = 0_stRad;
+        /** when the sample was measured */
+        Time time = 0_sec;
+};
+
+/**
+ * @brief constants of a drivetrain, as measured by a drivetrain characterization
+ */
+struct DrivetrainConstants {
+        /** voltage needed to overcome friction */
+        Voltage kS = 0_volt;
+        /** voltage needed per unit of velocity of the robot */
+        Divided<Voltage, LinearVelocity> kV = 0_volt / 1_mps;
+        /** voltage needed per unit of acceleration of the robot */
+        Divided<Voltage, LinearAcceleration> kA = 0_volt / 1_mps2;
+        /** effective distance between the left and right wheels, including scrub */
+        Length trackWidth = 0_in;
+        /** effective diameter of the wheels */
+        Length wheelDiameter = 0_in;
+};
+
+/**
+ * @class DrivetrainFit
+ *
+ * @brief Fits the constants of a drivetrain to the samples logged by a drivetrain characterization
+ *
+ * The feedforward constants are fitted to the average of the two sides while driving straight, and the track width to
+ * the difference between the two sides while turning, compared with the rotation measured by the IMU.
+ *
+ * Encoders only measure how far the wheels turn, so a length is needed to turn angles into distances. By default the
+ * nominal wheel diameter is used. If the distance the robot drove in the forward quasistatic test is measured, like
+ * with a tape measure between where the robot started and where it stopped after the test, the effective wheel
+ * diameter is calculated from it, which also corrects the track width.
+ *
+ * Samples can be added as they are logged on the robot, or afterwards from a recording, like with the
+ * `drivetrain-characterize` tool.
+ */
+class DrivetrainFit {
+    public:
+        /**
+         * @brief Construct a new Drivetrain Fit
+         *
+         * @param window number of samples the velocity and acceleration are estimated over
+         * @param minimumVelocity samples where the wheels turn slower than this are ignored by the feedforward fit
+         */
+        DrivetrainFit(std::size_t window = 9, AngularVelocity minimumVelocity = 0.5_radps);
+
+        /**
+         * @brief add a sample
+         *
+         * Samples have to be added in the order they were logged. Samples which can't be used, like when a sensor
+         * couldn't be read, are skipped.
+         *
+         * @param record the sample
+         * @return 0 on success
+         * @return INT_MAX if the sample was skipped, setting errno
+         *
+         * @b errno values:
+         * - EINVAL: an angle or the time is not finite, or the time is not later than the previous sample
+         */
+        int add(const DrivetrainRecord& record);
+
+        /**
+         * @brief fit the constants to the samples added so far
+         *
+         * @param wheelDiameter the nominal diameter of the wheels
+         * @param distance the distance the robot drove in the forward quasistatic test, or 0 to use the nominal wheel
+         * diameter
+         * @return DrivetrainConstants the constants
+         * @return INFINITY constants on failure, setting errno
+         *
+         * @b errno values:
+         * - EDOM: the samples don't vary enough to fit the constants, like when a test was cut short
+         */
+        DrivetrainConstants solve(Length wheelDiameter, Length distance = 0_in) const;
+
+        /**
+         * @brief Get the fit of the feedforward constants of the wheels, in terms of the angle of the wheels
+         *
+         * @return const FeedforwardFit& the fit
+         */
+        const FeedforwardFit& getFeedforwardFit() const;
+    private:
+        CharacterizationSampler m_sampler;
+        FeedforwardFit m_fit;
+        /** the previous sample, whose voltages were applied until the current one */
+        DrivetrainRecord m_previous;
+        bool m_started = false;
+        /** average wheel angle at the start and end of the forward quasistatic test and the rest after it */
+        double m_forwardStart = 0;
+        double m_forwardEnd = 0;
+        bool m_forwardStarted = false;
+        bool m_forwardEnded = false;
+        /** sums of the changes of the difference between the sides and the rotation while turning, in radians */
+        double m_turnProduct = 0;
+        double m_turnSquare = 0;
+};
+
+/**
+ * @class DrivetrainCharacterization
+ *
+ * @brief Measures the constants of a drivetrain by driving it through voltage ramps and steps, and logging how it moves
+ *
+ * The characterization runs the tests in DrivetrainTest in order: quasistatic and dynamic tests forwards and
+ * backwards, like a FeedforwardCharacterization, then slow turns in both directions to measure the track width. The
+ * robot needs a clear space of a few meters in front of and behind it.
+ *
+ * Every update reads the encoders and the IMU, sends a sample on the "characterization/drivetrain" telemetry channel,
+ * and returns the voltages to apply to each side until the next update. The samples are fitted as they are logged, so
+ * the constants are available on the robot, and the recording can be fitted again on a computer with the
+ * `drivetrain-characterize` tool, built with `make -f sim.mk`.
+ *
+ * The characterization doesn't move the motors itself, so the same routine runs on the robot and in the simulator.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * lemlib::CachedMotorGroup leftMotors({1, -2, 3}, 450_rpm);
+ * lemlib::CachedMotorGroup rightMotors({-4, 5, -6}, 450_rpm);
+ * lemlib::V5InertialSensor imu(7);
+ * logger::Telemetry telemetry(stdout, [] { return std::uint32_t(pros::micros()); });
+ *
+ * void autonomous() {
+ *     lemlib::DrivetrainCharacterization characterization(leftMotors, rightMotors, imu, telemetry);
+ *     std::uint32_t now = pros::millis();
+ *     while (!characterization.isDone()) {
+ *         const auto [left, right] = characterization.update(from_sec(pros::micros() / 1e6));
+ *         leftMotors.move(to_volt(left) / 12);
+ *         rightMotors.move(to_volt(right) / 12);
+ *         pros::Task::delay_until(&now, 10);
+ *     }
+ *     const lemlib::DrivetrainConstants constants = characterization.getFit().solve(3.25_in);
+ * }
+ * @endcode
+ */
+class DrivetrainCharacterization {
+    public:
+        /**
+         * @brief Construct a new Drivetrain Characterization, and send the schema of its telemetry channel
+         *
+         * @param left the encoder of the left side, like its motor group
+         * @param right the encoder of the right side, like its motor group
+         * @param imu the IMU
+         * @param telemetry the telemetry stream to log the samples on
+         * @param config the voltages to apply. The turns use the same ramp as the quasistatic tests
+         */
+        DrivetrainCharacterization(Encoder& left, Encoder& right, Imu& imu, logger::Telemetry& telemetry,
+                                   CharacterizationConfig config = {});
+
+        /**
+         * @brief measure and log a sample, and get the voltages to apply next
+         *
+         * The first update starts the characterization. Samples where a sensor couldn't be read are still logged, but
+         * aren't fitted.
+         *
+         * @param time the current time
+         * @return std::pair<Voltage, Voltage> the voltages to apply to the left and right sides until the next update.
+         * 0 once the characterization is done
+         */
+        std::pair<Voltage, Voltage> update(Time time);
+
+        /**
+         * @brief whether every test has finished
+         */
+        bool isDone() const;
+
+        /**
+         * @brief Get the test running at the last update
+         *
+         * @return DrivetrainTest the test
+         */
+        DrivetrainTest getTest() const;
+
+        /**
+         * @brief Get the fit of the samples logged so far
+         *
+         * @return const DrivetrainFit& the fit
+         */
+        const DrivetrainFit& getFit() const;
+    private:
+        Encoder& m_left;
+        Encoder& m_right;
+        Imu& m_imu;
+        logger::Telemetry::Channel<std::uint32_t, Voltage, Voltage, Angle, Angle, Angle> m_channel;
+        const CharacterizationConfig m_config;
+        DrivetrainFit m_fit;
+        DrivetrainTest m_test = DrivetrainTest::REST;
+        Time m_start = 0_sec;
+        bool m_started = false;
+};
+} // namespace lemlib
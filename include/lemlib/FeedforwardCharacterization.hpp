@@ -0,0 +1,264 @@
+#pragma once
+
+#include "hardware/encoder/VelocityEstimator.hpp"
+#include "lemlib/VelocityController.hpp"
+#include <array>
+#include <cstddef>
+
+namespace lemlib {
+/**
+ * @class FeedforwardFit
+ *
+ * @brief Fits feedforward constants to samples of voltage, velocity, and acceleration with least squares
+ *
+ * The fit only keeps running sums of the samples, so it takes constant memory no matter how long the motor is logged
+ * for, and samples can be added as they are measured on the robot, or from a log afterwards.
+ *
+ * Samples slower than a minimum velocity are ignored. Static friction is larger than kinetic friction, and the
+ * direction of the friction is ambiguous while the motor is stopped, so those samples would bias kS.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * lemlib::FeedforwardFit fit;
+ * for (const Sample& sample : log) fit.add(sample.voltage, sample.velocity, sample.acceleration);
+ * const lemlib::FeedforwardGains gains = fit.solve();
+ * @endcode
+ */
+class FeedforwardFit {
+    public:
+        /**
+         * @brief Construct a new Feedforward Fit
+         *
+         * @param minimumVelocity samples slower than this are ignored
+         */
+        FeedforwardFit(AngularVelocity minimumVelocity = 0.5_radps);
+
+        /**
+         * @brief add a sample
+         *
+         * @param voltage the voltage applied to the motor
+         * @param velocity the measured velocity
+         * @param acceleration the measured acceleration
+         * @return 0 on success, or if the sample was ignored because it is too slow
+         * @return INT_MAX on failure, setting errno. The fit is not changed
+         *
+         * @b errno values:
+         * - EINVAL: an input is not finite
+         */
+        int add(Voltage voltage, AngularVelocity velocity, AngularAcceleration acceleration);
+
+        /**
+         * @brief fit the constants to the samples added so far
+         *
+         * The samples have to vary in both velocity and acceleration for the constants to be told apart, like from a
+         * slow voltage ramp and a sudden voltage step.
+         *
+         * @return FeedforwardGains the constants which minimize the squared error of the voltage
+         * @return INFINITY constants on failure, setting errno
+         *
+         * @b errno values:
+         * - EDOM: the samples don't vary enough to fit the constants
+         */
+        FeedforwardGains solve() const;
+
+        /**
+         * @brief get the root mean square error of the voltage predicted by constants over the samples
+         *
+         * @param gains the constants, like the ones returned by solve()
+         * @return Voltage the error, or 0 if there are no samples
+         */
+        Voltage rmsError(const FeedforwardGains& gains) const;
+
+        /**
+         * @brief get the number of samples used by the fit
+         *
+         * @return std::size_t the number of samples which weren't ignored
+         */
+        std::size_t getCount() const;
+
+        /**
+         * @brief discard every sample
+         */
+        void reset();
+    private:
+        const AngularVelocity m_minimumVelocity;
+        std::size_t m_count = 0;
+        /** sums of x * x^T, where x is (sgn(v), v, a), in radians and seconds */
+        std::array<std::array<double, 3>, 3> m_xx {};
+        /** sums of x * V */
+        std::array<double, 3> m_xy {};
+        /** sum of V^2 */
+        double m_yy = 0;
+};
+
+/**
+ * @class CharacterizationSampler
+ *
+ * @brief Estimates the velocity and acceleration of a motor from the angles logged during characterization tests, and
+ * adds them to a fit
+ *
+ * The velocity and acceleration are estimated with a least squares window. The curvature of the window is the
+ * acceleration in its middle rather than at its newest sample, which matters while the motor is accelerating quickly,
+ * so each acceleration is matched with the velocity and voltage from the middle of the window. Windows of an odd
+ * number of samples have a sample in the middle.
+ *
+ * Samples right after the start of a test are not fitted, until the window only holds samples from that test.
+ */
+class CharacterizationSampler {
+    public:
+        /**
+         * @brief Construct a new Characterization Sampler
+         *
+         * @param window number of samples the velocity and acceleration are estimated over, clamped from 3 to
+         * MAX_VELOCITY_WINDOW
+         */
+        CharacterizationSampler(std::size_t window = 9);
+
+        /**
+         * @brief add a sample
+         *
+         * @param voltage the voltage applied since the previous sample. Samples at 0 V are not fitted, since a motor
+         * which is braking or coasting isn't driven by the voltage
+         * @param angle the measured angle
+         * @param time when the angle was measured
+         * @param fit the fit to add the sample to
+         * @return 0 on success, or if the sample wasn't fitted
+         * @return INT_MAX on failure, setting errno
+         *
+         * @b errno values:
+         * - EINVAL: the angle or time is not finite, or the time is not later than the previous sample
+         */
+        int update(Voltage voltage, Angle angle, Time time, FeedforwardFit& fit);
+
+        /**
+         * @brief start a new test
+         */
+        void restart();
+    private:
+        struct Sample {
+                double voltage;
+                double velocity;
+        };
+
+        VelocityEstimator m_estimator;
+        /** number of samples between the newest sample and the middle of the window */
+        const std::size_t m_delay;
+        /** ring buffer of the most recent samples, indexed by the number of samples since the start */
+        std::array<Sample, MAX_VELOCITY_WINDOW> m_history {};
+        std::size_t m_samples = 0;
+        /** samples since the current test started */
+        std::size_t m_settled = 0;
+};
+
+/**
+ * @brief the voltages applied by a feedforward characterization
+ */
+struct CharacterizationConfig {
+        /** how fast the voltage increases in the quasistatic tests, in volts per second */
+        double rampRate = 0.5;
+        /** how long each quasistatic test lasts */
+        Time rampDuration = 6_sec;
+        /** the voltage applied in the dynamic tests */
+        Voltage stepVoltage = 6_volt;
+        /** how long each dynamic test lasts */
+        Time stepDuration = 1.5_sec;
+        /** how long the motor coasts to a stop after each test */
+        Time restDuration = 1.5_sec;
+        /** number of samples the velocity and acceleration are estimated over, clamped from 3 to MAX_VELOCITY_WINDOW */
+        std::size_t window = 9;
+};
+
+/**
+ * @class FeedforwardCharacterization
+ *
+ * @brief Measures the feedforward constants of a motor by applying known voltages and logging how it moves
+ *
+ * The characterization runs four tests: a quasistatic test forwards and backwards, where the voltage increases slowly
+ * so the acceleration is close to 0 and the velocity shows kS and kV, then a dynamic test forwards and backwards,
+ * where a sudden voltage step accelerates the motor and shows kA. Running in both directions keeps a mechanism close to
+ * where it started, and averages out differences between the directions.
+ *
+ * The characterization doesn't control the motor itself, so the same routine works on the robot and in the simulator.
+ * Every update takes the angle of the motor and returns the voltage to apply until the next update. The samples are
+ * fitted as they are measured, with a CharacterizationSampler.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * lemlib::FeedforwardCharacterization characterization;
+ *
+ * while (!characterization.isDone()) {
+ *     const Voltage output = characterization.update(motor.getAngle(), from_sec(pros::micros() / 1e6));
+ *     motor.move(to_volt(output) / 12);
+ *     pros::delay(10);
+ * }
+ * motor.move(0);
+ * const lemlib::FeedforwardGains gains = characterization.getGains();
+ * @endcode
+ */
+class FeedforwardCharacterization {
+    public:
+        /**
+         * @brief Construct a new Feedforward Characterization
+         *
+         * @param config the voltages to apply
+         * @param fit fits the constants to the samples
+         */
+        FeedforwardCharacterization(CharacterizationConfig config = {}, FeedforwardFit fit = {});
+
+        /**
+         * @brief add a sample, and get the voltage to apply next
+         *
+         * The first update starts the characterization.
+         *
+         * @param angle the measured angle
+         * @param time when the angle was measured
+         * @return Voltage the voltage to apply until the next update. 0 once the characterization is done
+         * @return INFINITY on failure, setting errno. The voltage from the last update should still be applied
+         *
+         * @b errno values:
+         * - EINVAL: the angle or time is not finite, or the time is not later than the last update
+         */
+        Voltage update(Angle angle, Time time);
+
+        /**
+         * @brief whether every test has finished
+         */
+        bool isDone() const;
+
+        /**
+         * @brief fit the constants to the samples logged so far
+         *
+         * @return FeedforwardGains the constants
+         * @return INFINITY constants on failure, setting errno, as FeedforwardFit::solve()
+         */
+        FeedforwardGains getGains() const;
+
+        /**
+         * @brief Get the fit of the samples logged so far
+         *
+         * @return const FeedforwardFit& the fit
+         */
+        const FeedforwardFit& getFit() const;
+    private:
+        /**
+         * @brief get the test running at a time since the start
+         *
+         * @return int the index of the test, counting the rests between them, or -1 once every test is done
+         */
+        int phase(Time elapsed) const;
+        /**
+         * @brief get the voltage to apply at a time since the start
+         */
+        Voltage voltage(Time elapsed) const;
+
+        const CharacterizationConfig m_config;
+        CharacterizationSampler m_sampler;
+        FeedforwardFit m_fit;
+        Time m_start = 0_sec;
+        bool m_started = false;
+        bool m_done = false;
+        int m_phase = 0;
+        /** voltage returned by the last update, which was applied until this one */
+        Voltage m_voltage = 0_volt;
+};
+} // namespace lemlib
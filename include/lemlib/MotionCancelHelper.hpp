@@ -1,8 +1,49 @@
 #pragma once
 
 #include "units/units.hpp"
+#include <array>
 
 namespace lemlib {
+/**
+ * @brief Timing statistics of a motion loop
+ *
+ * Execution time is the time between wait() returning and the next call to wait(), so it is the time spent running
+ * one iteration of the motion. Jitter is how late the loop woke up compared to when it was scheduled to.
+ */
+struct LoopStats {
+        /**
+         * @brief number of buckets in the execution time histogram
+         *
+         * Each bucket is a quarter of the loop period wide, so the first 4 buckets are iterations which finished within
+         * the period. The last bucket also holds all iterations which took longer than it.
+         */
+        static constexpr std::size_t HISTOGRAM_BUCKETS = 8;
+
+        /** number of iterations measured */
+        std::uint32_t iterations = 0;
+        /** number of iterations which took longer than the loop period */
+        std::uint32_t overruns = 0;
+        Time maxExecutionTime = 0_sec;
+        Time totalExecutionTime = 0_sec;
+        Time maxJitter = 0_sec;
+        Time totalJitter = 0_sec;
+        /** number of iterations in each bucket, by execution time */
+        std::array<std::uint32_t, HISTOGRAM_BUCKETS> histogram {};
+
+        /**
+         * @brief Get the mean execution time of an iteration
+         *
+         * @return Time the mean execution time, or 0 if there have been no iterations
+         */
+        Time meanExecutionTime() const;
+        /**
+         * @brief Get the mean jitter of the loop
+         *
+         * @return Time the mean jitter, or 0 if there have been no iterations
+         */
+        Time meanJitter() const;
+};
+
 /**
  * @class MotionCancelHelper
  *
@@ -34,7 +75,11 @@ class MotionCancelHelper {
          * The amount of time it waits is dependent on how long each iteration of the
          * while loop its in takes. See example below.
          *
+         * If an exit condition is passed and it is true, the function returns false immediately when there is another
+         * motion queued, so the next motion can start in the same control tick. See motion_handler::queue().
+         *
          * @param timeout how long to wait
+         * @param exitCondition whether the motion is close enough to its target to hand off to the next motion
          * @returns true if the motion should continue, false otherwise
          *
          * @b Example:
@@ -56,9 +101,76 @@ class MotionCancelHelper {
          * }
          * @endcode
          */
-        bool wait(Time timeout);
+        bool wait(Time timeout, bool exitCondition = false);
+        /**
+         * @brief check whether the motion ended early to hand off to a queued motion
+         *
+         * Motions should skip braking if this is true, so the robot keeps moving into the next motion.
+         *
+         * @return true the motion exited early
+         * @return false the motion was cancelled, or hasn't ended early
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void myMotion() {
+         *   lemlib::MotionCancelHelper helper;
+         *   while (helper.wait(10_msec, closeEnough())) {
+         *     // motion stuff here
+         *   }
+         *   // leave the motors running if the next motion is taking over
+         *   if (!helper.exitedEarly()) drivetrain.brake();
+         * }
+         * @endcode
+         */
+        bool exitedEarly() const;
+        /**
+         * @brief Get the timing statistics of the motion loop
+         *
+         * @return const LoopStats& the statistics, updated every time wait() is called
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void myMotion() {
+         *   lemlib::MotionCancelHelper helper;
+         *   while (helper.wait(10_msec)) {
+         *     // motion stuff here
+         *   }
+         *   // check how many iterations took longer than 10 ms
+         *   std::cout << helper.getStats().overruns << std::endl;
+         * }
+         * @endcode
+         */
+        const LoopStats& getStats() const;
+        /**
+         * @brief send a summary of the timing statistics through LemLog, on the "lemlib/motions/timing" topic
+         *
+         * The summary is sent as a warning if any iterations overran the loop period, and as a debug message
+         * otherwise. It is kept short enough to fit in a single ring buffer record, like
+         * "myMotion: 150 iters, exec 1.20/2.31 ms, jitter 0.05/0.42 ms, 0 overruns", where the times are the mean and
+         * the maximum.
+         *
+         * @param name the name of the motion. Must be a string literal, or otherwise outlive the message
+         *
+         * @b Example:
+         * @code {.cpp}
+         * void myMotion() {
+         *   lemlib::MotionCancelHelper helper;
+         *   while (helper.wait(10_msec)) {
+         *     // motion stuff here
+         *   }
+         *   helper.logStats("myMotion");
+         * }
+         * @endcode
+         */
+        void logStats(const char* name) const;
     private:
         bool firstIteration = true;
+        bool earlyExit = false;
+        /** time wait() last returned, in microseconds */
+        std::uint64_t iterationStart = 0;
+        LoopStats stats;
+        /** time the loop is next scheduled to wake up, in microseconds, or 0 if it hasn't been scheduled yet */
+        std::uint64_t wakeTime = 0;
         std::uint32_t prevTime;
         const int originalCompStatus;
 };
@@ -1,12 +1,114 @@
 #pragma once
 
-#include <functional>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace lemlib::motion_handler {
+/**
+ * @brief maximum size of a callable passed to the motion handler, in bytes
+ *
+ * Lambdas capturing by reference, function pointers, and std::function all fit.
+ */
+constexpr std::size_t MOTION_STORAGE_SIZE = 64;
+
+/**
+ * @brief maximum number of motions which can be queued at the same time
+ */
+constexpr std::size_t MOTION_QUEUE_SIZE = 8;
+
+/**
+ * @brief A type-erased motion function with fixed inline storage
+ *
+ * The callable is stored inside the object, so handing a motion to the motion handler doesn't allocate. Callables
+ * larger than MOTION_STORAGE_SIZE are rejected at compile time.
+ */
+class Motion {
+    public:
+        Motion() = default;
+
+        template <typename F>
+            requires(!std::is_same_v<std::remove_cvref_t<F>, Motion>)
+        Motion(F&& f) {
+            using Stored = std::remove_cvref_t<F>;
+            static_assert(sizeof(Stored) <= MOTION_STORAGE_SIZE, "Motion function is too large, capture less state");
+            static_assert(alignof(Stored) <= alignof(std::max_align_t), "Motion function is over-aligned");
+            new (m_storage) Stored(std::forward<F>(f));
+            m_invoke = [](void* storage) { (*static_cast<Stored*>(storage))(); };
+            m_manage = [](void* storage, void* destination) {
+                Stored* stored = static_cast<Stored*>(storage);
+                if (destination != nullptr) new (destination) Stored(std::move(*stored));
+                stored->~Stored();
+            };
+        }
+
+        Motion(Motion&& other) { *this = std::move(other); }
+
+        Motion& operator=(Motion&& other) {
+            if (this == &other) return *this;
+            reset();
+            if (other.m_manage != nullptr) other.m_manage(other.m_storage, m_storage);
+            m_invoke = other.m_invoke;
+            m_manage = other.m_manage;
+            other.m_invoke = nullptr;
+            other.m_manage = nullptr;
+            return *this;
+        }
+
+        ~Motion() { reset(); }
+
+        /**
+         * @brief run the motion function
+         */
+        void operator()() { m_invoke(m_storage); }
+
+        /**
+         * @brief check whether the object holds a motion function
+         */
+        explicit operator bool() const { return m_invoke != nullptr; }
+
+        /**
+         * @brief destroy the stored motion function, if there is one
+         */
+        void reset() {
+            if (m_manage != nullptr) m_manage(m_storage, nullptr);
+            m_invoke = nullptr;
+            m_manage = nullptr;
+        }
+    private:
+        alignas(std::max_align_t) unsigned char m_storage[MOTION_STORAGE_SIZE];
+        void (*m_invoke)(void* storage) = nullptr;
+        /** moves the stored function to destination if it isn't nullptr, then destroys it */
+        void (*m_manage)(void* storage, void* destination) = nullptr;
+};
+
+/**
+ * @brief hand a motion to the motion executor task
+ *
+ * Blocks until all previous motions have finished. See move().
+ *
+ * @param motion the motion to run
+ */
+void submit(Motion&& motion);
+
+/**
+ * @brief add a motion to the end of the motion queue without blocking. See queue().
+ *
+ * @param motion the motion to run
+ * @return true the motion was queued
+ * @return false the queue is full
+ */
+bool enqueue(Motion&& motion);
+
 /**
  * @brief run a motion algorithm
  *
- * @param f the motion function
+ * Motions are run by a single persistent task, which is created the first time this function is called. If a motion
+ * is already running, this function blocks until it ends, and the new motion starts as soon as it does. No task, stack,
+ * or heap memory is allocated per motion.
+ *
+ * @param f the motion function. Must be at most MOTION_STORAGE_SIZE bytes
  *
  * @b Example:
  * @code {.cpp}
@@ -35,9 +137,55 @@ namespace lemlib::motion_handler {
  * }
  * @endcode
  */
-void move(std::function<void(void)> f);
+template <typename F> void move(F&& f) { submit(Motion(std::forward<F>(f))); }
+
 /**
- * @brief cancel the currently running motion, if it exists
+ * @brief queue a motion algorithm to run after the motions before it, without waiting
+ *
+ * Queued motions run in order on the motion executor task. A motion can end early once it is close enough to its
+ * target by passing an exit condition to MotionCancelHelper::wait(). If another motion is queued, wait() then returns
+ * false, and the next motion starts in the same control tick. Motions which exit early should leave the drivetrain
+ * moving, so the robot doesn't slow down between motions.
+ *
+ * @param f the motion function. Must be at most MOTION_STORAGE_SIZE bytes
+ * @return true the motion was queued
+ * @return false the queue is full, so the motion was discarded
+ *
+ * @b Example:
+ * @code {.cpp}
+ * // a motion which can hand off to the next motion once it is close to its target
+ * void driveTo(Length target) {
+ *   lemlib::MotionCancelHelper helper;
+ *   while (helper.wait(10_msec, units::abs(target - distanceTravelled()) < 2_in)) {
+ *     // motion algorithm stuff would go here
+ *   }
+ *   // only stop the robot if no motion is taking over
+ *   if (!helper.exitedEarly()) drivetrain.brake();
+ * }
+ *
+ * void autonomous() {
+ *   // returns immediately. The second motion starts as soon as the first is within 2 inches of its target
+ *   lemlib::motion_handler::queue([] { driveTo(24_in); });
+ *   lemlib::motion_handler::queue([] { driveTo(48_in); });
+ * }
+ * @endcode
+ */
+template <typename F> bool queue(F&& f) { return enqueue(Motion(std::forward<F>(f))); }
+
+/**
+ * @brief Get the number of motions waiting in the queue, not including the running motion
+ *
+ * @return std::size_t the number of queued motions
+ */
+std::size_t queued();
+
+/**
+ * @brief cancel the running motion, and discard all queued motions
+ */
+void cancelAll();
+
+/**
+ * @brief check whether a motion is running or queued
  *
  * @b Example:
  * @code {.cpp}
@@ -69,6 +217,8 @@ bool isMoving();
 /**
  * @brief cancel the currently running motion, if it exists
  *
+ * Queued motions are not affected, so the next one starts immediately. Use cancelAll() to discard them too.
+ *
  * @b Example:
  * @code {.cpp}
  * // a simple motion algorithm, as an example
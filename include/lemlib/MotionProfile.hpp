@@ -0,0 +1,173 @@
+#pragma once
+
+#include "units/Pose.hpp"
+#include "units/Vector2DArray.hpp"
+#include <cmath>
+#include <vector>
+
+namespace lemlib {
+/**
+ * @brief limits a motion profile must respect
+ */
+struct ProfileConstraints {
+        /** maximum velocity of the robot */
+        LinearVelocity maxVelocity;
+        /** maximum acceleration and deceleration of the robot */
+        LinearAcceleration maxAcceleration;
+        /** maximum rate of change of the acceleration. Infinite for a trapezoidal profile, finite for an S-curve */
+        LinearJerk maxJerk = LinearJerk(INFINITY);
+        /** maximum centripetal acceleration in turns, which slows the robot down in tight curves */
+        LinearAcceleration maxLateralAcceleration = LinearAcceleration(INFINITY);
+        /** distance between the left and right wheels. If not 0, the outer wheel never exceeds maxVelocity */
+        Length trackWidth = 0_m;
+        /** velocity at the start of the profile */
+        LinearVelocity startVelocity = 0_mps;
+        /** velocity at the end of the profile */
+        LinearVelocity endVelocity = 0_mps;
+};
+
+/**
+ * @brief a setpoint of a motion profile
+ */
+struct ProfilePoint {
+        /** time since the start of the profile */
+        Time time = 0_sec;
+        /** distance travelled along the path */
+        Length distance = 0_m;
+        /** velocity along the path */
+        LinearVelocity velocity = 0_mps;
+        /** acceleration along the path */
+        LinearAcceleration acceleration = 0_mps2;
+        /** curvature of the path, positive when turning counterclockwise */
+        Curvature curvature = 0_radpm;
+        /** position and heading on the path, in standard orientation */
+        units::Pose pose = units::Pose(0_m, 0_m, 0_stRad);
+};
+
+/**
+ * @class MotionProfile
+ *
+ * @brief Time parameterized velocity profile along a path
+ *
+ * The profile is generated once, before the motion starts, and stored as a table of setpoints at a fixed period.
+ * Looking up the setpoint for a control tick indexes the table and interpolates between two entries, so it takes the
+ * same time at any point of any profile. Entries are stored as floats, which is 28 bytes per tick.
+ *
+ * The velocity at each point of the path is limited by the maximum velocity, the curvature of the path, and the
+ * velocity from which the robot can still decelerate to every later limit. If the maximum jerk is infinite the profile
+ * is trapezoidal, and the acceleration jumps between 0 and its limits. Otherwise the profile is an S-curve, and the
+ * acceleration ramps at the maximum jerk.
+ *
+ * @b Example
+ * @code {.cpp}
+ * const units::Vector2DArray<Length> path = {units::V2Position(0_in, 0_in), units::V2Position(24_in, 0_in),
+ *                                            units::V2Position(48_in, 24_in)};
+ * const lemlib::MotionProfile profile =
+ *     lemlib::MotionProfile::generate(path, {.maxVelocity = 60_inps, .maxAcceleration = 120_inps2,
+ *                                            .maxJerk = 600_inps3, .maxLateralAcceleration = 80_inps2});
+ *
+ * for (Time t = 0_sec; t < profile.getDuration(); t += 10_msec) {
+ *     const lemlib::ProfilePoint setpoint = profile.sample(t);
+ *     // feed setpoint.velocity and setpoint.acceleration to the velocity controller
+ *     pros::delay(10);
+ * }
+ * @endcode
+ */
+class MotionProfile {
+    public:
+        /**
+         * @brief Construct a new empty MotionProfile
+         */
+        MotionProfile() = default;
+
+        /**
+         * @brief Generate a motion profile along a path
+         *
+         * @param path the points of the path. Points closer together than 0.1 mm are skipped
+         * @param constraints the limits of the profile
+         * @param period the time between entries in the table
+         * @return MotionProfile the profile, or an empty profile on failure, setting errno
+         *
+         * @b errno values:
+         * - EINVAL: the path has less than 2 distinct points, or a constraint isn't positive
+         */
+        static MotionProfile generate(const units::Vector2DArray<Length>& path, const ProfileConstraints& constraints,
+                                      Time period = 10_msec);
+
+        /**
+         * @brief Generate a motion profile along a straight line
+         *
+         * The poses of the profile are on the x axis.
+         *
+         * @param distance the length of the line
+         * @param constraints the limits of the profile
+         * @param period the time between entries in the table
+         * @return MotionProfile the profile, or an empty profile on failure, setting errno
+         *
+         * @b errno values:
+         * - EINVAL: the distance or a constraint isn't positive
+         */
+        static MotionProfile generate(Length distance, const ProfileConstraints& constraints, Time period = 10_msec);
+
+        /**
+         * @brief get the setpoint at a time
+         *
+         * @param time time since the start of the profile. Times outside of the profile are clamped to it
+         * @return ProfilePoint the setpoint, or a setpoint at rest at the origin if the profile is empty
+         */
+        ProfilePoint sample(Time time) const;
+
+        /**
+         * @brief get the total time of the profile
+         *
+         * @return Time
+         */
+        Time getDuration() const;
+
+        /**
+         * @brief get the length of the path the profile follows
+         *
+         * @return Length
+         */
+        Length getLength() const;
+
+        /**
+         * @brief get the number of entries in the table
+         *
+         * @return std::size_t
+         */
+        std::size_t size() const;
+    private:
+        /**
+         * @brief a table entry, stored as floats to halve the size of the table
+         */
+        struct Entry {
+                LengthF distance;
+                LinearVelocityF velocity;
+                LinearAccelerationF acceleration;
+                CurvatureF curvature;
+                LengthF x;
+                LengthF y;
+                AngleF heading;
+        };
+
+        /**
+         * @brief a point of the path, after it has been subdivided
+         */
+        struct Node {
+                double distance;
+                double x;
+                double y;
+                double heading;
+                double curvature;
+                /** square of the maximum velocity at this node */
+                double limit;
+        };
+
+        static MotionProfile generate(std::vector<Node>& nodes, const ProfileConstraints& constraints, Time period);
+
+        Time m_period = 10_msec;
+        Time m_duration = 0_sec;
+        std::vector<Entry> m_entries;
+};
+} // namespace lemlib
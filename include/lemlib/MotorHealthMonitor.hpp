@@ -0,0 +1,219 @@
+#pragma once
+
+#include "lemlib/CachedMotorGroup.hpp"
+#include "lemlib/DoubleBuffer.hpp"
+#include "lemlib/filters/EmaFilter.hpp"
+#include "pros/rtos.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+
+namespace lemlib {
+/**
+ * @brief maximum number of motors a health monitor can watch
+ */
+constexpr std::size_t MAX_MONITORED_MOTORS = 16;
+
+/**
+ * @brief the health of a motor
+ */
+enum class MotorHealthState : std::uint8_t {
+    /** running at the full current limit */
+    NORMAL,
+    /** warm enough that its current limit is being reduced */
+    DERATED,
+    /** as hot as the temperature at which the V5 firmware starts throttling it */
+    OVERHEATED,
+    /** not connected, or couldn't be read */
+    DISCONNECTED
+};
+
+/**
+ * @brief how the current limit of a motor is reduced as it heats up
+ *
+ * The V5 firmware cuts the power of a motor in steps once it reaches 55 °C, so a hot motor suddenly loses half of its
+ * torque in the middle of a motion. Reducing the current limit smoothly before then keeps the motor below that
+ * temperature for longer, and makes the robot slow down predictably instead.
+ */
+struct DeratingConfig {
+        /** current limit of a motor which isn't derated */
+        Current currentLimit = 2.5_amp;
+        /** temperature at which derating starts */
+        Temperature startTemperature = 40_celsius;
+        /** temperature at which the current limit reaches its minimum */
+        Temperature endTemperature = 55_celsius;
+        /** lowest current limit, as a fraction of currentLimit */
+        double minimumFraction = 0.25;
+        /** motors at least this hot are reported as overheated */
+        Temperature overheatTemperature = 55_celsius;
+        /** how fast the current limit can change, in amps per second */
+        double slewRate = 0.5;
+        /** cutoff frequency of the filter on the temperature. The motors report temperatures in 5 °C steps */
+        Frequency temperatureCutoff = 0.05_Hz;
+};
+
+/**
+ * @brief the health of a single motor, as measured by a health monitor
+ */
+struct MotorHealth {
+        /** signed port of the motor */
+        int port = 0;
+        MotorHealthState state = MotorHealthState::DISCONNECTED;
+        /** filtered temperature of the motor */
+        Temperature temperature = 0_kelvin;
+        /** current drawn by the motor, or INFINITY if it couldn't be read */
+        Current current = 0_amp;
+        /** current limit applied to the motor */
+        Current limit = 0_amp;
+};
+
+/**
+ * @brief the health of every monitored motor from a single sweep
+ */
+struct MotorHealthSnapshot {
+        /** number of sweeps completed when the snapshot was published */
+        std::uint32_t sweep = 0;
+        /** health of the motors, in the order they were added */
+        std::array<MotorHealth, MAX_MONITORED_MOTORS> motors {};
+};
+
+/**
+ * @class MotorHealthMonitor
+ *
+ * @brief Watches the temperature, current, and connection of motors in a background task, and derates hot motors
+ *
+ * Every sweep reads each motor once, filters its temperature, and moves its current limit towards the limit for that
+ * temperature at a limited rate. Changes of state, like a motor disconnecting or starting to derate, are logged to the
+ * "lemlib/motors/health" topic. The table of motors has a fixed size, so sweeps don't allocate.
+ *
+ * The monitor owns the current limits of its motors while it is running, and overwrites limits set by other code.
+ * Motors must be added before the monitor is started.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * lemlib::CachedMotorGroup leftMotors({1, -2, 3}, 360_rpm);
+ * lemlib::MotorHealthMonitor monitor;
+ *
+ * void initialize() {
+ *     monitor.addGroup(leftMotors);
+ *     monitor.start();
+ * }
+ *
+ * void opcontrol() {
+ *     while (true) {
+ *         const lemlib::MotorHealth health = monitor.getMotor(0);
+ *         if (health.state == lemlib::MotorHealthState::DERATED) {
+ *             std::cout << "Motor 1 limited to " << to_amp(health.limit) << " A" << std::endl;
+ *         }
+ *         pros::delay(100);
+ *     }
+ * }
+ * @endcode
+ */
+class MotorHealthMonitor {
+    public:
+        /**
+         * @brief Construct a new Motor Health Monitor
+         *
+         * The monitor doesn't read anything until it is started.
+         *
+         * @param config how to derate hot motors
+         * @param period how often to read the motors. Rounded to the nearest millisecond, and at least 1 ms
+         * @param priority the priority of the monitoring task
+         */
+        MotorHealthMonitor(DeratingConfig config = {}, Time period = 100_msec,
+                           std::uint32_t priority = TASK_PRIORITY_DEFAULT);
+        /**
+         * @brief add a motor to monitor
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * EBUSY: the monitor has already been started
+         *
+         * ENOMEM: the monitor is already watching MAX_MONITORED_MOTORS motors
+         *
+         * @param port the signed port of the motor
+         * @return int the index of the motor in MotorHealthSnapshot::motors
+         * @return INT_MAX on failure, setting errno
+         */
+        int addMotor(int port);
+        /**
+         * @brief add every motor in a motor group to monitor
+         *
+         * Motors added to the group later are not monitored.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * EBUSY: the monitor has already been started
+         *
+         * ENOMEM: the monitor doesn't have room for every motor in the group. No motors are added
+         *
+         * @param group the motor group
+         * @return int the index of the first motor of the group in MotorHealthSnapshot::motors
+         * @return INT_MAX on failure, setting errno
+         */
+        int addGroup(CachedMotorGroup& group);
+        /**
+         * @brief start monitoring the motors
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * EBUSY: the monitor has already been started
+         *
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int start();
+        /**
+         * @brief stop monitoring the motors, waiting for the current sweep to finish
+         *
+         * The current limits of the motors are left as they are.
+         */
+        void stop();
+        /**
+         * @brief Get the health of the motors from the latest sweep
+         *
+         * This function never blocks, and can be called from any task.
+         *
+         * @return MotorHealthSnapshot the latest health
+         */
+        MotorHealthSnapshot getSnapshot() const;
+        /**
+         * @brief Get the latest health of a motor
+         *
+         * @param id the index returned by addMotor, or an index in the range returned by addGroup
+         * @return MotorHealth the latest health. Disconnected if the id is out of range
+         */
+        MotorHealth getMotor(int id) const;
+        /**
+         * @brief get the current limit for a temperature
+         *
+         * @param temperature the temperature of the motor
+         * @return Current the current limit, before it is slew rate limited
+         */
+        Current deratedLimit(Temperature temperature) const;
+        ~MotorHealthMonitor();
+    private:
+        /**
+         * @brief read every motor once, update their current limits, and publish their health
+         */
+        void sweep();
+
+        struct Entry {
+                EmaFilter<Temperature> temperature = EmaFilter<Temperature>(1);
+                /** current limit last applied to the motor, or INFINITY if it has to be applied again */
+                Current limit = from_amp(INFINITY);
+        };
+
+        const DeratingConfig m_config;
+        const std::uint32_t m_period;
+        const std::uint32_t m_priority;
+        std::array<Entry, MAX_MONITORED_MOTORS> m_entries {};
+        std::size_t m_count = 0;
+        MotorHealthSnapshot m_working;
+        DoubleBuffer<MotorHealthSnapshot> m_published;
+        std::atomic<bool> m_running = false;
+        std::optional<pros::Task> m_task;
+};
+} // namespace lemlib
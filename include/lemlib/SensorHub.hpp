@@ -0,0 +1,205 @@
+#pragma once
+
+#include "hardware/IMU/Imu.hpp"
+#include "hardware/encoder/Encoder.hpp"
+#include "hardware/encoder/VelocityEstimator.hpp"
+#include "lemlib/DoubleBuffer.hpp"
+#include "pros/rtos.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+
+namespace lemlib {
+/**
+ * @brief maximum number of encoders a sensor hub can sample
+ */
+constexpr std::size_t MAX_HUB_ENCODERS = 8;
+
+/**
+ * @brief maximum number of IMUs a sensor hub can sample
+ */
+constexpr std::size_t MAX_HUB_IMUS = 4;
+
+/**
+ * @brief a single timestamped sensor reading
+ */
+struct SensorReading {
+        /** the angle measured by the sensor, or INFINITY if it couldn't be read */
+        Angle angle = 0_stDeg;
+        /** when the sensor was read, in microseconds since the program started */
+        std::uint64_t time = 0;
+        /** velocity estimated from the readings of the encoder up to this one. 0 for IMUs */
+        AngularVelocity velocity = 0_radps;
+        /** acceleration estimated from the readings of the encoder up to this one. 0 for IMUs */
+        AngularAcceleration acceleration = 0_radps2;
+        /** whether the sensor was read successfully */
+        bool valid = false;
+};
+
+/**
+ * @brief the readings of every sensor from a single sweep of the sensor hub
+ */
+struct SensorSnapshot {
+        /** number of sweeps completed when the snapshot was published */
+        std::uint32_t sweep = 0;
+        /** readings of the encoders, in the order they were added */
+        std::array<SensorReading, MAX_HUB_ENCODERS> encoders {};
+        /** rotations of the IMUs, in the order they were added */
+        std::array<SensorReading, MAX_HUB_IMUS> imus {};
+};
+
+/**
+ * @class SensorHub
+ *
+ * @brief Samples sensors at a fixed rate in a single high priority task
+ *
+ * Reading an encoder or IMU blocks the calling task while the device is accessed. Instead of every task reading the
+ * sensors it needs whenever it needs them, the sensor hub reads all of its sensors one after another at a fixed rate,
+ * and publishes the readings together. Readers never block, and always get readings from the same sweep.
+ *
+ * Sensors must be added before the hub is started, and must outlive it.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * lemlib::V5RotationSensor leftEncoder(1);
+ * lemlib::V5InertialSensor imu(2);
+ * lemlib::SensorHub hub(5_msec);
+ *
+ * int leftId;
+ * int imuId;
+ *
+ * void initialize() {
+ *     leftId = hub.addEncoder(leftEncoder);
+ *     imuId = hub.addImu(imu);
+ *     hub.start();
+ * }
+ *
+ * void opcontrol() {
+ *     while (true) {
+ *         const lemlib::SensorSnapshot snapshot = hub.getSnapshot();
+ *         if (snapshot.encoders[leftId].valid) {
+ *             std::cout << "Left: " << to_stDeg(snapshot.encoders[leftId].angle) << std::endl;
+ *         }
+ *         pros::delay(10);
+ *     }
+ * }
+ * @endcode
+ */
+class SensorHub {
+    public:
+        /**
+         * @brief Construct a new Sensor Hub
+         *
+         * The hub doesn't sample anything until it is started.
+         *
+         * @param period how often to sample the sensors. Rounded to the nearest millisecond, and at least 1 ms
+         * @param priority the priority of the sampling task. Should be higher than any task which uses the readings
+         */
+        SensorHub(Time period = 5_msec, std::uint32_t priority = TASK_PRIORITY_MAX - 2);
+        /**
+         * @brief add an encoder to sample
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * EBUSY: the hub has already been started
+         *
+         * ENOMEM: the hub is already sampling MAX_HUB_ENCODERS encoders
+         *
+         * @param encoder the encoder to sample
+         * @return int the index of the encoder's readings in SensorSnapshot::encoders
+         * @return INT_MAX on failure, setting errno
+         */
+        int addEncoder(Encoder& encoder);
+        /**
+         * @brief add an IMU to sample
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * EBUSY: the hub has already been started
+         *
+         * ENOMEM: the hub is already sampling MAX_HUB_IMUS IMUs
+         *
+         * @param imu the IMU to sample
+         * @return int the index of the IMU's readings in SensorSnapshot::imus
+         * @return INT_MAX on failure, setting errno
+         */
+        int addImu(Imu& imu);
+        /**
+         * @brief Set how the velocity and acceleration of an encoder are estimated
+         *
+         * Each encoder has its own estimator, which is only used by the sampling task. By default, a window of the last
+         * 8 readings is used.
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * EBUSY: the hub has already been started
+         *
+         * EINVAL: the id is out of range
+         *
+         * @param id the index returned by addEncoder
+         * @param estimator the estimator to use
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int setVelocityEstimator(int id, const VelocityEstimator& estimator);
+        /**
+         * @brief start sampling the sensors
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * EBUSY: the hub has already been started
+         *
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int start();
+        /**
+         * @brief stop sampling the sensors, waiting for the current sweep to finish
+         *
+         * The last snapshot stays readable after the hub is stopped.
+         */
+        void stop();
+        /**
+         * @brief Get the readings from the latest sweep
+         *
+         * This function never blocks, and can be called from any task.
+         *
+         * @return SensorSnapshot the latest readings
+         */
+        SensorSnapshot getSnapshot() const;
+        /**
+         * @brief Get the latest reading of an encoder
+         *
+         * @param id the index returned by addEncoder
+         * @return SensorReading the latest reading. Not valid if the id is out of range
+         */
+        SensorReading getEncoder(int id) const;
+        /**
+         * @brief Get the latest reading of an IMU
+         *
+         * @param id the index returned by addImu
+         * @return SensorReading the latest reading. Not valid if the id is out of range
+         */
+        SensorReading getImu(int id) const;
+        ~SensorHub();
+    private:
+        /**
+         * @brief read every sensor once and publish the readings
+         */
+        void sweep();
+
+        const std::uint32_t m_period;
+        const std::uint32_t m_priority;
+        std::array<Encoder*, MAX_HUB_ENCODERS> m_encoders {};
+        /** only accessed by the sampling task while the hub is running */
+        std::array<VelocityEstimator, MAX_HUB_ENCODERS> m_estimators;
+        std::size_t m_encoderCount = 0;
+        std::array<Imu*, MAX_HUB_IMUS> m_imus {};
+        std::size_t m_imuCount = 0;
+        SensorSnapshot m_working;
+        DoubleBuffer<SensorSnapshot> m_published;
+        std::atomic<bool> m_running = false;
+        std::optional<pros::Task> m_task;
+};
+} // namespace lemlib
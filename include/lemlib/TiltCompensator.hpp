@@ -0,0 +1,109 @@
+#pragma once
+
+#include "units/Quaternion.hpp"
+#include "units/Vector2D.hpp"
+
+namespace lemlib {
+/**
+ * @class TiltCompensator
+ *
+ * @brief Projects odometry displacements measured on a tilted robot onto the field
+ *
+ * Tracking wheels measure distance along the surface the robot is driving on. When the robot is tilted, like when it
+ * drives up a ramp or over a barrier, part of that distance is vertical, and odometry which treats it as horizontal
+ * overestimates how far the robot moved.
+ *
+ * The pitch and roll reported by an IMU drift slowly, while the direction of gravity measured by its accelerometer
+ * doesn't drift, but is noisy and wrong whenever the robot accelerates. The compensator fuses them with a
+ * complementary filter: the IMU angles are corrected by an offset, which is slowly pulled towards the angles measured
+ * by the accelerometer, but only while the magnitude of the measured acceleration is close to gravity.
+ *
+ * The tilt rotation is calculated once per update, so compensating each displacement is 3 multiplications.
+ *
+ * @b Example
+ * @code {.cpp}
+ * lemlib::TiltCompensator tilt;
+ *
+ * // every odometry tick
+ * tilt.update(roll, pitch, heading, acceleration);
+ * units::V2Position level = tilt.compensate(units::V2Position(forward, sideways));
+ * @endcode
+ */
+class TiltCompensator {
+    public:
+        /**
+         * @brief Construct a new TiltCompensator
+         *
+         * @param accelWeight how strongly each accelerometer reading corrects the IMU angles, from 0 to 1. Higher
+         * values correct drift faster, but let more accelerometer noise through
+         * @param gravityTolerance accelerometer readings are only used if their magnitude is within this fraction of
+         * gravity
+         */
+        TiltCompensator(double accelWeight = 0.02, double gravityTolerance = 0.1);
+
+        /**
+         * @brief update the orientation of the robot
+         *
+         * @param roll roll measured by the IMU, counterclockwise about the forward axis of the robot
+         * @param pitch pitch measured by the IMU, counterclockwise about the left axis of the robot
+         * @param yaw heading of the robot, in standard orientation
+         * @param accel acceleration measured by the accelerometer of the IMU, in the frame of the robot. x is forwards,
+         * y is to the left, and z is up, so a robot sitting on a level field measures +1 g on z
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno. The orientation is not changed
+         *
+         * @b errno values:
+         * - EINVAL: roll, pitch, or yaw is not finite, like when the IMU couldn't be read
+         */
+        int update(Angle roll, Angle pitch, Angle yaw, units::V3Acceleration accel);
+
+        /**
+         * @brief project a displacement measured in the plane of the robot onto the level plane
+         *
+         * The result is still relative to the heading of the robot, so it can be rotated onto the field the same way
+         * an uncompensated displacement would be.
+         *
+         * @param displacement displacement measured by the tracking wheels. x is forwards, y is to the left
+         * @return units::V2Position the horizontal part of the displacement
+         */
+        units::V2Position compensate(units::V2Position displacement) const;
+
+        /**
+         * @brief get the fused roll of the robot
+         *
+         * @return Angle
+         */
+        Angle getRoll() const;
+
+        /**
+         * @brief get the fused pitch of the robot
+         *
+         * @return Angle
+         */
+        Angle getPitch() const;
+
+        /**
+         * @brief get the fused orientation of the robot
+         *
+         * @return units::Quaternion
+         */
+        units::Quaternion getOrientation() const;
+
+        /**
+         * @brief reset the fused angles to the IMU angles, discarding the correction from the accelerometer
+         */
+        void reset();
+    private:
+        double m_accelWeight;
+        double m_gravityTolerance;
+        /** correction added to the IMU angles, in radians */
+        double m_rollOffset = 0;
+        double m_pitchOffset = 0;
+        /** fused angles, in radians */
+        double m_roll = 0;
+        double m_pitch = 0;
+        double m_yaw = 0;
+        /** rotation from the plane of the robot to the level plane, without yaw */
+        units::RotationMatrix m_tilt;
+};
+} // namespace lemlib
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "units/Angle.hpp"
+
+namespace lemlib {
+/**
+ * @brief feedforward constants of a motor and its load
+ *
+ * The voltage needed to move at a velocity v with an acceleration a is modelled as
+ *
+ * V = kS * sgn(v) + kV * v + kA * a
+ *
+ * where kS overcomes friction, kV overcomes the back EMF of the motor, and kA accelerates the load. They can be
+ * measured with a FeedforwardCharacterization.
+ */
+struct FeedforwardGains {
+        /** voltage needed to overcome friction */
+        Voltage kS = 0_volt;
+        /** voltage needed per unit of velocity */
+        Divided<Voltage, AngularVelocity> kV = 0_volt / 1_radps;
+        /** voltage needed per unit of acceleration */
+        Divided<Voltage, AngularAcceleration> kA = 0_volt / 1_radps2;
+};
+
+/**
+ * @brief gains of the PID which corrects the error left by the feedforward
+ */
+struct VelocityPidGains {
+        /** voltage per unit of velocity error */
+        Divided<Voltage, AngularVelocity> kP = 0_volt / 1_radps;
+        /** voltage per unit of integrated velocity error, which is an angle */
+        Divided<Voltage, Angle> kI = 0_volt / 1_stRad;
+        /** voltage per unit of change of the velocity error */
+        Divided<Voltage, AngularAcceleration> kD = 0_volt / 1_radps2;
+};
+
+/**
+ * @class VelocityController
+ *
+ * @brief Controls the velocity of a motor with a feedforward, and a PID to correct what the feedforward misses
+ *
+ * The internal velocity controller of the V5 motors can't be tuned, runs at a rate that can't be changed, and lags
+ * behind changes of the target. This controller calculates the voltage for the target directly from a model of the
+ * motor, so it responds to the target immediately, and only uses feedback for the small error left by the model. It
+ * should be updated at 100 Hz or faster.
+ *
+ * The integral stops accumulating while the output is saturated in the direction of the error, so it doesn't wind up
+ * while the motor can't keep up.
+ *
+ * @b Example:
+ * @code {.cpp}
+ * lemlib::VelocityController controller({.kS = 0.6_volt, .kV = 0.02_volt / 1_rpm, .kA = 0.004_volt / 1_rpm2},
+ *                                       {.kP = 0.01_volt / 1_rpm});
+ *
+ * lemlib::CachedMotorGroup motorGroup({1, -2, 3}, 600_rpm);
+ *
+ * while (true) {
+ *     const Voltage output = controller.update(300_rpm, 0_rpm2, motorGroup.getVelocity(), 10_msec);
+ *     motorGroup.move(to_volt(output) / 12);
+ *     pros::delay(10);
+ * }
+ * @endcode
+ */
+class VelocityController {
+    public:
+        /**
+         * @brief Construct a new Velocity Controller
+         *
+         * @param feedforward the feedforward constants of the motor
+         * @param pid the gains of the PID. No feedback is used by default
+         * @param maxVoltage the largest voltage the controller outputs
+         */
+        VelocityController(FeedforwardGains feedforward, VelocityPidGains pid = {}, Voltage maxVoltage = 12_volt);
+
+        /**
+         * @brief calculate the feedforward voltage for a velocity and acceleration, without any feedback
+         *
+         * @param velocity the target velocity
+         * @param acceleration the target acceleration
+         * @return Voltage the voltage, not clamped. No friction is compensated at a velocity of 0
+         */
+        Voltage feedforward(AngularVelocity velocity, AngularAcceleration acceleration) const;
+
+        /**
+         * @brief Get the fastest the motor can accelerate, according to the feedforward constants
+         *
+         * The motor accelerates fastest from a standstill, with all of the voltage left after overcoming friction.
+         * Useful to bound an acceleration estimated from a changing target, which is huge when the target steps.
+         *
+         * @return AngularAcceleration the maximum acceleration
+         * @return INFINITY if kA is not positive, or friction takes the whole maximum voltage
+         */
+        AngularAcceleration maxAcceleration() const;
+
+        /**
+         * @brief calculate the voltage to apply for the next period
+         *
+         * @param target the target velocity
+         * @param targetAcceleration the target acceleration, like from a motion profile. 0 if the target is constant
+         * @param measured the measured velocity
+         * @param dt the time since the last update
+         * @return Voltage the voltage, clamped to the maximum voltage
+         * @return INFINITY on failure, setting errno. The state of the controller is not changed
+         *
+         * @b errno values:
+         * - EINVAL: an input is not finite, like when the velocity couldn't be measured, or dt is not positive
+         */
+        Voltage update(AngularVelocity target, AngularAcceleration targetAcceleration, AngularVelocity measured,
+                       Time dt);
+
+        /**
+         * @brief forget the integral and the previous error, like when the controller hasn't been used for a while
+         */
+        void reset();
+
+        /**
+         * @brief Get the feedforward constants
+         *
+         * @return FeedforwardGains the constants
+         */
+        FeedforwardGains getFeedforward() const;
+    private:
+        const FeedforwardGains m_feedforward;
+        const VelocityPidGains m_pid;
+        const Voltage m_maxVoltage;
+        /** integral of the velocity error */
+        Angle m_integral = 0_stRad;
+        AngularVelocity m_previousError = 0_radps;
+        bool m_started = false;
+};
+} // namespace lemlib
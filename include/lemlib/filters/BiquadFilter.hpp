@@ -0,0 +1,105 @@
+#pragma once
+
+#include "units/units.hpp"
+#include <cmath>
+
+namespace lemlib {
+/**
+ * @class BiquadFilter
+ *
+ * @brief Second order IIR filter
+ *
+ * Implemented in transposed direct form II, which is 5 multiplications per sample. Filters are usually created with
+ * lowPass, which uses the coefficients from the Audio EQ Cookbook. The state is set from the first sample as if the
+ * filter had been fed it forever, so a low pass filter doesn't ramp up from 0.
+ *
+ * @tparam Q the type of the samples
+ *
+ * @b Example
+ * @code {.cpp}
+ * // remove noise above 5 Hz from a velocity sampled every 10 ms
+ * lemlib::BiquadFilter<AngularVelocity> filter = lemlib::BiquadFilter<AngularVelocity>::lowPass(5_Hz, 10_msec);
+ * const AngularVelocity velocity = filter.update(measured);
+ * @endcode
+ */
+template <isQuantity Q> class BiquadFilter {
+    public:
+        using Rep = typename Q::rep;
+
+        /**
+         * @brief Construct a new BiquadFilter from its coefficients
+         *
+         * The coefficients are normalized so a0 is 1.
+         *
+         * @param b0 feedforward coefficient of the current sample
+         * @param b1 feedforward coefficient of the previous sample
+         * @param b2 feedforward coefficient of the sample before that
+         * @param a1 feedback coefficient of the previous output
+         * @param a2 feedback coefficient of the output before that
+         */
+        constexpr BiquadFilter(Rep b0, Rep b1, Rep b2, Rep a1, Rep a2)
+            : m_b0(b0),
+              m_b1(b1),
+              m_b2(b2),
+              m_a1(a1),
+              m_a2(a2) {}
+
+        /**
+         * @brief Create a new second order low pass filter
+         *
+         * @param cutoff the frequency at which the filter attenuates by 3 dB, when quality is the default. Must be less
+         * than half the sample rate
+         * @param period the time between samples
+         * @param quality the quality factor. The default, 1 / sqrt(2), is a Butterworth filter, which has no overshoot
+         * in the frequency response
+         * @return BiquadFilter
+         */
+        static BiquadFilter lowPass(Frequency cutoff, Time period, double quality = M_SQRT1_2) {
+            const double w0 = 2 * M_PI * cutoff.internal() * period.internal();
+            const double cosW0 = std::cos(w0);
+            const double alpha = std::sin(w0) / (2 * quality);
+            const double a0 = 1 + alpha;
+            const double b0 = (1 - cosW0) / 2 / a0;
+            return BiquadFilter(Rep(b0), Rep(2 * b0), Rep(b0), Rep(-2 * cosW0 / a0), Rep((1 - alpha) / a0));
+        }
+
+        /**
+         * @brief filter a sample
+         *
+         * @param sample the newest sample
+         * @return Q the filtered value
+         */
+        constexpr Q update(Q sample) {
+            const Rep x = sample.internal();
+            if (!m_initialized) {
+                // the steady state for a constant input, scaled by the DC gain
+                const Rep gain = (m_b0 + m_b1 + m_b2) / (Rep(1) + m_a1 + m_a2);
+                m_z1 = x * (gain - m_b0);
+                m_z2 = x * (m_b2 - m_a2 * gain);
+                m_initialized = true;
+            }
+            m_value = m_b0 * x + m_z1;
+            m_z1 = m_b1 * x - m_a1 * m_value + m_z2;
+            m_z2 = m_b2 * x - m_a2 * m_value;
+            return Q(m_value);
+        }
+
+        /**
+         * @brief get the last filtered value
+         *
+         * @return Q
+         */
+        constexpr Q getValue() const { return Q(m_value); }
+
+        /**
+         * @brief reset the filter, so its state is set from the next sample
+         */
+        constexpr void reset() { m_initialized = false; }
+    private:
+        Rep m_b0, m_b1, m_b2, m_a1, m_a2;
+        Rep m_z1 = Rep(0);
+        Rep m_z2 = Rep(0);
+        Rep m_value = Rep(0);
+        bool m_initialized = false;
+};
+} // namespace lemlib
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "units/units.hpp"
+#include <cmath>
+
+namespace lemlib {
+/**
+ * @class EmaFilter
+ *
+ * @brief Exponential moving average low pass filter
+ *
+ * Each output moves towards the newest sample by a fixed fraction of the difference. The first sample is passed
+ * through unchanged, so the filter doesn't start from 0.
+ *
+ * @tparam Q the type of the samples
+ *
+ * @b Example
+ * @code {.cpp}
+ * // smooth the temperature of a motor, sampled every 10 ms
+ * lemlib::EmaFilter<Temperature> filter = lemlib::EmaFilter<Temperature>::fromCutoff(1_Hz, 10_msec);
+ * const Temperature smoothed = filter.update(motor.getTemperature());
+ * @endcode
+ */
+template <isQuantity Q> class EmaFilter {
+    public:
+        using Rep = typename Q::rep;
+
+        /**
+         * @brief Construct a new EmaFilter
+         *
+         * @param alpha the fraction of the difference to the newest sample to move by, from 0 to 1. Higher values
+         * follow the samples faster, but smooth less
+         */
+        explicit constexpr EmaFilter(Rep alpha)
+            : m_alpha(alpha) {}
+
+        /**
+         * @brief Create a new EmaFilter with a cutoff frequency
+         *
+         * @param cutoff the frequency at which the filter attenuates by 3 dB
+         * @param period the time between samples
+         * @return EmaFilter
+         */
+        static EmaFilter fromCutoff(Frequency cutoff, Time period) {
+            return EmaFilter(Rep(1.0 - std::exp(-2 * M_PI * cutoff.internal() * period.internal())));
+        }
+
+        /**
+         * @brief filter a sample
+         *
+         * @param sample the newest sample
+         * @return Q the filtered value
+         */
+        constexpr Q update(Q sample) {
+            if (!m_initialized) {
+                m_value = sample.internal();
+                m_initialized = true;
+            } else {
+                m_value += (sample.internal() - m_value) * m_alpha;
+            }
+            return Q(m_value);
+        }
+
+        /**
+         * @brief get the last filtered value
+         *
+         * @return Q
+         */
+        constexpr Q getValue() const { return Q(m_value); }
+
+        /**
+         * @brief reset the filter, so the next sample is passed through unchanged
+         */
+        constexpr void reset() { m_initialized = false; }
+    private:
+        Rep m_alpha;
+        Rep m_value = Rep(0);
+        bool m_initialized = false;
+};
+} // namespace lemlib
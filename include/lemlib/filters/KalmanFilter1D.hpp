@@ -0,0 +1,97 @@
+#pragma once
+
+#include "units/units.hpp"
+#include <cmath>
+
+namespace lemlib {
+/**
+ * @class KalmanFilter1D
+ *
+ * @brief Kalman filter for a single value
+ *
+ * Models the value as a random walk, which changes by a normally distributed amount between samples, and is measured
+ * with normally distributed noise. Changes with a known cause, like the commanded movement of a mechanism, can be
+ * applied with predict before the next measurement.
+ *
+ * The gain converges to the optimal steady state gain for the two noise levels, which makes the filter an EMA whose
+ * weight is chosen from the noise instead of by hand, but which follows the samples faster while it is uncertain.
+ *
+ * @tparam Q the type of the samples
+ *
+ * @b Example
+ * @code {.cpp}
+ * // the arm moves at most about 1 degree per sample, and the potentiometer is accurate to about 3 degrees
+ * lemlib::KalmanFilter1D<Angle> filter(1_stDeg, 3_stDeg);
+ * const Angle angle = filter.update(potentiometer.getAngle());
+ * @endcode
+ */
+template <isQuantity Q> class KalmanFilter1D {
+    public:
+        using Rep = typename Q::rep;
+
+        /**
+         * @brief Construct a new KalmanFilter1D
+         *
+         * @param processNoise standard deviation of the change in the value between samples
+         * @param measurementNoise standard deviation of the noise of each sample
+         */
+        constexpr KalmanFilter1D(Q processNoise, Q measurementNoise)
+            : m_processVariance(processNoise.internal() * processNoise.internal()),
+              m_measurementVariance(measurementNoise.internal() * measurementNoise.internal()) {}
+
+        /**
+         * @brief apply a known change to the estimate
+         *
+         * @param change the change in the value since the last sample
+         */
+        constexpr void predict(Q change) { m_estimate += change.internal(); }
+
+        /**
+         * @brief filter a sample
+         *
+         * @param measurement the newest sample
+         * @return Q the estimated value
+         */
+        constexpr Q update(Q measurement) {
+            if (!m_initialized) {
+                m_estimate = measurement.internal();
+                m_variance = m_measurementVariance;
+                m_initialized = true;
+                return Q(m_estimate);
+            }
+            m_variance += m_processVariance;
+            const Rep gain = m_variance / (m_variance + m_measurementVariance);
+            m_estimate += gain * (measurement.internal() - m_estimate);
+            m_variance = (Rep(1) - gain) * m_variance;
+            return Q(m_estimate);
+        }
+
+        /**
+         * @brief get the estimated value
+         *
+         * @return Q
+         */
+        constexpr Q getValue() const { return Q(m_estimate); }
+
+        /**
+         * @brief get the standard deviation of the estimate
+         *
+         * @return Q
+         */
+        Q getStandardDeviation() const {
+            using std::sqrt;
+            return Q(sqrt(m_variance));
+        }
+
+        /**
+         * @brief reset the filter, so the next sample is used as the estimate
+         */
+        constexpr void reset() { m_initialized = false; }
+    private:
+        Rep m_processVariance;
+        Rep m_measurementVariance;
+        Rep m_estimate = Rep(0);
+        Rep m_variance = Rep(0);
+        bool m_initialized = false;
+};
+} // namespace lemlib
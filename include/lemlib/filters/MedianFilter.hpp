@@ -0,0 +1,89 @@
+#pragma once
+
+#include "units/units.hpp"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+namespace lemlib {
+/**
+ * @class MedianFilter
+ *
+ * @brief Median of the last N samples
+ *
+ * Rejects spikes, like a single bad sensor reading, without smoothing edges. The window is kept sorted as samples are
+ * added, so each update moves at most N elements and never sorts. Until N samples have been added, the output is the
+ * median of the samples so far.
+ *
+ * Samples which aren't finite, like the INFINITY returned by a sensor which couldn't be read, are ignored, and don't
+ * replace a sample in the window.
+ *
+ * @tparam Q the type of the samples
+ * @tparam N the number of samples in the window. Must be odd
+ *
+ * @b Example
+ * @code {.cpp}
+ * lemlib::MedianFilter<Angle, 5> filter;
+ * const Angle angle = filter.update(encoder.getAngle());
+ * @endcode
+ */
+template <isQuantity Q, std::size_t N> class MedianFilter {
+        static_assert(N % 2 == 1, "the window of a median filter must have an odd size");
+    public:
+        using Rep = typename Q::rep;
+
+        /**
+         * @brief filter a sample
+         *
+         * @param sample the newest sample. Ignored if it isn't finite
+         * @return Q the median of the window
+         */
+        constexpr Q update(Q sample) {
+            const Rep value = sample.internal();
+            if constexpr (std::is_floating_point_v<Rep>) {
+                // NaN would never compare equal when it is removed, and has no place in the sorted window
+                if (!std::isfinite(value)) return getValue();
+            }
+            std::size_t i = m_count;
+            if (m_count == N) {
+                // remove the oldest sample from the sorted window
+                const Rep oldest = m_window[m_next];
+                i = 0;
+                while (i + 1 < N && m_sorted[i] != oldest) i++;
+                for (; i + 1 < N; i++) m_sorted[i] = m_sorted[i + 1];
+                i = N - 1;
+            } else {
+                m_count++;
+            }
+            // insert the new sample, shifting larger ones up
+            for (; i > 0 && m_sorted[i - 1] > value; i--) m_sorted[i] = m_sorted[i - 1];
+            m_sorted[i] = value;
+            m_window[m_next] = value;
+            m_next = m_next + 1 == N ? 0 : m_next + 1;
+            return getValue();
+        }
+
+        /**
+         * @brief get the median of the window
+         *
+         * @return Q
+         */
+        constexpr Q getValue() const { return Q(m_count == 0 ? Rep(0) : m_sorted[(m_count - 1) / 2]); }
+
+        /**
+         * @brief remove every sample from the window
+         */
+        constexpr void reset() {
+            m_count = 0;
+            m_next = 0;
+        }
+    private:
+        /** samples, in the order they were added */
+        std::array<Rep, N> m_window {};
+        /** samples, sorted from smallest to largest */
+        std::array<Rep, N> m_sorted {};
+        std::size_t m_count = 0;
+        std::size_t m_next = 0;
+};
+} // namespace lemlib
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "units/units.hpp"
+#include <array>
+#include <cstddef>
+
+namespace lemlib {
+/**
+ * @class SavitzkyGolayDerivative
+ *
+ * @brief Smoothed derivative of the last N samples
+ *
+ * Fits a quadratic to the window by least squares, and returns its slope at the center of the window. This is far less
+ * noisy than the difference of the last two samples, but lags by (N - 1) / 2 samples.
+ *
+ * The slope is a weighted sum of the window, which is updated from the previous sum instead of being calculated again,
+ * so each sample costs the same for any N. The sum is calculated from scratch once per N samples, so rounding errors
+ * can't accumulate.
+ *
+ * @tparam Q the type of the samples
+ * @tparam N the number of samples in the window. Must be odd, and at least 3
+ *
+ * @b Example
+ * @code {.cpp}
+ * // estimate the velocity of an encoder sampled every 10 ms
+ * lemlib::SavitzkyGolayDerivative<Angle, 7> derivative(10_msec);
+ * const AngularVelocity velocity = derivative.update(encoder.getAngle());
+ * @endcode
+ */
+template <isQuantity Q, std::size_t N> class SavitzkyGolayDerivative {
+        static_assert(N % 2 == 1 && N >= 3, "the window of a Savitzky-Golay filter must be odd and at least 3");
+    public:
+        using Rep = typename Q::rep;
+        using Derivative = Divided<Q, units::WithRep<Time, Rep>>;
+
+        /**
+         * @brief Construct a new SavitzkyGolayDerivative
+         *
+         * @param period the time between samples
+         */
+        explicit constexpr SavitzkyGolayDerivative(Time period)
+            : m_scale(Rep(1.0 / (WEIGHT_SQUARES * period.internal()))) {}
+
+        /**
+         * @brief add a sample
+         *
+         * The window is filled with the first sample, so the derivative starts at 0.
+         *
+         * @param sample the newest sample
+         * @return Derivative the derivative at the center of the window
+         */
+        constexpr Derivative update(Q sample) {
+            const Rep value = sample.internal();
+            if (!m_initialized) {
+                m_window.fill(value);
+                m_sum = value * Rep(N);
+                m_weighted = Rep(0);
+                m_initialized = true;
+                return Derivative(Rep(0));
+            }
+            const Rep oldest = m_window[m_next];
+            m_window[m_next] = value;
+            m_next = m_next + 1 == N ? 0 : m_next + 1;
+            if (m_next == 0) {
+                // the window is in order, so the sums can be calculated directly
+                m_sum = Rep(0);
+                m_weighted = Rep(0);
+                for (std::size_t i = 0; i < N; i++) {
+                    m_sum += m_window[i];
+                    m_weighted += m_window[i] * Rep(int(i) - HALF);
+                }
+            } else {
+                // every sample moves down one weight, the oldest sample leaves at weight -HALF, and the new sample
+                // enters at weight HALF
+                m_weighted += (oldest + value) * Rep(HALF) + oldest - m_sum;
+                m_sum += value - oldest;
+            }
+            return Derivative(m_weighted * m_scale);
+        }
+
+        /**
+         * @brief get the last derivative
+         *
+         * @return Derivative
+         */
+        constexpr Derivative getValue() const { return Derivative(m_weighted * m_scale); }
+
+        /**
+         * @brief reset the filter, so the window is filled with the next sample
+         */
+        constexpr void reset() {
+            m_initialized = false;
+            m_next = 0;
+        }
+    private:
+        static constexpr int HALF = (N - 1) / 2;
+        /** sum of the squares of the weights, from -HALF to HALF */
+        static constexpr double WEIGHT_SQUARES = HALF * (HALF + 1) * (2 * HALF + 1) / 3.0;
+
+        Rep m_scale;
+        /** samples, oldest first starting at m_next */
+        std::array<Rep, N> m_window {};
+        std::size_t m_next = 0;
+        /** sum of the window */
+        Rep m_sum = Rep(0);
+        /** sum of the window, weighted from -HALF for the oldest sample to HALF for the newest */
+        Rep m_weighted = Rep(0);
+        bool m_initialized = false;
+};
+} // namespace lemlib
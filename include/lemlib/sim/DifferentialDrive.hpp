@@ -0,0 +1,135 @@
+#pragma once
+
+#include "lemlib/sim/Simulation.hpp"
+#include "units/Transform2D.hpp"
+
+namespace lemlib::sim {
+/**
+ * @brief Parameters of a simulated differential drivetrain
+ *
+ * Each side of the drivetrain is modelled as a DC motor with static friction, using the same feedforward model that is
+ * used to characterize real drivetrains:
+ *
+ * V = kS * sgn(v) + kV * v + kA * a
+ */
+struct DifferentialDriveModel {
+        /** distance between the left and right wheels */
+        Length trackWidth = 12_in;
+        /** diameter of the drive wheels */
+        Length wheelDiameter = 3.25_in;
+        /** voltage needed to overcome static friction */
+        Voltage kS = 0.5_volt;
+        /** voltage needed to sustain a velocity of 1 m/s */
+        Divided<Voltage, LinearVelocity> kV = 6_volt / 1_mps;
+        /** voltage needed to accelerate at 1 m/s^2 */
+        Divided<Voltage, LinearAcceleration> kA = 1.5_volt / 1_mps2;
+        /** maximum voltage that can be applied to a side of the drivetrain */
+        Voltage maxVoltage = 12_volt;
+};
+
+/**
+ * @class DifferentialDrive
+ *
+ * @brief A simulated differential drivetrain
+ *
+ * The drivetrain is controlled by setting the voltage applied to each side. Every physics tick, the velocity of each
+ * side is integrated from the motor model, and the pose of the robot is integrated along an arc.
+ */
+class DifferentialDrive : public Device {
+    public:
+        /**
+         * @brief Construct a new Differential Drive
+         *
+         * @param model the physical parameters of the drivetrain
+         * @param pose the initial pose of the robot
+         *
+         * @b Example:
+         * @code {.cpp}
+         * int main() {
+         *     lemlib::sim::Simulation sim;
+         *     lemlib::sim::DifferentialDrive drive({.trackWidth = 10_in, .wheelDiameter = 2.75_in});
+         *     sim.add(drive);
+         *     // drive forwards at 6 volts for 1 second
+         *     drive.setVoltage(6_volt, 6_volt);
+         *     sim.advance(1_sec);
+         * }
+         * @endcode
+         */
+        DifferentialDrive(DifferentialDriveModel model, units::Pose pose = units::Pose());
+        /**
+         * @brief set the voltage applied to each side of the drivetrain
+         *
+         * The voltage is clamped to the maximum voltage of the model.
+         *
+         * @param left the voltage applied to the left side
+         * @param right the voltage applied to the right side
+         */
+        void setVoltage(Voltage left, Voltage right);
+        /**
+         * @brief advance the drivetrain by one physics tick
+         *
+         * @param dt the length of the physics tick
+         */
+        void update(Time dt) override;
+        /**
+         * @brief Get the pose of the robot
+         *
+         * @return units::Pose the pose of the robot, in standard orientation
+         */
+        units::Pose getPose() const;
+        /**
+         * @brief Set the pose of the robot
+         *
+         * @param pose the new pose of the robot
+         */
+        void setPose(units::Pose pose);
+        /**
+         * @brief Get the linear velocity of the left side of the drivetrain
+         *
+         * @return LinearVelocity the velocity of the left side
+         */
+        LinearVelocity getLeftVelocity() const;
+        /**
+         * @brief Get the linear velocity of the right side of the drivetrain
+         *
+         * @return LinearVelocity the velocity of the right side
+         */
+        LinearVelocity getRightVelocity() const;
+        /**
+         * @brief Get the angle the left wheels have rotated since the simulation started
+         *
+         * @return Angle the angle of the left wheels
+         */
+        Angle getLeftAngle() const;
+        /**
+         * @brief Get the angle the right wheels have rotated since the simulation started
+         *
+         * @return Angle the angle of the right wheels
+         */
+        Angle getRightAngle() const;
+        /**
+         * @brief Get the unbounded heading of the robot
+         *
+         * @return Angle the heading of the robot, in standard orientation
+         */
+        Angle getHeading() const;
+    private:
+        /**
+         * @brief integrate the velocity of one side of the drivetrain
+         *
+         * @param velocity the current velocity of the side
+         * @param voltage the voltage applied to the side
+         * @param dt the length of the physics tick
+         * @return LinearVelocity the velocity at the end of the tick
+         */
+        LinearVelocity integrateSide(LinearVelocity velocity, Voltage voltage, Time dt) const;
+        const DifferentialDriveModel m_model;
+        Voltage m_leftVoltage = 0_volt;
+        Voltage m_rightVoltage = 0_volt;
+        LinearVelocity m_leftVelocity = 0_mps;
+        LinearVelocity m_rightVelocity = 0_mps;
+        Length m_leftDistance = 0_m;
+        Length m_rightDistance = 0_m;
+        units::Transform2D m_pose;
+};
+} // namespace lemlib::sim
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "hardware/encoder/Encoder.hpp"
+#include <functional>
+
+namespace lemlib::sim {
+/**
+ * @brief Encoder implementation backed by a simulated value
+ *
+ * The angle measured by the encoder is read from a function, which usually reads the state of a simulated device.
+ */
+class SimEncoder : public Encoder {
+    public:
+        /**
+         * @brief Construct a new Simulated Encoder
+         *
+         * @param source function which returns the true angle of the simulated shaft
+         * @param reversed whether the encoder is reversed or not
+         *
+         * @b Example:
+         * @code {.cpp}
+         * int main() {
+         *     lemlib::sim::DifferentialDrive drive({});
+         *     // encoder measuring the left side of the drivetrain
+         *     lemlib::sim::SimEncoder encoder([&] { return drive.getLeftAngle(); });
+         * }
+         * @endcode
+         */
+        SimEncoder(std::function<Angle()> source, bool reversed = false);
+        /**
+         * @brief whether the encoder is connected
+         *
+         * @return 0 if its not connected
+         * @return 1 if it is connected
+         */
+        int isConnected() override;
+        /**
+         * @brief Get the relative angle measured by the encoder
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: the encoder has been disconnected with setConnected(false)
+         *
+         * @return Angle the relative angle measured by the encoder
+         * @return INFINITY if there is an error, setting errno
+         */
+        Angle getAngle() override;
+        /**
+         * @brief Set the relative angle of the encoder
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: the encoder has been disconnected with setConnected(false)
+         *
+         * @param angle the relative angle to set the measured angle to
+         * @return 0 on success
+         * @return INT_MAX on failure, setting errno
+         */
+        int setAngle(Angle angle) override;
+        /**
+         * @brief simulate the encoder being unplugged or plugged back in
+         *
+         * @param connected whether the encoder should be connected
+         *
+         * @b Example:
+         * @code {.cpp}
+         * int main() {
+         *     lemlib::sim::DifferentialDrive drive({});
+         *     lemlib::sim::SimEncoder encoder([&] { return drive.getLeftAngle(); });
+         *     // simulate the encoder being unplugged
+         *     encoder.setConnected(false);
+         *     encoder.isConnected(); // returns 0
+         * }
+         * @endcode
+         */
+        void setConnected(bool connected);
+    private:
+        std::function<Angle()> m_source;
+        Angle m_offset = 0_stDeg;
+        bool m_reversed;
+        bool m_connected = true;
+};
+} // namespace lemlib::sim
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "hardware/IMU/Imu.hpp"
+#include "lemlib/sim/Simulation.hpp"
+#include <functional>
+
+namespace lemlib::sim {
+/**
+ * @brief Imu implementation backed by a simulated heading
+ *
+ * Calibration takes a fixed amount of simulated time, and the sensor can be given a constant drift rate to test how
+ * motion algorithms handle an imperfect sensor. Since it needs to track time, the sensor has to be added to the
+ * Simulation it belongs to.
+ */
+class SimImu : public Imu, public Device {
+    public:
+        /**
+         * @brief Construct a new Simulated Inertial Sensor
+         *
+         * @param source function which returns the true heading of the robot
+         * @param calibrationTime how long it takes the sensor to calibrate
+         * @param drift how fast the measured heading drifts away from the true heading
+         *
+         * @b Example:
+         * @code {.cpp}
+         * int main() {
+         *     lemlib::sim::Simulation sim;
+         *     lemlib::sim::DifferentialDrive drive({});
+         *     lemlib::sim::SimImu imu([&] { return drive.getHeading(); });
+         *     sim.add(drive);
+         *     sim.add(imu);
+         * }
+         * @endcode
+         */
+        SimImu(std::function<Angle()> source, Time calibrationTime = 2_sec, AngularVelocity drift = 0_radps);
+        /**
+         * @brief start calibrating the simulated inertial sensor
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * EAGAIN: The sensor is already calibrating
+         *
+         * @return 0 on success
+         * @return INT_MAX if an error occurred, setting errno
+         */
+        int calibrate() override;
+        /**
+         * @brief check if the simulated inertial sensor is calibrated
+         *
+         * @return true the IMU is calibrated
+         * @return false the IMU is not calibrated
+         */
+        int isCalibrated() override;
+        /**
+         * @brief check if the simulated inertial sensor is calibrating
+         *
+         * @return true the IMU is calibrating
+         * @return false the IMU is not calibrating
+         */
+        int isCalibrating() override;
+        /**
+         * @brief whether the simulated inertial sensor is connected
+         *
+         * @return true the IMU is connected
+         * @return false the IMU is not connected
+         */
+        int isConnected() override;
+        /**
+         * @brief Get the rotation of the simulated inertial sensor
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: The sensor has been disconnected with setConnected(false)
+         * EAGAIN: The sensor is still calibrating
+         *
+         * @return Angle the rotation of the IMU
+         * @return INFINITY error occurred, setting errno
+         */
+        Angle getRotation() override;
+        /**
+         * @brief Set the rotation of the simulated inertial sensor
+         *
+         * This function uses the following values of errno when an error state is reached:
+         *
+         * ENODEV: The sensor has been disconnected with setConnected(false)
+         * EAGAIN: The sensor is still calibrating
+         *
+         * @param rotation the rotation to set the measured rotation to
+         * @return int 0 success
+         * @return INT_MAX error occurred, setting errno
+         */
+        int setRotation(Angle rotation) override;
+        /**
+         * @brief advance calibration and drift by one physics tick
+         *
+         * @param dt the length of the physics tick
+         */
+        void update(Time dt) override;
+        /**
+         * @brief simulate the inertial sensor being unplugged or plugged back in
+         *
+         * @param connected whether the sensor should be connected
+         */
+        void setConnected(bool connected);
+    private:
+        std::function<Angle()> m_source;
+        const Time m_calibrationTime;
+        const AngularVelocity m_drift;
+        Time m_calibrationRemaining = 0_sec;
+        Angle m_offset = 0_stDeg;
+        bool m_calibrated = false;
+        bool m_connected = true;
+};
+} // namespace lemlib::sim
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "units/units.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace lemlib::sim {
+/**
+ * @class Device
+ *
+ * @brief abstract class for simulated devices
+ *
+ * A simulated device is anything that has state which changes over time, like a drivetrain or an inertial sensor that
+ * is calibrating. Devices are registered with a Simulation, which updates them once every physics tick.
+ */
+class Device {
+    public:
+        /**
+         * @brief advance the state of the device by one physics tick
+         *
+         * @param dt the length of the physics tick
+         */
+        virtual void update(Time dt) = 0;
+        virtual ~Device() = default;
+};
+
+/**
+ * @class Simulation
+ *
+ * @brief A deterministic, fixed-step simulation of the robot
+ *
+ * The simulation does not depend on wall-clock time. Every call to step() advances simulated time by exactly one
+ * physics tick, so the same inputs always produce the same outputs, and motion code can be run much faster than real
+ * time on a host machine.
+ */
+class Simulation {
+    public:
+        /**
+         * @brief Construct a new Simulation
+         *
+         * @param period the length of a single physics tick
+         *
+         * @b Example:
+         * @code {.cpp}
+         * int main() {
+         *     // simulation with a 1 ms physics tick
+         *     lemlib::sim::Simulation sim(1_msec);
+         * }
+         * @endcode
+         */
+        Simulation(Time period = 1_msec);
+        /**
+         * @brief register a device with the simulation
+         *
+         * Devices are updated in the order they were added. The simulation does not take ownership of the device, so
+         * it must outlive the simulation.
+         *
+         * @param device the device to add
+         *
+         * @b Example:
+         * @code {.cpp}
+         * int main() {
+         *     lemlib::sim::Simulation sim;
+         *     lemlib::sim::DifferentialDrive drive({});
+         *     sim.add(drive);
+         * }
+         * @endcode
+         */
+        void add(Device& device);
+        /**
+         * @brief advance the simulation by a single physics tick
+         */
+        void step();
+        /**
+         * @brief advance the simulation by a given amount of time
+         *
+         * The duration is rounded up to a whole number of physics ticks.
+         *
+         * @param duration how long to advance the simulation by
+         *
+         * @b Example:
+         * @code {.cpp}
+         * int main() {
+         *     lemlib::sim::Simulation sim(1_msec);
+         *     // run 10 physics ticks
+         *     sim.advance(10_msec);
+         * }
+         * @endcode
+         */
+        void advance(Time duration);
+        /**
+         * @brief Get the amount of time that has been simulated
+         *
+         * @return Time the simulated time
+         */
+        Time getTime() const;
+        /**
+         * @brief Get the number of physics ticks that have been simulated
+         *
+         * @return std::uint64_t the number of ticks
+         */
+        std::uint64_t getTicks() const;
+        /**
+         * @brief Get the length of a physics tick
+         *
+         * @return Time the length of a physics tick
+         */
+        Time getPeriod() const;
+    private:
+        const Time m_period;
+        std::uint64_t m_ticks = 0;
+        std::vector<Device*> m_devices;
+};
+} // namespace lemlib::sim
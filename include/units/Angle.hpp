@@ -1,6 +1,7 @@
 #pragma once
 
 #include "units/units.hpp"
+#include "units/FastTrig.hpp"
 
 class Angle : public Quantity<std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<1>, std::ratio<0>,
                               std::ratio<0>, std::ratio<0>> {
@@ -14,6 +15,12 @@ class Angle : public Quantity<std::ratio<0>, std::ratio<0>, std::ratio<0>, std::
                             value)
             : Quantity<std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<1>, std::ratio<0>,
                        std::ratio<0>, std::ratio<0>>(value) {};
+
+        explicit constexpr Angle(Quantity<std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<1>,
+                                          std::ratio<0>, std::ratio<0>, std::ratio<0>, float>
+                                     value)
+            : Quantity<std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<1>, std::ratio<0>,
+                       std::ratio<0>, std::ratio<0>>(value) {};
 };
 
 template <> struct LookupName<Quantity<std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<1>,
@@ -21,8 +28,44 @@ template <> struct LookupName<Quantity<std::ratio<0>, std::ratio<0>, std::ratio<
         using Named = Angle;
 };
 
+template <> struct DimensionSuffix<Quantity<std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<1>,
+                                           std::ratio<0>, std::ratio<0>, std::ratio<0>>> {
+        static constexpr units::FixedString value = " rad";
+};
+
 inline std::ostream& operator<<(std::ostream& os, const Angle& quantity) {
-    os << quantity.internal() << " rad";
+    os << quantity.internal() << UnitSuffix<Angle>::value.c_str();
+    return os;
+}
+
+// Angle stored as a float
+class AngleF : public Quantity<std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<1>,
+                               std::ratio<0>, std::ratio<0>, std::ratio<0>, float> {
+    public:
+        explicit constexpr AngleF(float value)
+            : Quantity<std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<1>, std::ratio<0>,
+                       std::ratio<0>, std::ratio<0>, float>(value) {}
+
+        constexpr AngleF(Quantity<std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<1>,
+                                  std::ratio<0>, std::ratio<0>, std::ratio<0>, float>
+                             value)
+            : Quantity<std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<1>, std::ratio<0>,
+                       std::ratio<0>, std::ratio<0>, float>(value) {};
+
+        explicit constexpr AngleF(Quantity<std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<1>,
+                                           std::ratio<0>, std::ratio<0>, std::ratio<0>>
+                                      value)
+            : Quantity<std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<1>, std::ratio<0>,
+                       std::ratio<0>, std::ratio<0>, float>(value) {};
+};
+
+template <> struct LookupName<Quantity<std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<1>,
+                                       std::ratio<0>, std::ratio<0>, std::ratio<0>, float>> {
+        using Named = AngleF;
+};
+
+inline std::ostream& operator<<(std::ostream& os, const AngleF& quantity) {
+    os << quantity.internal() << UnitSuffix<AngleF>::value.c_str();
     return os;
 }
 
@@ -71,30 +114,124 @@ constexpr Angle operator""_cRot(long double value) { return 90_stDeg - static_ca
 
 constexpr Angle operator""_cRot(unsigned long long value) { return 90_stDeg - static_cast<double>(value) * rot; }
 
+// Float angle declaration operators. Calculated as a double, then rounded
+constexpr AngleF operator""_stRad_f(long double value) { return AngleF(static_cast<float>(value)); }
+
+constexpr AngleF operator""_stRad_f(unsigned long long value) { return AngleF(static_cast<float>(value)); }
+
+constexpr AngleF operator""_stDeg_f(long double value) { return AngleF(static_cast<double>(value) * deg); }
+
+constexpr AngleF operator""_stDeg_f(unsigned long long value) { return AngleF(static_cast<double>(value) * deg); }
+
+constexpr AngleF operator""_stRot_f(long double value) { return AngleF(static_cast<double>(value) * rot); }
+
+constexpr AngleF operator""_stRot_f(unsigned long long value) { return AngleF(static_cast<double>(value) * rot); }
+
+constexpr AngleF operator""_cRad_f(long double value) { return AngleF(90_stDeg - Angle(static_cast<double>(value))); }
+
+constexpr AngleF operator""_cRad_f(unsigned long long value) {
+    return AngleF(90_stDeg - Angle(static_cast<double>(value)));
+}
+
+constexpr AngleF operator""_cDeg_f(long double value) { return AngleF(90_stDeg - static_cast<double>(value) * deg); }
+
+constexpr AngleF operator""_cDeg_f(unsigned long long value) {
+    return AngleF(90_stDeg - static_cast<double>(value) * deg);
+}
+
+constexpr AngleF operator""_cRot_f(long double value) { return AngleF(90_stDeg - static_cast<double>(value) * rot); }
+
+constexpr AngleF operator""_cRot_f(unsigned long long value) {
+    return AngleF(90_stDeg - static_cast<double>(value) * rot);
+}
+
 // Angle functions
 namespace units {
-constexpr Number sin(const Angle& rhs) { return Number(std::sin(rhs.internal())); }
+// the implementation used by sin, cos, tan and atan2. Defining UNITS_FAST_TRIG selects the approximations in
+// units/FastTrig.hpp instead of libm
+#ifdef UNITS_FAST_TRIG
+namespace trig = units::fast;
+#else
+namespace trig = std;
+#endif
+
+constexpr Number sin(const Angle& rhs) { return Number(trig::sin(rhs.internal())); }
+
+constexpr Number cos(const Angle& rhs) { return Number(trig::cos(rhs.internal())); }
+
+constexpr Number tan(const Angle& rhs) { return Number(trig::tan(rhs.internal())); }
+
+constexpr NumberF sin(const AngleF& rhs) { return NumberF(trig::sin(rhs.internal())); }
 
-constexpr Number cos(const Angle& rhs) { return Number(std::cos(rhs.internal())); }
+constexpr NumberF cos(const AngleF& rhs) { return NumberF(trig::cos(rhs.internal())); }
 
-constexpr Number tan(const Angle& rhs) { return Number(std::tan(rhs.internal())); }
+constexpr NumberF tan(const AngleF& rhs) { return NumberF(trig::tan(rhs.internal())); }
 
-template <isQuantity Q> constexpr Angle asin(const Q& rhs) { return Angle(std::asin(rhs.internal())); }
+// angle stored as the same type as a quantity
+template <isQuantity Q> using AngleOf = Named<Quantity<std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<0>,
+                                                       std::ratio<1>, std::ratio<0>, std::ratio<0>, std::ratio<0>,
+                                                       typename Q::rep>>;
 
-template <isQuantity Q> constexpr Angle acos(const Q& rhs) { return Angle(std::acos(rhs.internal())); }
+template <isQuantity Q> constexpr AngleOf<Q> asin(const Q& rhs) { return AngleOf<Q>(std::asin(rhs.internal())); }
 
-template <isQuantity Q> constexpr Angle atan(const Q& rhs) { return Angle(std::atan(rhs.internal())); }
+template <isQuantity Q> constexpr AngleOf<Q> acos(const Q& rhs) { return AngleOf<Q>(std::acos(rhs.internal())); }
 
-template <isQuantity Q> constexpr Angle atan2(const Q& lhs, const Q& rhs) {
-    return Angle(std::atan2(lhs.internal(), rhs.internal()));
+template <isQuantity Q> constexpr AngleOf<Q> atan(const Q& rhs) { return AngleOf<Q>(std::atan(rhs.internal())); }
+
+template <isQuantity Q> constexpr AngleOf<Q> atan2(const Q& lhs, const Q& rhs) {
+    return AngleOf<Q>(trig::atan2(lhs.internal(), rhs.internal()));
 }
 
+#ifdef UNITS_FAST_TRIG
+static inline Angle constrainAngle360(Angle in) { return Angle(fast::wrap360(in.internal())); }
+
+static inline Angle constrainAngle180(Angle in) { return Angle(fast::wrap180(in.internal())); }
+
+static inline AngleF constrainAngle360(AngleF in) { return AngleF(fast::wrap360(in.internal())); }
+
+static inline AngleF constrainAngle180(AngleF in) { return AngleF(fast::wrap180(in.internal())); }
+#else
 static inline Angle constrainAngle360(Angle in) { return mod(in, rot); }
 
 static inline Angle constrainAngle180(Angle in) {
     in = mod(in + 180 * deg, rot);
     return in < Angle(0) ? in + 180 * deg : in - 180 * deg;
 }
+
+static inline AngleF constrainAngle360(AngleF in) { return mod(in, AngleF(rot)); }
+
+static inline AngleF constrainAngle180(AngleF in) {
+    in = mod(in + AngleF(180 * deg), AngleF(rot));
+    return in < AngleF(0) ? in + AngleF(180 * deg) : in - AngleF(180 * deg);
+}
+#endif
+
+// Approximate angle functions, which can be chosen per call site. See units/FastTrig.hpp for their accuracy
+namespace fast {
+constexpr Number sin(const Angle& rhs) { return Number(fast::sin(rhs.internal())); }
+
+constexpr Number cos(const Angle& rhs) { return Number(fast::cos(rhs.internal())); }
+
+constexpr Number tan(const Angle& rhs) { return Number(fast::tan(rhs.internal())); }
+
+constexpr NumberF sin(const AngleF& rhs) { return NumberF(fast::sin(rhs.internal())); }
+
+constexpr NumberF cos(const AngleF& rhs) { return NumberF(fast::cos(rhs.internal())); }
+
+constexpr NumberF tan(const AngleF& rhs) { return NumberF(fast::tan(rhs.internal())); }
+
+template <isQuantity Q> constexpr AngleOf<Q> atan2(const Q& lhs, const Q& rhs) {
+    return AngleOf<Q>(fast::atan2(lhs.internal(), rhs.internal()));
+}
+
+constexpr Angle constrainAngle360(Angle in) { return Angle(wrap360(in.internal())); }
+
+constexpr Angle constrainAngle180(Angle in) { return Angle(wrap180(in.internal())); }
+
+constexpr AngleF constrainAngle360(AngleF in) { return AngleF(wrap360(in.internal())); }
+
+constexpr AngleF constrainAngle180(AngleF in) { return AngleF(wrap180(in.internal())); }
+} // namespace fast
 } // namespace units
 
 // Angle to/from operators
@@ -122,4 +259,11 @@ constexpr inline double to_cDeg(Angle quantity) { return (90 * deg - quantity).c
 
 constexpr inline Angle from_cRot(double value) { return (90 - value) * deg; }
 
-constexpr inline double to_cRot(Angle quantity) { return (90 * deg - quantity).convert(rot); }
\ No newline at end of file
+constexpr inline double to_cRot(Angle quantity) { return (90 * deg - quantity).convert(rot); }
+
+// Float angle to operators
+constexpr inline float to_stRad(AngleF quantity) { return quantity.internal(); }
+
+constexpr inline float to_stDeg(AngleF quantity) { return quantity.convert(AngleF(deg)); }
+
+constexpr inline float to_stRot(AngleF quantity) { return quantity.convert(AngleF(rot)); }
@@ -0,0 +1,218 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * Fast approximations of the trigonometric functions and angle wrapping, as an alternative to libm.
+ *
+ * Arguments are reduced to a small range with a multiplication instead of fmod, then evaluated with a polynomial, so
+ * none of these functions call into libm or branch on their input. Maximum absolute errors, for angles within 1000
+ * rotations of 0:
+ *
+ * | function        | double | float  |
+ * |-----------------|--------|--------|
+ * | sin, cos        | 1e-11  | 5e-7   |
+ * | atan2           | 1e-11  | 5e-7   |
+ * | wrap180, wrap360| 1e-12  | 1e-6   |
+ *
+ * tan is sin / cos, so it has the same relative error near its poles. Signed zeros and NaN are not handled the same as
+ * libm.
+ *
+ * The bench/trig benchmark measures the accuracy and throughput of each function against libm. Use these per call
+ * site with units::fast::sin, or define UNITS_FAST_TRIG to make units::sin, units::cos, units::tan, units::atan2 and
+ * the constrainAngle functions use them everywhere.
+ */
+namespace units::fast {
+namespace detail {
+template <typename T> struct Constants;
+
+template <> struct Constants<double> {
+        // pi / 2 split into parts, so k * PIO2_HI is exact for the values of k used in range reduction
+        static constexpr double PIO2_HI = 1.57079632673412561417e+00;
+        static constexpr double PIO2_LO = 6.07710050650619224932e-11;
+        static constexpr double TWO_OVER_PI = 6.36619772367581382433e-01;
+        // 2 pi split into parts
+        static constexpr double TWOPI_HI = 6.28318530693650245668e+00;
+        static constexpr double TWOPI_LO = 2.43084020260247689973e-10;
+        static constexpr double INV_TWOPI = 1.59154943091895345608e-01;
+        // adding and subtracting this rounds a number to the nearest integer
+        static constexpr double ROUND = 6755399441055744.0;
+};
+
+template <> struct Constants<float> {
+        static constexpr float PIO2_HI = 1.5703125f;
+        static constexpr float PIO2_LO = 4.837512969970703125e-4f;
+        static constexpr float PIO2_LO2 = 7.54978995489188216e-8f;
+        static constexpr float TWO_OVER_PI = 6.36619772367581382433e-01f;
+        static constexpr float TWOPI_HI = 6.28125f;
+        static constexpr float TWOPI_LO = 1.93530717958647692528e-3f;
+        static constexpr float INV_TWOPI = 1.59154943091895345608e-01f;
+        static constexpr float ROUND = 12582912.0f;
+};
+
+/**
+ * @brief round to the nearest integer, with ties to even, without a function call or branch
+ */
+template <typename T> constexpr T roundNearest(T x) { return (x + Constants<T>::ROUND) - Constants<T>::ROUND; }
+
+/**
+ * @brief Taylor series of sin on [-pi / 4, pi / 4]
+ */
+template <typename T> constexpr T sinPolynomial(T r) {
+    const T r2 = r * r;
+    if constexpr (std::is_same_v<T, float>) {
+        return r + r * r2 * (T(-1.0 / 6) + r2 * (T(1.0 / 120) + r2 * (T(-1.0 / 5040) + r2 * T(1.0 / 362880))));
+    } else {
+        return r + r * r2 *
+                       (T(-1.0 / 6) +
+                        r2 * (T(1.0 / 120) +
+                              r2 * (T(-1.0 / 5040) + r2 * (T(1.0 / 362880) + r2 * T(-1.0 / 39916800)))));
+    }
+}
+
+/**
+ * @brief Taylor series of cos on [-pi / 4, pi / 4]
+ */
+template <typename T> constexpr T cosPolynomial(T r) {
+    const T r2 = r * r;
+    if constexpr (std::is_same_v<T, float>) {
+        return T(1) + r2 * (T(-1.0 / 2) + r2 * (T(1.0 / 24) + r2 * (T(-1.0 / 720) + r2 * T(1.0 / 40320))));
+    } else {
+        return T(1) +
+               r2 * (T(-1.0 / 2) +
+                     r2 * (T(1.0 / 24) +
+                           r2 * (T(-1.0 / 720) +
+                                 r2 * (T(1.0 / 40320) + r2 * (T(-1.0 / 3628800) + r2 * T(1.0 / 479001600))))));
+    }
+}
+
+/**
+ * @brief Taylor series of atan on [-tan(pi / 12), tan(pi / 12)]
+ */
+template <typename T> constexpr T atanPolynomial(T t) {
+    const T t2 = t * t;
+    if constexpr (std::is_same_v<T, float>) {
+        return t + t * t2 * (T(-1.0 / 3) + t2 * (T(1.0 / 5) + t2 * (T(-1.0 / 7) + t2 * T(1.0 / 9))));
+    } else {
+        return t + t * t2 *
+                       (T(-1.0 / 3) +
+                        t2 * (T(1.0 / 5) +
+                              t2 * (T(-1.0 / 7) +
+                                    t2 * (T(1.0 / 9) +
+                                          t2 * (T(-1.0 / 11) +
+                                                t2 * (T(1.0 / 13) + t2 * (T(-1.0 / 15) + t2 * T(1.0 / 17))))))));
+    }
+}
+
+/**
+ * @brief sine and cosine of an angle in radians
+ *
+ * The angle is reduced to r + k * pi / 2, where |r| <= pi / 4, and the quadrant k selects which polynomial is used for
+ * each result and its sign.
+ */
+template <typename T> struct SinCos {
+        T sin;
+        T cos;
+};
+
+template <typename T> constexpr SinCos<T> sinCos(T x) {
+    using C = Constants<T>;
+    const T k = roundNearest(x * C::TWO_OVER_PI);
+    T r = (x - k * C::PIO2_HI) - k * C::PIO2_LO;
+    // float needs a third part, since its first part has fewer spare bits
+    if constexpr (std::is_same_v<T, float>) r -= k * C::PIO2_LO2;
+    const T s = sinPolynomial(r);
+    const T c = cosPolynomial(r);
+    const int64_t quadrant = static_cast<int64_t>(k);
+    // odd quadrants swap sin and cos. sin is negative in quadrants 2 and 3, cos in quadrants 1 and 2
+    const T sinResult = (quadrant & 1) ? c : s;
+    const T cosResult = (quadrant & 1) ? s : c;
+    return {(quadrant & 2) ? -sinResult : sinResult, ((quadrant + 1) & 2) ? -cosResult : cosResult};
+}
+} // namespace detail
+
+/**
+ * @brief approximate sine of an angle in radians
+ */
+template <typename T>
+    requires std::is_floating_point_v<T>
+constexpr T sin(T x) {
+    return detail::sinCos(x).sin;
+}
+
+/**
+ * @brief approximate cosine of an angle in radians
+ */
+template <typename T>
+    requires std::is_floating_point_v<T>
+constexpr T cos(T x) {
+    return detail::sinCos(x).cos;
+}
+
+/**
+ * @brief approximate tangent of an angle in radians
+ */
+template <typename T>
+    requires std::is_floating_point_v<T>
+constexpr T tan(T x) {
+    const detail::SinCos<T> result = detail::sinCos(x);
+    return result.sin / result.cos;
+}
+
+/**
+ * @brief approximate angle of the point (x, y) from the positive x axis, in radians
+ *
+ * The ratio of the smaller and larger of |y| and |x| is in [0, 1]. Above tan(pi / 12) it is reduced further with
+ * atan(a) = pi / 6 + atan((a * sqrt(3) - 1) / (a + sqrt(3))), which only changes the numerator and denominator of the
+ * single division.
+ *
+ * @return T the angle, in [-pi, pi]. atan2(0, 0) is 0
+ */
+template <typename T>
+    requires std::is_floating_point_v<T>
+constexpr T atan2(T y, T x) {
+    constexpr T SQRT3 = T(1.73205080756887729353);
+    constexpr T TAN_PI_12 = T(0.267949192431122706473);
+    constexpr T PI = T(3.14159265358979323846);
+    const T ax = x < 0 ? -x : x;
+    const T ay = y < 0 ? -y : y;
+    const T hi = ax > ay ? ax : ay;
+    const T lo = ax > ay ? ay : ax;
+    const bool reduce = lo > hi * TAN_PI_12;
+    const T numerator = reduce ? lo * SQRT3 - hi : lo;
+    const T denominator = reduce ? lo + hi * SQRT3 : hi;
+    const T t = denominator == 0 ? T(0) : numerator / denominator;
+    T angle = detail::atanPolynomial(t) + (reduce ? PI / 6 : T(0));
+    angle = ay > ax ? PI / 2 - angle : angle;
+    angle = x < 0 ? PI - angle : angle;
+    return y < 0 ? -angle : angle;
+}
+
+/**
+ * @brief wrap an angle in radians to [-pi, pi]
+ */
+template <typename T>
+    requires std::is_floating_point_v<T>
+constexpr T wrap180(T x) {
+    using C = detail::Constants<T>;
+    constexpr T PI = T(3.14159265358979323846);
+    const T k = detail::roundNearest(x * C::INV_TWOPI);
+    const T wrapped = (x - k * C::TWOPI_HI) - k * C::TWOPI_LO;
+    // x * INV_TWOPI is rounded, so k can be off by one when x is close to an odd multiple of pi
+    return wrapped > PI    ? (wrapped - C::TWOPI_HI) - C::TWOPI_LO
+           : wrapped < -PI ? (wrapped + C::TWOPI_HI) + C::TWOPI_LO
+                           : wrapped;
+}
+
+/**
+ * @brief wrap an angle in radians to [0, 2 pi]
+ */
+template <typename T>
+    requires std::is_floating_point_v<T>
+constexpr T wrap360(T x) {
+    using C = detail::Constants<T>;
+    const T wrapped = wrap180(x);
+    return wrapped < 0 ? (wrapped + C::TWOPI_HI) + C::TWOPI_LO : wrapped;
+}
+} // namespace units::fast
@@ -0,0 +1,365 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace units {
+namespace detail {
+/**
+ * @brief unsigned 128 bit integer, built from 64 bit halves
+ *
+ * GCC doesn't support __int128 on 32 bit ARM, so Q32.32 multiplication and division are done with this instead. Only
+ * the operations the fixed point math needs are implemented.
+ */
+struct Wide {
+        uint64_t hi;
+        uint64_t lo;
+};
+
+/**
+ * @brief multiply two 64 bit integers into a 128 bit result
+ */
+constexpr Wide wideMultiply(uint64_t a, uint64_t b) {
+    const uint64_t aLo = a & 0xFFFFFFFF, aHi = a >> 32;
+    const uint64_t bLo = b & 0xFFFFFFFF, bHi = b >> 32;
+    const uint64_t lolo = aLo * bLo;
+    const uint64_t hilo = aHi * bLo;
+    const uint64_t lohi = aLo * bHi;
+    const uint64_t hihi = aHi * bHi;
+    // sum of the middle terms and the carry out of the low word, which can't overflow 64 bits
+    const uint64_t middle = (lolo >> 32) + (hilo & 0xFFFFFFFF) + (lohi & 0xFFFFFFFF);
+    return {hihi + (hilo >> 32) + (lohi >> 32) + (middle >> 32), (middle << 32) | (lolo & 0xFFFFFFFF)};
+}
+
+/**
+ * @brief add a 64 bit integer to a 128 bit integer
+ */
+constexpr Wide wideAdd(Wide a, uint64_t b) {
+    const uint64_t lo = a.lo + b;
+    return {a.hi + (lo < a.lo), lo};
+}
+
+/**
+ * @brief shift a 128 bit integer right by less than 64 bits
+ */
+constexpr Wide wideShiftRight(Wide a, int shift) {
+    if (shift == 0) return a;
+    return {a.hi >> shift, (a.lo >> shift) | (a.hi << (64 - shift))};
+}
+
+/**
+ * @brief divide a 128 bit integer by a 64 bit integer
+ *
+ * Uses restoring division, one bit at a time. Only the low 64 bits of the quotient are returned, so the caller has to
+ * check the quotient fits.
+ *
+ * @return the quotient and the remainder
+ */
+constexpr Wide wideDivide(Wide a, uint64_t b) {
+    uint64_t quotient = 0;
+    uint64_t remainder = 0;
+    for (int i = 127; i >= 0; i--) {
+        const bool carry = remainder >> 63;
+        const uint64_t bit = i >= 64 ? (a.hi >> (i - 64)) & 1 : (a.lo >> i) & 1;
+        remainder = (remainder << 1) | bit;
+        quotient <<= 1;
+        if (carry || remainder >= b) {
+            remainder -= b;
+            quotient |= 1;
+        }
+    }
+    return {quotient, remainder};
+}
+} // namespace detail
+
+/**
+ * @brief Fixed point number
+ *
+ * Stores a number as an integer scaled by 2^Frac. All arithmetic between fixed point numbers is done with integer
+ * instructions, so results are exactly the same on the V5 brain and the host, no matter how the compiler orders or
+ * fuses floating point operations. Unlike floating point, adding a small number to a large one is never lost to
+ * rounding, which makes fixed point suited to accumulators like PID integrals and encoder sums.
+ *
+ * Every operation saturates instead of overflowing: a result out of range is clamped to the largest or smallest value
+ * that can be stored. Multiplication and division round to the nearest representable value, with ties rounded away
+ * from zero.
+ *
+ * Fixed can be used as the storage type of a Quantity, like float or double. Only conversions to and from floating
+ * point numbers use floating point math.
+ *
+ * @tparam Int the signed integer type the number is stored as
+ * @tparam Frac how many bits of the integer are after the binary point
+ *
+ * @b Example
+ * @code {.cpp}
+ * using FixedLength = units::WithRep<Length, units::Q16_16>;
+ * FixedLength integral(0_m);
+ * integral += FixedLength(1.5_in);
+ * Length total = unit_cast<Length>(integral);
+ * @endcode
+ */
+template <typename Int, int Frac> class Fixed {
+        static_assert(std::is_same_v<Int, int32_t> || std::is_same_v<Int, int64_t>,
+                      "Fixed point numbers must be stored as an int32_t or int64_t");
+        static_assert(Frac > 0 && Frac < std::numeric_limits<Int>::digits,
+                      "Fixed point numbers must have integer and fractional bits");
+    public:
+        using Raw = Int; /** integer storage type */
+        static constexpr int FRACTIONAL_BITS = Frac;
+        static constexpr Int ONE = Int(1) << Frac;
+
+        /**
+         * @brief construct a new Fixed point number equal to 0
+         */
+        constexpr Fixed() = default;
+
+        /**
+         * @brief construct a new Fixed point number from an integer
+         *
+         * @param value the value, saturated if out of range
+         */
+        template <typename T>
+            requires std::is_integral_v<T>
+        constexpr Fixed(T value)
+            : m_raw(std::cmp_greater(value, MAX_INT) ? MAX_RAW
+                    : std::cmp_less(value, MIN_INT)  ? MIN_RAW
+                                                     : Int(value) * ONE) {}
+
+        /**
+         * @brief construct a new Fixed point number from a floating point number
+         *
+         * Explicit, since it rounds and uses floating point math, so a double can't silently turn a fixed point
+         * calculation into a floating point one.
+         *
+         * @param value the value, rounded to the nearest representable value and saturated if out of range. NaN is
+         * converted to 0
+         */
+        template <typename T>
+            requires std::is_floating_point_v<T>
+        explicit constexpr Fixed(T value)
+            : m_raw(fromScaled(static_cast<double>(value) * ONE)) {}
+
+        /**
+         * @brief construct a new Fixed point number from its raw integer representation
+         *
+         * @param raw the integer, which is the value times 2^Frac
+         * @return Fixed
+         */
+        static constexpr Fixed fromRaw(Int raw) {
+            Fixed result;
+            result.m_raw = raw;
+            return result;
+        }
+
+        /**
+         * @brief the largest value that can be stored
+         */
+        static constexpr Fixed max() { return fromRaw(MAX_RAW); }
+
+        /**
+         * @brief the smallest value that can be stored
+         */
+        static constexpr Fixed lowest() { return fromRaw(MIN_RAW); }
+
+        /**
+         * @brief the smallest positive value that can be stored
+         */
+        static constexpr Fixed epsilon() { return fromRaw(1); }
+
+        /**
+         * @brief get the raw integer representation, which is the value times 2^Frac
+         */
+        constexpr Int raw() const { return m_raw; }
+
+        /**
+         * @brief convert to a floating point number
+         */
+        template <typename T>
+            requires std::is_floating_point_v<T>
+        explicit constexpr operator T() const {
+            return static_cast<T>(static_cast<double>(m_raw) / ONE);
+        }
+
+        /**
+         * @brief convert to an integer, rounding towards negative infinity
+         */
+        template <typename T>
+            requires std::is_integral_v<T>
+        explicit constexpr operator T() const {
+            return static_cast<T>(m_raw >> Frac);
+        }
+
+        constexpr Fixed operator-() const { return fromRaw(m_raw == MIN_RAW ? MAX_RAW : -m_raw); }
+
+        constexpr Fixed operator+() const { return *this; }
+
+        friend constexpr Fixed operator+(Fixed lhs, Fixed rhs) {
+            Int result;
+            if (__builtin_add_overflow(lhs.m_raw, rhs.m_raw, &result)) {
+                return fromRaw(rhs.m_raw < 0 ? MIN_RAW : MAX_RAW);
+            }
+            return fromRaw(result);
+        }
+
+        friend constexpr Fixed operator-(Fixed lhs, Fixed rhs) {
+            Int result;
+            if (__builtin_sub_overflow(lhs.m_raw, rhs.m_raw, &result)) {
+                return fromRaw(rhs.m_raw < 0 ? MAX_RAW : MIN_RAW);
+            }
+            return fromRaw(result);
+        }
+
+        friend constexpr Fixed operator*(Fixed lhs, Fixed rhs) {
+            const bool negative = (lhs.m_raw < 0) != (rhs.m_raw < 0);
+            const Unsigned a = magnitude(lhs.m_raw);
+            const Unsigned b = magnitude(rhs.m_raw);
+            Unsigned product = 0;
+            bool overflow = false;
+            if constexpr (sizeof(Int) == 4) {
+                const uint64_t wide = (uint64_t(a) * b + (uint64_t(1) << (Frac - 1))) >> Frac;
+                overflow = wide > UINT32_MAX;
+                product = Unsigned(wide);
+            } else {
+                const detail::Wide rounded = detail::wideAdd(detail::wideMultiply(a, b), uint64_t(1) << (Frac - 1));
+                const detail::Wide wide = detail::wideShiftRight(rounded, Frac);
+                overflow = wide.hi != 0;
+                product = wide.lo;
+            }
+            return fromMagnitude(product, negative, overflow);
+        }
+
+        /**
+         * Dividing by 0 saturates towards the sign of the dividend, and 0 / 0 is 0
+         */
+        friend constexpr Fixed operator/(Fixed lhs, Fixed rhs) {
+            const bool negative = (lhs.m_raw < 0) != (rhs.m_raw < 0);
+            const Unsigned a = magnitude(lhs.m_raw);
+            const Unsigned b = magnitude(rhs.m_raw);
+            if (b == 0) return fromMagnitude(0, lhs.m_raw < 0, a != 0);
+            Unsigned quotient = 0;
+            bool overflow = false;
+            if constexpr (sizeof(Int) == 4) {
+                const uint64_t wide = ((uint64_t(a) << Frac) + b / 2) / b;
+                overflow = wide > UINT32_MAX;
+                quotient = Unsigned(wide);
+            } else {
+                const detail::Wide dividend = detail::wideAdd({a >> (64 - Frac), a << Frac}, b / 2);
+                // the quotient only fits in 64 bits if the high half of the dividend is less than the divisor
+                overflow = dividend.hi >= b;
+                if (!overflow) quotient = detail::wideDivide(dividend, b).hi;
+            }
+            return fromMagnitude(quotient, negative, overflow);
+        }
+
+        constexpr Fixed& operator+=(Fixed rhs) { return *this = *this + rhs; }
+
+        constexpr Fixed& operator-=(Fixed rhs) { return *this = *this - rhs; }
+
+        constexpr Fixed& operator*=(Fixed rhs) { return *this = *this * rhs; }
+
+        constexpr Fixed& operator/=(Fixed rhs) { return *this = *this / rhs; }
+
+        friend constexpr bool operator==(Fixed lhs, Fixed rhs) = default;
+
+        friend constexpr auto operator<=>(Fixed lhs, Fixed rhs) { return lhs.m_raw <=> rhs.m_raw; }
+    private:
+        using Unsigned = std::make_unsigned_t<Int>;
+
+        static constexpr Int MAX_RAW = std::numeric_limits<Int>::max();
+        static constexpr Int MIN_RAW = std::numeric_limits<Int>::min();
+        static constexpr Int MAX_INT = MAX_RAW >> Frac;
+        static constexpr Int MIN_INT = MIN_RAW >> Frac;
+
+        /**
+         * @brief magnitude of a raw value, which can't overflow since it is unsigned
+         */
+        static constexpr Unsigned magnitude(Int raw) { return raw < 0 ? Unsigned(0) - Unsigned(raw) : Unsigned(raw); }
+
+        /**
+         * @brief apply a sign to a magnitude, saturating if it is out of range
+         */
+        static constexpr Fixed fromMagnitude(Unsigned magnitude, bool negative, bool overflow) {
+            if (negative) {
+                if (overflow || magnitude > Unsigned(MAX_RAW) + 1) return fromRaw(MIN_RAW);
+                return fromRaw(Int(Unsigned(0) - magnitude));
+            }
+            if (overflow || magnitude > Unsigned(MAX_RAW)) return fromRaw(MAX_RAW);
+            return fromRaw(Int(magnitude));
+        }
+
+        /**
+         * @brief round a scaled floating point value to the nearest integer, saturating if it is out of range
+         */
+        static constexpr Int fromScaled(double scaled) {
+            if (scaled != scaled) return 0;
+            if (scaled >= static_cast<double>(MAX_RAW)) return MAX_RAW;
+            if (scaled <= static_cast<double>(MIN_RAW)) return MIN_RAW;
+            // adding 0.5 before truncating can round up twice when the scaled value has no fractional bits left
+            Int truncated = static_cast<Int>(scaled);
+            const double fraction = scaled - static_cast<double>(truncated);
+            if (fraction >= 0.5) truncated++;
+            else if (fraction <= -0.5) truncated--;
+            return truncated;
+        }
+
+        Int m_raw = 0;
+};
+
+/**
+ * @brief absolute value of a fixed point number, saturating at the largest value
+ */
+template <typename Int, int Frac> constexpr Fixed<Int, Frac> abs(Fixed<Int, Frac> value) {
+    return value < Fixed<Int, Frac>() ? -value : value;
+}
+
+/**
+ * @brief square root of a fixed point number, rounded down. Negative numbers return 0
+ *
+ * Computed with integer instructions only, one bit at a time, so it is deterministic too.
+ */
+template <typename Int, int Frac> constexpr Fixed<Int, Frac> sqrt(Fixed<Int, Frac> value) {
+    static_assert(sizeof(Int) == 4 || Frac <= 58, "the square root of this fixed point type would overflow");
+    if (value.raw() <= 0) return Fixed<Int, Frac>();
+    // the raw result is the square root of raw * 2^Frac, which is found two bits of the radicand at a time, starting
+    // from the most significant pair
+    const auto bit = [&](int i) -> uint64_t { return i >= Frac ? (uint64_t(value.raw()) >> (i - Frac)) & 1 : 0; };
+    const int pairs = (std::numeric_limits<Int>::digits + Frac + 1) / 2;
+    uint64_t remainder = 0;
+    uint64_t root = 0;
+    for (int i = pairs * 2 - 2; i >= 0; i -= 2) {
+        remainder = (remainder << 2) | (bit(i + 1) << 1) | bit(i);
+        const uint64_t trial = (root << 2) | 1;
+        root <<= 1;
+        if (remainder >= trial) {
+            remainder -= trial;
+            root |= 1;
+        }
+    }
+    return Fixed<Int, Frac>::fromRaw(Int(root));
+}
+
+/**
+ * @brief Q16.16 fixed point number
+ *
+ * Has a range of ±32768 and a resolution of about 15 millionths. Cheap on the V5 brain, since products fit in 64 bits
+ */
+using Q16_16 = Fixed<int32_t, 16>;
+
+/**
+ * @brief Q32.32 fixed point number
+ *
+ * Has a range of ±2 billion and a resolution of about 2e-10, but multiplication and division are much slower than
+ * Q16.16 on the V5 brain
+ */
+using Q32_32 = Fixed<int64_t, 32>;
+
+template <typename T> struct IsFixed : std::false_type {};
+
+template <typename Int, int Frac> struct IsFixed<Fixed<Int, Frac>> : std::true_type {};
+
+// isFixed concept, true for any fixed point number
+template <typename T>
+concept isFixed = IsFixed<T>::value;
+} // namespace units
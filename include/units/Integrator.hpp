@@ -0,0 +1,94 @@
+#pragma once
+
+#include "units/Transform2D.hpp"
+
+namespace units {
+/**
+ * @brief get the twist travelled in a time step at a constant velocity
+ *
+ * @param velocity the velocity, in the robot's frame. x is forwards, y is to the left
+ * @param dt the length of the time step
+ * @return Twist2D
+ */
+inline Twist2D toTwist(VelocityPose velocity, Time dt) {
+    return {velocity.getX() * dt, velocity.getY() * dt, velocity.getOrientation() * dt};
+}
+
+/**
+ * @brief advance a pose at a constant velocity
+ *
+ * The robot moves along a constant curvature arc, which is the exact path for a constant velocity in the robot's
+ * frame. A tick of an odometry or simulation loop turns through a small angle, so this only needs a few multiplications
+ * and no trigonometric functions.
+ *
+ * @param pose the pose at the start of the time step
+ * @param velocity the velocity, in the robot's frame. x is forwards, y is to the left
+ * @param dt the length of the time step
+ * @return Transform2D the pose at the end of the time step
+ *
+ * @b Example
+ * @code {.cpp}
+ * units::Transform2D pose;
+ * // drive forwards at 1 m/s while turning left at 90 degrees per second, for 1 second
+ * for (int i = 0; i < 100; i++) pose = units::integrate(pose, units::VelocityPose(1_mps, 0_mps, 90_degps), 10_msec);
+ * @endcode
+ */
+inline Transform2D integrate(const Transform2D& pose, VelocityPose velocity, Time dt) {
+    return pose * Transform2D::exp(toTwist(velocity, dt));
+}
+
+/**
+ * @brief advance a velocity at a constant acceleration
+ *
+ * @param velocity the velocity at the start of the time step
+ * @param acceleration the acceleration, in the same frame as the velocity
+ * @param dt the length of the time step
+ * @return VelocityPose the velocity at the end of the time step
+ */
+inline VelocityPose integrate(VelocityPose velocity, AccelerationPose acceleration, Time dt) {
+    return VelocityPose(velocity.getX() + acceleration.getX() * dt, velocity.getY() + acceleration.getY() * dt,
+                        velocity.getOrientation() + acceleration.getOrientation() * dt);
+}
+
+/**
+ * @brief advance a pose at a constant acceleration
+ *
+ * The robot moves along a single arc at the average velocity over the time step. The distance travelled and change in
+ * heading are exact, and the error in the path between them grows with the cube of the time step, so it is negligible
+ * at the rate of a control loop.
+ *
+ * @param pose the pose at the start of the time step
+ * @param velocity the velocity at the start of the time step, in the robot's frame
+ * @param acceleration the acceleration, in the robot's frame
+ * @param dt the length of the time step
+ * @return Transform2D the pose at the end of the time step
+ */
+inline Transform2D integrate(const Transform2D& pose, VelocityPose velocity, AccelerationPose acceleration, Time dt) {
+    return integrate(pose, integrate(velocity, acceleration, dt / 2.0), dt);
+}
+
+/**
+ * @brief advance a pose at a constant velocity
+ *
+ * @param pose the pose at the start of the time step, in standard orientation
+ * @param velocity the velocity, in the robot's frame. x is forwards, y is to the left
+ * @param dt the length of the time step
+ * @return Pose the pose at the end of the time step
+ */
+inline Pose integrate(Pose pose, VelocityPose velocity, Time dt) {
+    return integrate(Transform2D(pose), velocity, dt).toPose();
+}
+
+/**
+ * @brief advance a pose at a constant acceleration
+ *
+ * @param pose the pose at the start of the time step, in standard orientation
+ * @param velocity the velocity at the start of the time step, in the robot's frame
+ * @param acceleration the acceleration, in the robot's frame
+ * @param dt the length of the time step
+ * @return Pose the pose at the end of the time step
+ */
+inline Pose integrate(Pose pose, VelocityPose velocity, AccelerationPose acceleration, Time dt) {
+    return integrate(Transform2D(pose), velocity, acceleration, dt).toPose();
+}
+} // namespace units
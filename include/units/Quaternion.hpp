@@ -0,0 +1,198 @@
+#pragma once
+
+#include "units/RotationMatrix.hpp"
+
+namespace units {
+/**
+ * @class Quaternion
+ *
+ * @brief A rotation in 3D space, as a unit quaternion
+ *
+ * Uses the same angle conventions as RotationMatrix. Quaternions are cheaper to compose than matrices, and can be
+ * renormalized after many compositions without the drift a matrix accumulates.
+ *
+ * @b Example
+ * @code {.cpp}
+ * // the robot is driving up a 15 degree ramp, facing along the y axis
+ * constexpr units::Quaternion orientation = units::Quaternion::fromEuler(0_stDeg, -1.0 * 15_stDeg, 90_stDeg);
+ * // 10 inches forwards on the ramp, in field coordinates
+ * constexpr units::V3Position moved = orientation.rotate(units::V3Position(10_in, 0_in, 0_in));
+ * @endcode
+ */
+class Quaternion {
+    public:
+        /**
+         * @brief Construct a new Quaternion, which doesn't rotate
+         */
+        constexpr Quaternion() : w(1), x(0), y(0), z(0) {}
+
+        /**
+         * @brief Construct a new Quaternion from its components
+         *
+         * @param w real component
+         * @param x i component
+         * @param y j component
+         * @param z k component
+         */
+        constexpr Quaternion(double w, double x, double y, double z) : w(w), x(x), y(y), z(z) {}
+
+        /**
+         * @brief Create a rotation about an axis
+         *
+         * @param axis the axis to rotate about. Doesn't need to be normalized
+         * @param angle the angle to rotate by, counterclockwise when looking down the axis
+         * @return Quaternion
+         */
+        template <isQuantity T> static constexpr Quaternion fromAxisAngle(const Vector3D<T>& axis, Angle angle) {
+            const double magnitude = axis.magnitude().internal();
+            const double s = sin(angle / 2.0).internal() / magnitude;
+            return Quaternion(cos(angle / 2.0).internal(), axis.getX().internal() * s, axis.getY().internal() * s,
+                              axis.getZ().internal() * s);
+        }
+
+        /**
+         * @brief Create a rotation from Euler angles
+         *
+         * @param roll rotation about the x axis
+         * @param pitch rotation about the y axis
+         * @param yaw rotation about the z axis
+         * @return Quaternion
+         */
+        static constexpr Quaternion fromEuler(Angle roll, Angle pitch, Angle yaw) {
+            const double cr = cos(roll / 2.0).internal(), sr = sin(roll / 2.0).internal();
+            const double cp = cos(pitch / 2.0).internal(), sp = sin(pitch / 2.0).internal();
+            const double cy = cos(yaw / 2.0).internal(), sy = sin(yaw / 2.0).internal();
+            return Quaternion(cr * cp * cy + sr * sp * sy, sr * cp * cy - cr * sp * sy, cr * sp * cy + sr * cp * sy,
+                              cr * cp * sy - sr * sp * cy);
+        }
+
+        /**
+         * @brief Create a rotation from a rotation matrix
+         *
+         * @param r the rotation matrix
+         * @return Quaternion
+         */
+        static constexpr Quaternion fromRotationMatrix(const RotationMatrix& r) {
+            // use the largest of the diagonal terms to avoid dividing by a number close to 0
+            const double trace = r(0, 0) + r(1, 1) + r(2, 2);
+            if (trace > 0) {
+                const double s = std::sqrt(trace + 1.0) * 2;
+                return Quaternion(s / 4, (r(2, 1) - r(1, 2)) / s, (r(0, 2) - r(2, 0)) / s, (r(1, 0) - r(0, 1)) / s);
+            } else if (r(0, 0) > r(1, 1) && r(0, 0) > r(2, 2)) {
+                const double s = std::sqrt(1.0 + r(0, 0) - r(1, 1) - r(2, 2)) * 2;
+                return Quaternion((r(2, 1) - r(1, 2)) / s, s / 4, (r(0, 1) + r(1, 0)) / s, (r(0, 2) + r(2, 0)) / s);
+            } else if (r(1, 1) > r(2, 2)) {
+                const double s = std::sqrt(1.0 + r(1, 1) - r(0, 0) - r(2, 2)) * 2;
+                return Quaternion((r(0, 2) - r(2, 0)) / s, (r(0, 1) + r(1, 0)) / s, s / 4, (r(1, 2) + r(2, 1)) / s);
+            } else {
+                const double s = std::sqrt(1.0 + r(2, 2) - r(0, 0) - r(1, 1)) * 2;
+                return Quaternion((r(1, 0) - r(0, 1)) / s, (r(0, 2) + r(2, 0)) / s, (r(1, 2) + r(2, 1)) / s, s / 4);
+            }
+        }
+
+        constexpr double getW() const { return w; }
+
+        constexpr double getX() const { return x; }
+
+        constexpr double getY() const { return y; }
+
+        constexpr double getZ() const { return z; }
+
+        /**
+         * @brief compose two rotations
+         *
+         * @param other the rotation to apply first
+         * @return Quaternion this rotation applied after other
+         */
+        constexpr Quaternion operator*(const Quaternion& other) const {
+            return Quaternion(w * other.w - x * other.x - y * other.y - z * other.z,
+                              w * other.x + x * other.w + y * other.z - z * other.y,
+                              w * other.y - x * other.z + y * other.w + z * other.x,
+                              w * other.z + x * other.y - y * other.x + z * other.w);
+        }
+
+        /**
+         * @brief get the inverse rotation
+         *
+         * The inverse of a unit quaternion is its conjugate.
+         *
+         * @return Quaternion
+         */
+        constexpr Quaternion inverse() const { return Quaternion(w, -x, -y, -z); }
+
+        /**
+         * @brief get the magnitude of the quaternion, which is 1 for a rotation
+         *
+         * @return double
+         */
+        constexpr double norm() const { return std::sqrt(w * w + x * x + y * y + z * z); }
+
+        /**
+         * @brief scale the quaternion to a magnitude of 1
+         *
+         * Composing many rotations accumulates rounding errors, which this corrects.
+         *
+         * @return Quaternion
+         */
+        constexpr Quaternion normalized() const {
+            const double n = norm();
+            return Quaternion(w / n, x / n, y / n, z / n);
+        }
+
+        /**
+         * @brief rotate a vector
+         *
+         * Uses v' = v + 2w(u x v) + 2u x (u x v), where u is the vector part of the quaternion, which takes fewer
+         * operations than q * v * q^-1.
+         *
+         * @param v the vector to rotate
+         * @return Vector3D<T> the rotated vector
+         */
+        template <isQuantity T> constexpr Vector3D<T> rotate(const Vector3D<T>& v) const {
+            const double vx = v.getX().internal(), vy = v.getY().internal(), vz = v.getZ().internal();
+            // t = 2 (u x v)
+            const double tx = 2 * (y * vz - z * vy);
+            const double ty = 2 * (z * vx - x * vz);
+            const double tz = 2 * (x * vy - y * vx);
+            return Vector3D<T>(T(vx + w * tx + (y * tz - z * ty)), T(vy + w * ty + (z * tx - x * tz)),
+                               T(vz + w * tz + (x * ty - y * tx)));
+        }
+
+        /**
+         * @brief convert to a rotation matrix
+         *
+         * @return RotationMatrix
+         */
+        constexpr RotationMatrix toRotationMatrix() const {
+            return RotationMatrix({1 - 2 * (y * y + z * z), 2 * (x * y - w * z), 2 * (x * z + w * y), // row 0
+                                   2 * (x * y + w * z), 1 - 2 * (x * x + z * z), 2 * (y * z - w * x), // row 1
+                                   2 * (x * z - w * y), 2 * (y * z + w * x), 1 - 2 * (x * x + y * y)});
+        }
+
+        /**
+         * @brief get the roll of the rotation
+         *
+         * @return Angle rotation about the x axis, between -pi and pi
+         */
+        constexpr Angle getRoll() const { return Angle(std::atan2(2 * (w * x + y * z), 1 - 2 * (x * x + y * y))); }
+
+        /**
+         * @brief get the pitch of the rotation
+         *
+         * @return Angle rotation about the y axis, between -pi / 2 and pi / 2
+         */
+        constexpr Angle getPitch() const { return Angle(std::asin(std::clamp(2 * (w * y - z * x), -1.0, 1.0))); }
+
+        /**
+         * @brief get the yaw of the rotation
+         *
+         * @return Angle rotation about the z axis, between -pi and pi
+         */
+        constexpr Angle getYaw() const { return Angle(std::atan2(2 * (w * z + x * y), 1 - 2 * (y * y + z * z))); }
+    private:
+        double w; /** real component */
+        double x; /** i component */
+        double y; /** j component */
+        double z; /** k component */
+};
+} // namespace units
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "units/Vector3D.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace units {
+/**
+ * @class RotationMatrix
+ *
+ * @brief A rotation in 3D space, as a 3x3 orthonormal matrix
+ *
+ * Angles follow the right hand rule: roll is about the x axis, pitch about the y axis, and yaw about the z axis, all
+ * counterclockwise when looking down the axis towards the origin. Euler angles are applied in the order yaw, pitch,
+ * then roll, about the axes of the rotated frame, which is R = Rz(yaw) * Ry(pitch) * Rx(roll).
+ *
+ * Matrices are cheaper than quaternions for rotating many vectors, since each rotation is 9 multiplications.
+ */
+class RotationMatrix {
+    public:
+        /**
+         * @brief Construct a new RotationMatrix, which doesn't rotate
+         */
+        constexpr RotationMatrix() : m {1, 0, 0, 0, 1, 0, 0, 0, 1} {}
+
+        /**
+         * @brief Construct a new RotationMatrix from its elements
+         *
+         * @param elements the elements of the matrix, in row major order. Must be orthonormal
+         */
+        explicit constexpr RotationMatrix(const std::array<double, 9>& elements) : m(elements) {}
+
+        /**
+         * @brief Create a rotation about the x axis
+         *
+         * @param angle the angle to rotate by
+         * @return RotationMatrix
+         */
+        static constexpr RotationMatrix aboutX(Angle angle) {
+            const double c = cos(angle).internal();
+            const double s = sin(angle).internal();
+            return RotationMatrix({1, 0, 0, 0, c, -s, 0, s, c});
+        }
+
+        /**
+         * @brief Create a rotation about the y axis
+         *
+         * @param angle the angle to rotate by
+         * @return RotationMatrix
+         */
+        static constexpr RotationMatrix aboutY(Angle angle) {
+            const double c = cos(angle).internal();
+            const double s = sin(angle).internal();
+            return RotationMatrix({c, 0, s, 0, 1, 0, -s, 0, c});
+        }
+
+        /**
+         * @brief Create a rotation about the z axis
+         *
+         * @param angle the angle to rotate by
+         * @return RotationMatrix
+         */
+        static constexpr RotationMatrix aboutZ(Angle angle) {
+            const double c = cos(angle).internal();
+            const double s = sin(angle).internal();
+            return RotationMatrix({c, -s, 0, s, c, 0, 0, 0, 1});
+        }
+
+        /**
+         * @brief Create a rotation from Euler angles
+         *
+         * @param roll rotation about the x axis
+         * @param pitch rotation about the y axis
+         * @param yaw rotation about the z axis
+         * @return RotationMatrix
+         */
+        static constexpr RotationMatrix fromEuler(Angle roll, Angle pitch, Angle yaw) {
+            const double cr = cos(roll).internal(), sr = sin(roll).internal();
+            const double cp = cos(pitch).internal(), sp = sin(pitch).internal();
+            const double cy = cos(yaw).internal(), sy = sin(yaw).internal();
+            return RotationMatrix({cy * cp, cy * sp * sr - sy * cr, cy * sp * cr + sy * sr, // row 0
+                                   sy * cp, sy * sp * sr + cy * cr, sy * sp * cr - cy * sr, // row 1
+                                   -sp, cp * sr, cp * cr});
+        }
+
+        /**
+         * @brief get an element of the matrix
+         *
+         * @param row the row, from 0 to 2
+         * @param column the column, from 0 to 2
+         * @return double
+         */
+        constexpr double operator()(int row, int column) const { return m[row * 3 + column]; }
+
+        /**
+         * @brief compose two rotations
+         *
+         * @param other the rotation to apply first
+         * @return RotationMatrix this rotation applied after other
+         */
+        constexpr RotationMatrix operator*(const RotationMatrix& other) const {
+            std::array<double, 9> result {};
+            for (int row = 0; row < 3; row++) {
+                for (int column = 0; column < 3; column++) {
+                    result[row * 3 + column] = m[row * 3] * other.m[column] + m[row * 3 + 1] * other.m[3 + column] +
+                                               m[row * 3 + 2] * other.m[6 + column];
+                }
+            }
+            return RotationMatrix(result);
+        }
+
+        /**
+         * @brief rotate a vector
+         *
+         * @param v the vector to rotate
+         * @return Vector3D<T> the rotated vector
+         */
+        template <isQuantity T> constexpr Vector3D<T> operator*(const Vector3D<T>& v) const {
+            return Vector3D<T>(v.getX() * m[0] + v.getY() * m[1] + v.getZ() * m[2],
+                               v.getX() * m[3] + v.getY() * m[4] + v.getZ() * m[5],
+                               v.getX() * m[6] + v.getY() * m[7] + v.getZ() * m[8]);
+        }
+
+        /**
+         * @brief get the inverse rotation
+         *
+         * The inverse of a rotation matrix is its transpose.
+         *
+         * @return RotationMatrix
+         */
+        constexpr RotationMatrix inverse() const {
+            return RotationMatrix({m[0], m[3], m[6], m[1], m[4], m[7], m[2], m[5], m[8]});
+        }
+
+        /**
+         * @brief get the roll of the rotation
+         *
+         * @return Angle rotation about the x axis, between -pi and pi
+         */
+        constexpr Angle getRoll() const { return Angle(std::atan2(m[7], m[8])); }
+
+        /**
+         * @brief get the pitch of the rotation
+         *
+         * @return Angle rotation about the y axis, between -pi / 2 and pi / 2
+         */
+        constexpr Angle getPitch() const { return Angle(std::asin(std::clamp(-m[6], -1.0, 1.0))); }
+
+        /**
+         * @brief get the yaw of the rotation
+         *
+         * @return Angle rotation about the z axis, between -pi and pi
+         */
+        constexpr Angle getYaw() const { return Angle(std::atan2(m[3], m[0])); }
+    private:
+        std::array<double, 9> m; /** elements, in row major order */
+};
+} // namespace units
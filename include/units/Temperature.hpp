@@ -21,8 +21,13 @@ template <> struct LookupName<Quantity<std::ratio<0>, std::ratio<0>, std::ratio<
         using Named = Temperature;
 };
 
+template <> struct DimensionSuffix<Quantity<std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<0>, std::ratio<0>,
+                                           std::ratio<1>, std::ratio<0>, std::ratio<0>>> {
+        static constexpr units::FixedString value = " k";
+};
+
 inline std::ostream& operator<<(std::ostream& os, const Temperature& quantity) {
-    os << quantity.internal() << " k";
+    os << quantity.internal() << UnitSuffix<Temperature>::value.c_str();
     return os;
 }
 
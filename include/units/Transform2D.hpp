@@ -0,0 +1,319 @@
+#pragma once
+
+#include "units/Pose.hpp"
+#include "units/Vector2DArray.hpp"
+#include <span>
+
+namespace units {
+/**
+ * @brief A change in pose, expressed in the frame of the pose it is applied to
+ *
+ * dx is forwards, dy is to the left, and dtheta is counterclockwise, when applied to a pose in standard orientation. A
+ * twist describes driving along a constant curvature arc, like a chassis velocity multiplied by a time step.
+ */
+struct Twist2D {
+        Length dx = 0_m; /** forward displacement */
+        Length dy = 0_m; /** sideways displacement, to the left */
+        Angle dtheta = 0_stRad; /** change in orientation, counterclockwise */
+
+        /**
+         * @brief scale every component of the twist
+         *
+         * @param factor the factor to scale by
+         * @return Twist2D
+         */
+        constexpr Twist2D operator*(double factor) const { return {dx * factor, dy * factor, dtheta * factor}; }
+};
+
+/**
+ * @class Transform2D
+ *
+ * @brief A pose in 2D space, as a rigid body transform
+ *
+ * A Transform2D is a translation and a rotation, and can be used both as the pose of something in a frame, and as the
+ * transform from that thing's frame to the frame it is in. Poses can be composed, inverted, and used to transform
+ * points between frames.
+ *
+ * The cosine and sine of the orientation are calculated when the transform is constructed, and reused by every
+ * operation. Composing and inverting transforms uses the angle sum identities instead of calculating them again, so no
+ * trigonometric functions are called.
+ *
+ * @b Example
+ * @code {.cpp}
+ * units::Transform2D robot(24_in, 12_in, 90_stDeg);
+ * units::Transform2D target(48_in, 12_in, 0_stDeg);
+ * // the target relative to the robot. 24 inches to its right, facing right
+ * units::Transform2D error = target.relativeTo(robot);
+ * @endcode
+ */
+class Transform2D {
+    public:
+        /**
+         * @brief Construct a new Transform2D at the origin, facing along the x axis
+         */
+        Transform2D() = default;
+
+        /**
+         * @brief Construct a new Transform2D
+         *
+         * @param x x position
+         * @param y y position
+         * @param theta orientation, in standard orientation
+         */
+        Transform2D(Length x, Length y, Angle theta)
+            : x(x),
+              y(y),
+              theta(theta),
+              cosTheta(units::cos(theta).internal()),
+              sinTheta(units::sin(theta).internal()) {}
+
+        /**
+         * @brief Construct a new Transform2D from a Pose
+         *
+         * @param pose the pose, in standard orientation
+         */
+        explicit Transform2D(Pose pose)
+            : Transform2D(pose.getX(), pose.getY(), pose.getOrientation()) {}
+
+        /**
+         * @brief Create a new Transform2D by following a twist from the origin
+         *
+         * This is the exponential map of SE(2): the pose reached by moving along a constant curvature arc, with
+         * displacement and change in orientation given by the twist.
+         *
+         * @param twist the twist to follow
+         * @return Transform2D
+         */
+        static Transform2D exp(Twist2D twist) {
+            const double dtheta = twist.dtheta.internal();
+            // sin(dtheta) / dtheta and (1 - cos(dtheta)) / dtheta
+            double s, c, cosTheta, sinTheta;
+            if (std::abs(dtheta) < 0.1) {
+                // small rotations, like a single odometry tick, use Taylor series instead of calling sin and cos. Four
+                // terms are accurate to about 3e-16 below 0.1 radians
+                const double t2 = dtheta * dtheta;
+                s = 1.0 - t2 / 6.0 * (1.0 - t2 / 20.0 * (1.0 - t2 / 42.0 * (1.0 - t2 / 72.0)));
+                c = dtheta / 2.0 * (1.0 - t2 / 12.0 * (1.0 - t2 / 30.0 * (1.0 - t2 / 56.0)));
+                sinTheta = s * dtheta;
+                cosTheta = 1.0 - c * dtheta;
+            } else {
+                cosTheta = units::cos(twist.dtheta).internal();
+                sinTheta = units::sin(twist.dtheta).internal();
+                s = sinTheta / dtheta;
+                c = (1.0 - cosTheta) / dtheta;
+            }
+            return Transform2D(twist.dx * s - twist.dy * c, twist.dx * c + twist.dy * s, twist.dtheta, cosTheta,
+                               sinTheta);
+        }
+
+        /**
+         * @brief Get the twist which reaches this transform from the origin
+         *
+         * This is the logarithm map of SE(2), and the inverse of exp. The change in orientation of the twist is
+         * between -pi and pi.
+         *
+         * @return Twist2D
+         */
+        Twist2D log() const {
+            const double dtheta = std::atan2(sinTheta, cosTheta);
+            double s, c;
+            if (std::abs(dtheta) < 1e-9) {
+                s = 1.0 - dtheta * dtheta / 6.0;
+                c = dtheta / 2.0;
+            } else {
+                s = sinTheta / dtheta;
+                c = (1.0 - cosTheta) / dtheta;
+            }
+            // invert the matrix exp applies to the displacement, [[s, -c], [c, s]]
+            const double determinant = s * s + c * c;
+            return {(x * s + y * c) / determinant, (y * s - x * c) / determinant, Angle(dtheta)};
+        }
+
+        /**
+         * @brief get the x position
+         *
+         * @return Length
+         */
+        Length getX() const { return x; }
+
+        /**
+         * @brief get the y position
+         *
+         * @return Length
+         */
+        Length getY() const { return y; }
+
+        /**
+         * @brief get the orientation, in standard orientation
+         *
+         * @return Angle
+         */
+        Angle getTheta() const { return theta; }
+
+        /**
+         * @brief get the cosine of the orientation
+         *
+         * @return double
+         */
+        double getCos() const { return cosTheta; }
+
+        /**
+         * @brief get the sine of the orientation
+         *
+         * @return double
+         */
+        double getSin() const { return sinTheta; }
+
+        /**
+         * @brief get the position
+         *
+         * @return V2Position
+         */
+        V2Position getTranslation() const { return V2Position(x, y); }
+
+        /**
+         * @brief convert to a Pose
+         *
+         * @return Pose
+         */
+        Pose toPose() const { return Pose(x, y, theta); }
+
+        /**
+         * @brief compose two transforms
+         *
+         * The result is other applied in the frame of this transform. If this is the pose of a robot on the field, and
+         * other is the pose of something relative to the robot, the result is the pose of that thing on the field.
+         *
+         * @param other the transform to apply after this one
+         * @return Transform2D
+         */
+        Transform2D operator*(const Transform2D& other) const {
+            return Transform2D(x + other.x * cosTheta - other.y * sinTheta, y + other.x * sinTheta + other.y * cosTheta,
+                               theta + other.theta, cosTheta * other.cosTheta - sinTheta * other.sinTheta,
+                               sinTheta * other.cosTheta + cosTheta * other.sinTheta);
+        }
+
+        /**
+         * @brief compose two transforms. Same as operator*
+         *
+         * @param other the transform to apply, relative to this one
+         * @return Transform2D
+         */
+        Transform2D transformBy(const Transform2D& other) const { return *this * other; }
+
+        /**
+         * @brief get the inverse transform
+         *
+         * Composing a transform with its inverse gives the origin.
+         *
+         * @return Transform2D
+         */
+        Transform2D inverse() const {
+            return Transform2D(-1.0 * (x * cosTheta + y * sinTheta), x * sinTheta - y * cosTheta, -1.0 * theta,
+                               cosTheta, -sinTheta);
+        }
+
+        /**
+         * @brief express this transform relative to another one
+         *
+         * @param other the transform to use as the origin
+         * @return Transform2D this transform, in the frame of other
+         */
+        Transform2D relativeTo(const Transform2D& other) const { return other.inverse() * *this; }
+
+        /**
+         * @brief transform a point from the frame of this transform to the frame it is in
+         *
+         * @param point the point, relative to this transform
+         * @return V2Position
+         */
+        V2Position apply(V2Position point) const {
+            return V2Position(x + point.getX() * cosTheta - point.getY() * sinTheta,
+                              y + point.getX() * sinTheta + point.getY() * cosTheta);
+        }
+
+        /**
+         * @brief transform a point into the frame of this transform
+         *
+         * If this is the pose of a robot, the result is the point relative to the robot.
+         *
+         * @param point the point, in the frame this transform is in
+         * @return V2Position
+         */
+        V2Position applyInverse(V2Position point) const {
+            const Length dx = point.getX() - x;
+            const Length dy = point.getY() - y;
+            return V2Position(dx * cosTheta + dy * sinTheta, dy * cosTheta - dx * sinTheta);
+        }
+
+        /**
+         * @brief transform a list of points from the frame of this transform to the frame it is in, in place
+         *
+         * @param points the points, relative to this transform
+         */
+        void apply(std::span<V2Position> points) const {
+            for (V2Position& point : points) point = apply(point);
+        }
+
+        /**
+         * @brief transform a list of points into the frame of this transform, in place
+         *
+         * @param points the points, in the frame this transform is in
+         */
+        void applyInverse(std::span<V2Position> points) const {
+            for (V2Position& point : points) point = applyInverse(point);
+        }
+
+        /**
+         * @brief transform a list of points from the frame of this transform to the frame it is in, in place
+         *
+         * The rotation and translation are applied in a single SIMD pass.
+         *
+         * @param points the points, relative to this transform
+         */
+        template <isQuantity T>
+            requires Isomorphic<WithRep<T, double>, Length>
+        void apply(Vector2DArray<T>& points) const {
+            using Rep = typename T::rep;
+            points.transformBy(Rep(cosTheta), Rep(sinTheta), Vector2D<T>(T(x), T(y)));
+        }
+
+        /**
+         * @brief transform a list of points into the frame of this transform, in place
+         *
+         * The inverse is applied as a single rotation and translation, in one SIMD pass.
+         *
+         * @b Example
+         * @code {.cpp}
+         * // transform a path into the robot's frame, to find the point to steer towards
+         * units::Vector2DArray<LengthF> local = path;
+         * robot.applyInverse(local);
+         * @endcode
+         *
+         * @param points the points, in the frame this transform is in
+         */
+        template <isQuantity T>
+            requires Isomorphic<WithRep<T, double>, Length>
+        void applyInverse(Vector2DArray<T>& points) const {
+            using Rep = typename T::rep;
+            const Transform2D inv = inverse();
+            points.transformBy(Rep(inv.cosTheta), Rep(inv.sinTheta), Vector2D<T>(T(inv.x), T(inv.y)));
+        }
+    private:
+        /**
+         * @brief Construct a new Transform2D with a known cosine and sine
+         */
+        Transform2D(Length x, Length y, Angle theta, double cosTheta, double sinTheta)
+            : x(x),
+              y(y),
+              theta(theta),
+              cosTheta(cosTheta),
+              sinTheta(sinTheta) {}
+
+        Length x = 0_m; /** x position */
+        Length y = 0_m; /** y position */
+        Angle theta = 0_stRad; /** orientation */
+        double cosTheta = 1; /** cosine of the orientation */
+        double sinTheta = 0; /** sine of the orientation */
+};
+} // namespace units
@@ -41,8 +41,8 @@ template <isQuantity T> class Vector2D {
          * @param t angle
          * @param m magnitude
          */
-        static Vector2D fromPolar(Angle t, T m) {
-            m = m.abs();
+        static Vector2D fromPolar(AngleOf<T> t, T m) {
+            m = abs(m);
             t = constrainAngle360(t);
             return Vector2D<T>(m * cos(t), m * sin(t));
         }
@@ -53,7 +53,7 @@ template <isQuantity T> class Vector2D {
          * @param t angle
          * @return Vector2D
          */
-        static Vector2D unitVector(Angle t) { return fromPolar(t, (T)1.0); }
+        static Vector2D unitVector(AngleOf<T> t) { return fromPolar(t, (T)1.0); }
 
         /**
          * @brief get the x component
@@ -222,9 +222,9 @@ template <isQuantity T> class Vector2D {
         /**
          * @brief angle of the vector
          *
-         * @return Angle
+         * @return AngleOf<T>
          */
-        Angle theta() { return atan2(y, x); }
+        AngleOf<T> theta() { return atan2(y, x); }
 
         /**
          * @brief magnitude of the vector
@@ -248,9 +248,9 @@ template <isQuantity T> class Vector2D {
          * @brief the angle between two vectors
          *
          * @param other the other vector
-         * @return Angle
+         * @return AngleOf<T>
          */
-        Angle angleTo(Vector2D<T>& other) { return atan2(other.getY() - y, other.getX() - x); }
+        AngleOf<T> angleTo(Vector2D<T>& other) { return atan2(other.getY() - y, other.getX() - x); }
 
         /**
          * @brief get the distance between two vectors
@@ -258,7 +258,7 @@ template <isQuantity T> class Vector2D {
          * @param other the other vector
          * @return T
          */
-        T distanceTo(Vector2D<T>& other) { return sqrt(square(x - other.getX(), 2) + square(y - other.getY(), 2)); }
+        T distanceTo(Vector2D<T>& other) { return sqrt(square(x - other.getX()) + square(y - other.getY())); }
 
         /**
          * @brief normalize the vector
@@ -277,9 +277,9 @@ template <isQuantity T> class Vector2D {
          *
          * @param angle
          */
-        void rotateBy(Angle angle) {
+        void rotateBy(AngleOf<T> angle) {
             T m = magnitude();
-            Angle t = theta() + angle;
+            AngleOf<T> t = theta() + angle;
             x = m * cos(t);
             y = m * sin(t);
         }
@@ -289,7 +289,7 @@ template <isQuantity T> class Vector2D {
          *
          * @param angle
          */
-        void rotateTo(Angle angle) {
+        void rotateTo(AngleOf<T> angle) {
             T m = magnitude();
             x = m * cos(angle);
             y = m * sin(angle);
@@ -301,9 +301,9 @@ template <isQuantity T> class Vector2D {
          * @param angle
          * @return Vector2D<T>
          */
-        Vector2D<T> rotatedBy(Angle angle) {
+        Vector2D<T> rotatedBy(AngleOf<T> angle) {
             T m = magnitude();
-            Angle t = theta() + angle;
+            AngleOf<T> t = theta() + angle;
             return fromPolar(t, m);
         }
 
@@ -313,7 +313,7 @@ template <isQuantity T> class Vector2D {
          * @param angle
          * @return Vector2D<T>
          */
-        Vector2D<T> rotatedTo(Angle angle) {
+        Vector2D<T> rotatedTo(AngleOf<T> angle) {
             T m = magnitude();
             return fromPolar(angle, m);
         }
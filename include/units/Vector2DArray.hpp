@@ -0,0 +1,467 @@
+#pragma once
+
+#include "units/Vector2D.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <initializer_list>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace units {
+namespace simd {
+/**
+ * @brief Operations on a batch of values, processed with a single instruction each
+ *
+ * Only specialized for the types the target has vector instructions for: floats on the V5 brain (NEON), and floats and
+ * doubles on x86 hosts (SSE2). Kernels fall back to scalar code for other types.
+ *
+ * @tparam R the type of each value
+ */
+template <typename R> struct Batch {
+        static constexpr bool SUPPORTED = false;
+};
+
+#if defined(__ARM_NEON)
+template <> struct Batch<float> {
+        static constexpr bool SUPPORTED = true;
+        static constexpr std::size_t WIDTH = 4;
+        using Type = float32x4_t;
+
+        static Type load(const float* p) { return vld1q_f32(p); }
+
+        static void store(float* p, Type v) { vst1q_f32(p, v); }
+
+        static Type set(float v) { return vdupq_n_f32(v); }
+
+        static Type add(Type a, Type b) { return vaddq_f32(a, b); }
+
+        static Type sub(Type a, Type b) { return vsubq_f32(a, b); }
+
+        static Type mul(Type a, Type b) { return vmulq_f32(a, b); }
+
+        static Type sqrt(Type x) {
+            // ARMv7 NEON has no square root, so refine the reciprocal square root estimate with 2 Newton-Raphson steps,
+            // which is accurate to about 1 ulp
+            Type estimate = vrsqrteq_f32(x);
+            estimate = vmulq_f32(estimate, vrsqrtsq_f32(vmulq_f32(x, estimate), estimate));
+            estimate = vmulq_f32(estimate, vrsqrtsq_f32(vmulq_f32(x, estimate), estimate));
+            // the estimate for 0 is infinity, and 0 * infinity is NaN
+            return vbslq_f32(vceqq_f32(x, vdupq_n_f32(0)), x, vmulq_f32(x, estimate));
+        }
+};
+#elif defined(__SSE2__)
+template <> struct Batch<float> {
+        static constexpr bool SUPPORTED = true;
+        static constexpr std::size_t WIDTH = 4;
+        using Type = __m128;
+
+        static Type load(const float* p) { return _mm_loadu_ps(p); }
+
+        static void store(float* p, Type v) { _mm_storeu_ps(p, v); }
+
+        static Type set(float v) { return _mm_set1_ps(v); }
+
+        static Type add(Type a, Type b) { return _mm_add_ps(a, b); }
+
+        static Type sub(Type a, Type b) { return _mm_sub_ps(a, b); }
+
+        static Type mul(Type a, Type b) { return _mm_mul_ps(a, b); }
+
+        static Type sqrt(Type x) { return _mm_sqrt_ps(x); }
+};
+
+template <> struct Batch<double> {
+        static constexpr bool SUPPORTED = true;
+        static constexpr std::size_t WIDTH = 2;
+        using Type = __m128d;
+
+        static Type load(const double* p) { return _mm_loadu_pd(p); }
+
+        static void store(double* p, Type v) { _mm_storeu_pd(p, v); }
+
+        static Type set(double v) { return _mm_set1_pd(v); }
+
+        static Type add(Type a, Type b) { return _mm_add_pd(a, b); }
+
+        static Type sub(Type a, Type b) { return _mm_sub_pd(a, b); }
+
+        static Type mul(Type a, Type b) { return _mm_mul_pd(a, b); }
+
+        static Type sqrt(Type x) { return _mm_sqrt_pd(x); }
+};
+#endif
+
+// Kernels over raw arrays. Each processes as many elements as possible in batches, then finishes with scalar code.
+// The output may alias the inputs.
+
+template <typename R>
+inline void distance(const R* ax, const R* ay, const R* bx, const R* by, R* out, std::size_t n) {
+    std::size_t i = 0;
+    if constexpr (Batch<R>::SUPPORTED) {
+        using B = Batch<R>;
+        for (; i + B::WIDTH <= n; i += B::WIDTH) {
+            const auto dx = B::sub(B::load(ax + i), B::load(bx + i));
+            const auto dy = B::sub(B::load(ay + i), B::load(by + i));
+            B::store(out + i, B::sqrt(B::add(B::mul(dx, dx), B::mul(dy, dy))));
+        }
+    }
+    for (; i < n; i++) out[i] = std::sqrt((ax[i] - bx[i]) * (ax[i] - bx[i]) + (ay[i] - by[i]) * (ay[i] - by[i]));
+}
+
+template <typename R> inline void distance(const R* ax, const R* ay, R bx, R by, R* out, std::size_t n) {
+    std::size_t i = 0;
+    if constexpr (Batch<R>::SUPPORTED) {
+        using B = Batch<R>;
+        const auto px = B::set(bx);
+        const auto py = B::set(by);
+        for (; i + B::WIDTH <= n; i += B::WIDTH) {
+            const auto dx = B::sub(B::load(ax + i), px);
+            const auto dy = B::sub(B::load(ay + i), py);
+            B::store(out + i, B::sqrt(B::add(B::mul(dx, dx), B::mul(dy, dy))));
+        }
+    }
+    for (; i < n; i++) out[i] = std::sqrt((ax[i] - bx) * (ax[i] - bx) + (ay[i] - by) * (ay[i] - by));
+}
+
+template <typename R> inline void dot(const R* ax, const R* ay, const R* bx, const R* by, R* out, std::size_t n) {
+    std::size_t i = 0;
+    if constexpr (Batch<R>::SUPPORTED) {
+        using B = Batch<R>;
+        for (; i + B::WIDTH <= n; i += B::WIDTH) {
+            B::store(out + i, B::add(B::mul(B::load(ax + i), B::load(bx + i)),
+                                     B::mul(B::load(ay + i), B::load(by + i))));
+        }
+    }
+    for (; i < n; i++) out[i] = ax[i] * bx[i] + ay[i] * by[i];
+}
+
+template <typename R> inline void cross(const R* ax, const R* ay, const R* bx, const R* by, R* out, std::size_t n) {
+    std::size_t i = 0;
+    if constexpr (Batch<R>::SUPPORTED) {
+        using B = Batch<R>;
+        for (; i + B::WIDTH <= n; i += B::WIDTH) {
+            B::store(out + i, B::sub(B::mul(B::load(ax + i), B::load(by + i)),
+                                     B::mul(B::load(ay + i), B::load(bx + i))));
+        }
+    }
+    for (; i < n; i++) out[i] = ax[i] * by[i] - ay[i] * bx[i];
+}
+
+template <typename R> inline void rotate(R* x, R* y, R cos, R sin, std::size_t n) {
+    std::size_t i = 0;
+    if constexpr (Batch<R>::SUPPORTED) {
+        using B = Batch<R>;
+        const auto c = B::set(cos);
+        const auto s = B::set(sin);
+        for (; i + B::WIDTH <= n; i += B::WIDTH) {
+            const auto vx = B::load(x + i);
+            const auto vy = B::load(y + i);
+            B::store(x + i, B::sub(B::mul(vx, c), B::mul(vy, s)));
+            B::store(y + i, B::add(B::mul(vx, s), B::mul(vy, c)));
+        }
+    }
+    for (; i < n; i++) {
+        const R vx = x[i];
+        x[i] = vx * cos - y[i] * sin;
+        y[i] = vx * sin + y[i] * cos;
+    }
+}
+
+template <typename R> inline void translate(R* x, R* y, R dx, R dy, std::size_t n) {
+    std::size_t i = 0;
+    if constexpr (Batch<R>::SUPPORTED) {
+        using B = Batch<R>;
+        const auto vdx = B::set(dx);
+        const auto vdy = B::set(dy);
+        for (; i + B::WIDTH <= n; i += B::WIDTH) {
+            B::store(x + i, B::add(B::load(x + i), vdx));
+            B::store(y + i, B::add(B::load(y + i), vdy));
+        }
+    }
+    for (; i < n; i++) {
+        x[i] += dx;
+        y[i] += dy;
+    }
+}
+// rotation followed by a translation, in a single pass
+template <typename R> inline void transform(R* x, R* y, R cos, R sin, R dx, R dy, std::size_t n) {
+    std::size_t i = 0;
+    if constexpr (Batch<R>::SUPPORTED) {
+        using B = Batch<R>;
+        const auto c = B::set(cos);
+        const auto s = B::set(sin);
+        const auto vdx = B::set(dx);
+        const auto vdy = B::set(dy);
+        for (; i + B::WIDTH <= n; i += B::WIDTH) {
+            const auto vx = B::load(x + i);
+            const auto vy = B::load(y + i);
+            B::store(x + i, B::add(B::sub(B::mul(vx, c), B::mul(vy, s)), vdx));
+            B::store(y + i, B::add(B::add(B::mul(vx, s), B::mul(vy, c)), vdy));
+        }
+    }
+    for (; i < n; i++) {
+        const R vx = x[i];
+        x[i] = vx * cos - y[i] * sin + dx;
+        y[i] = vx * sin + y[i] * cos + dy;
+    }
+}
+} // namespace simd
+
+/**
+ * @class Vector2DArray
+ *
+ * @brief A list of 2D vectors, stored as a structure of arrays
+ *
+ * The x and y components are stored in separate contiguous arrays, so operations over every vector in the list can be
+ * run on several vectors at once with SIMD instructions. Use float quantities (like LengthF) to get the most out of
+ * this on the V5 brain, since NEON can't operate on doubles.
+ *
+ * Batched operations write their results to a span, and return how many results were written, which is the smaller
+ * of the number of vectors and the size of the span.
+ *
+ * @tparam T the type of quantity to use for the vector components
+ *
+ * @b Example:
+ * @code {.cpp}
+ * units::Vector2DArray<LengthF> path = {{0_in_f, 0_in_f}, {10_in_f, 0_in_f}, {10_in_f, 10_in_f}};
+ * std::vector<LengthF> distances(path.size(), 0_in_f);
+ * // distance from the robot to each point on the path
+ * path.distanceTo(units::Vector2D<LengthF>(5_in_f, 5_in_f), distances);
+ * @endcode
+ */
+template <isQuantity T> class Vector2DArray {
+        using Rep = typename T::rep;
+        static_assert(sizeof(T) == sizeof(Rep), "Quantities must have the same layout as their storage type");
+    public:
+        /**
+         * @brief Construct a new empty Vector2DArray
+         */
+        Vector2DArray() = default;
+
+        /**
+         * @brief Construct a new Vector2DArray from a list of vectors
+         *
+         * @param vectors the vectors to store
+         */
+        Vector2DArray(std::initializer_list<Vector2D<T>> vectors) {
+            reserve(vectors.size());
+            for (Vector2D<T> v : vectors) push_back(v);
+        }
+
+        /**
+         * @brief Get the number of vectors
+         *
+         * @return std::size_t
+         */
+        std::size_t size() const { return m_x.size(); }
+
+        /**
+         * @brief reserve space for a number of vectors
+         *
+         * @param capacity the number of vectors to reserve space for
+         */
+        void reserve(std::size_t capacity) {
+            m_x.reserve(capacity);
+            m_y.reserve(capacity);
+        }
+
+        /**
+         * @brief remove every vector
+         */
+        void clear() {
+            m_x.clear();
+            m_y.clear();
+        }
+
+        /**
+         * @brief add a vector to the end of the list
+         *
+         * @param v the vector to add
+         */
+        void push_back(Vector2D<T> v) {
+            m_x.push_back(v.getX().internal());
+            m_y.push_back(v.getY().internal());
+        }
+
+        /**
+         * @brief Get a vector
+         *
+         * @param i the index of the vector
+         * @return Vector2D<T>
+         */
+        Vector2D<T> operator[](std::size_t i) const { return Vector2D<T>(T(m_x[i]), T(m_y[i])); }
+
+        /**
+         * @brief Get the x component of a vector
+         *
+         * @param i the index of the vector
+         * @return T
+         */
+        T x(std::size_t i) const { return T(m_x[i]); }
+
+        /**
+         * @brief Get the y component of a vector
+         *
+         * @param i the index of the vector
+         * @return T
+         */
+        T y(std::size_t i) const { return T(m_y[i]); }
+
+        /**
+         * @brief set a vector
+         *
+         * @param i the index of the vector
+         * @param v the new value of the vector
+         */
+        void set(std::size_t i, Vector2D<T> v) {
+            m_x[i] = v.getX().internal();
+            m_y[i] = v.getY().internal();
+        }
+
+        /**
+         * @brief distance from each vector to a point
+         *
+         * @param point the point
+         * @param out where to write the distances
+         * @return std::size_t the number of distances written
+         */
+        std::size_t distanceTo(Vector2D<T> point, std::span<T> out) const {
+            const std::size_t n = count(out.size());
+            simd::distance(m_x.data(), m_y.data(), point.getX().internal(), point.getY().internal(), raw(out), n);
+            return n;
+        }
+
+        /**
+         * @brief distance from each vector to the vector with the same index in another list
+         *
+         * @param other the other list
+         * @param out where to write the distances
+         * @return std::size_t the number of distances written
+         */
+        std::size_t distanceTo(const Vector2DArray<T>& other, std::span<T> out) const {
+            const std::size_t n = std::min(count(out.size()), other.size());
+            simd::distance(m_x.data(), m_y.data(), other.m_x.data(), other.m_y.data(), raw(out), n);
+            return n;
+        }
+
+        /**
+         * @brief dot product of each vector with the vector with the same index in another list
+         *
+         * @tparam Q the type of quantity of the other list
+         * @param other the other list
+         * @param out where to write the dot products
+         * @return std::size_t the number of dot products written
+         */
+        template <isQuantity Q>
+        std::size_t dot(const Vector2DArray<Q>& other, std::span<Multiplied<T, Q>> out) const
+            requires std::is_same_v<typename Q::rep, Rep>
+        {
+            const std::size_t n = std::min(count(out.size()), other.size());
+            simd::dot(m_x.data(), m_y.data(), other.xData(), other.yData(), raw(out), n);
+            return n;
+        }
+
+        /**
+         * @brief cross product of each vector with the vector with the same index in another list
+         *
+         * @tparam Q the type of quantity of the other list
+         * @param other the other list
+         * @param out where to write the cross products
+         * @return std::size_t the number of cross products written
+         */
+        template <isQuantity Q>
+        std::size_t cross(const Vector2DArray<Q>& other, std::span<Multiplied<T, Q>> out) const
+            requires std::is_same_v<typename Q::rep, Rep>
+        {
+            const std::size_t n = std::min(count(out.size()), other.size());
+            simd::cross(m_x.data(), m_y.data(), other.xData(), other.yData(), raw(out), n);
+            return n;
+        }
+
+        /**
+         * @brief angle from each vector to the vector with the same index in another list
+         *
+         * There is no SIMD arc tangent, so this is calculated one vector at a time.
+         *
+         * @param other the other list
+         * @param out where to write the angles
+         * @return std::size_t the number of angles written
+         */
+        std::size_t angleTo(const Vector2DArray<T>& other, std::span<AngleOf<T>> out) const {
+            const std::size_t n = std::min(count(out.size()), other.size());
+            for (std::size_t i = 0; i < n; i++) {
+                out[i] = AngleOf<T>(std::atan2(other.m_y[i] - m_y[i], other.m_x[i] - m_x[i]));
+            }
+            return n;
+        }
+
+        /**
+         * @brief rotate every vector about the origin
+         *
+         * @param angle the angle to rotate by
+         */
+        void rotateBy(AngleOf<T> angle) {
+            simd::rotate(m_x.data(), m_y.data(), Rep(std::cos(angle.internal())), Rep(std::sin(angle.internal())),
+                         size());
+        }
+
+        /**
+         * @brief add an offset to every vector
+         *
+         * @param offset the offset to add
+         */
+        void translateBy(Vector2D<T> offset) {
+            simd::translate(m_x.data(), m_y.data(), offset.getX().internal(), offset.getY().internal(), size());
+        }
+
+        /**
+         * @brief rotate every vector about the origin, then add an offset
+         *
+         * Takes the cosine and sine of the angle instead of the angle, so callers which already have them don't need to
+         * calculate them again.
+         *
+         * @param cos cosine of the angle to rotate by
+         * @param sin sine of the angle to rotate by
+         * @param offset the offset to add
+         */
+        void transformBy(Rep cos, Rep sin, Vector2D<T> offset) {
+            simd::transform(m_x.data(), m_y.data(), cos, sin, offset.getX().internal(), offset.getY().internal(),
+                            size());
+        }
+
+        /**
+         * @brief Get the x components, in the base unit of T
+         *
+         * @return const Rep*
+         */
+        const Rep* xData() const { return m_x.data(); }
+
+        /**
+         * @brief Get the y components, in the base unit of T
+         *
+         * @return const Rep*
+         */
+        const Rep* yData() const { return m_y.data(); }
+    private:
+        std::size_t count(std::size_t outSize) const { return std::min(size(), outSize); }
+
+        /**
+         * @brief view a span of quantities as their storage type, so kernels can write to them directly
+         */
+        template <isQuantity Q> static Rep* raw(std::span<Q> out) {
+            static_assert(sizeof(Q) == sizeof(Rep) && std::is_standard_layout_v<Q>);
+            return reinterpret_cast<Rep*>(out.data());
+        }
+
+        std::vector<Rep> m_x;
+        std::vector<Rep> m_y;
+};
+} // namespace units
@@ -17,14 +17,14 @@ template <isQuantity T> class Vector3D {
         T z; /** z component */
     public:
         /**
-         * @brief Construct a new Vector2D object
+         * @brief Construct a new Vector3D object
          *
          * This constructor initializes x, y, and z to 0
          */
-        Vector3D() : x(0.0), y(0.0), z(0.0) {}
+        constexpr Vector3D() : x(0.0), y(0.0), z(0.0) {}
 
         /**
-         * @brief Construct a new Vector2D object
+         * @brief Construct a new Vector3D object
          *
          * This constructor initializes x, y, and z to the given values
          *
@@ -32,70 +32,70 @@ template <isQuantity T> class Vector3D {
          * @param ny y component
          * @param nz z component
          */
-        Vector3D(T nx, T ny, T nz) : x(nx), y(ny), z(nz) {}
+        constexpr Vector3D(T nx, T ny, T nz) : x(nx), y(ny), z(nz) {}
 
         /**
-         * @brief Create a new Vector3D object from polar coordinates
+         * @brief Create a new Vector3D object from direction angles
          *
-         * This constructor takes polar coordinates and converts them to cartesian coordinates
+         * Each component is the magnitude times the cosine of the angle between the vector and that axis
          *
-         * @param t angle
+         * @param t the angles between the vector and the x, y, and z axes
          * @param m magnitude
          */
-        static Vector3D fromPolar(Vector3D<Angle>& t, T m) {
-            m = m.abs();
-            return Vector2D<T>(m * cos(t.x), m * cos(t.y), m * cos(t.z));
+        static constexpr Vector3D fromPolar(const Vector3D<Angle>& t, T m) {
+            m = abs(m);
+            return Vector3D<T>(m * cos(t.getX()), m * cos(t.getY()), m * cos(t.getZ()));
         }
 
         /**
-         * @brief Create a new Vector3D object from an angle with a magnitude of 1
+         * @brief Create a new Vector3D object from direction angles with a magnitude of 1
          *
-         * @param t angle
+         * @param t the angles between the vector and the x, y, and z axes
          * @return Vector3D
          */
-        static Vector3D unitVector(Vector3D<Angle> t) { return fromPolar(t, (T)1.0); }
+        static constexpr Vector3D unitVector(const Vector3D<Angle>& t) { return fromPolar(t, T(1.0)); }
 
         /**
          * @brief get the x component
          *
          * @return T x component
          */
-        T getX() { return x; }
+        constexpr T getX() const { return x; }
 
         /**
          * @brief get the y component
          *
          * @return T y component
          */
-        T getY() { return y; }
+        constexpr T getY() const { return y; }
 
         /**
          * @brief get the z component
          *
          * @return T z component
          */
-        T getZ() { return z; }
+        constexpr T getZ() const { return z; }
 
         /**
          * @brief set the x component
          *
          * @param nx x component
          */
-        void setX(T nx) { x = nx; }
+        constexpr void setX(T nx) { x = nx; }
 
         /**
          * @brief set the y component
          *
          * @param ny y component
          */
-        void setY(T ny) { y = ny; }
+        constexpr void setY(T ny) { y = ny; }
 
         /**
          * @brief set the z component
          *
          * @param nz z component
          */
-        void setZ(T nz) { z = nz; }
+        constexpr void setZ(T nz) { z = nz; }
 
         /**
          * @brief + operator overload
@@ -106,8 +106,8 @@ template <isQuantity T> class Vector3D {
          * @param other vector to add
          * @return Vector3D<T>
          */
-        Vector3D<T> operator+(Vector3D<T>& other) {
-            return Vector3D<T>(x + other.getX(), y + other.getY(), z + getZ());
+        constexpr Vector3D<T> operator+(const Vector3D<T>& other) const {
+            return Vector3D<T>(x + other.x, y + other.y, z + other.z);
         }
 
         /**
@@ -119,7 +119,9 @@ template <isQuantity T> class Vector3D {
          * @param other vector to subtract
          * @return Vector3D<T>
          */
-        Vector3D<T> operator-(Vector3D<T>& other) { return Vector3D<T>(x - other.getX(), y - other.getY()); }
+        constexpr Vector3D<T> operator-(const Vector3D<T>& other) const {
+            return Vector3D<T>(x - other.x, y - other.y, z - other.z);
+        }
 
         /**
          * @brief * operator overload
@@ -130,7 +132,9 @@ template <isQuantity T> class Vector3D {
          * @param factor scalar to multiply by
          * @return Vector3D<T>
          */
-        Vector3D<T> operator*(double factor) { return Vector3D<T>(x * factor, y * factor, z * factor); }
+        constexpr Vector3D<T> operator*(double factor) const {
+            return Vector3D<T>(x * factor, y * factor, z * factor);
+        }
 
         /**
          * @brief / operator overload
@@ -141,7 +145,9 @@ template <isQuantity T> class Vector3D {
          * @param factor scalar to divide by
          * @return Vector3D<T>
          */
-        Vector3D<T> operator/(double factor) { return Vector3D<T>(x / factor, y / factor, z / factor); }
+        constexpr Vector3D<T> operator/(double factor) const {
+            return Vector3D<T>(x / factor, y / factor, z / factor);
+        }
 
         /**
          * @brief += operator overload
@@ -152,10 +158,10 @@ template <isQuantity T> class Vector3D {
          * @param other vector to add
          * @return Vector3D<T>&
          */
-        Vector3D<T>& operator+=(Vector3D<T>& other) {
-            x += other.getX();
-            y += other.getY();
-            z += other.getZ();
+        constexpr Vector3D<T>& operator+=(const Vector3D<T>& other) {
+            x += other.x;
+            y += other.y;
+            z += other.z;
             return (*this);
         }
 
@@ -168,10 +174,10 @@ template <isQuantity T> class Vector3D {
          * @param other vector to subtract
          * @return Vector3D<T>&
          */
-        Vector3D<T>& operator-=(Vector3D<T>& other) {
-            x -= other.getX();
-            y -= other.getY();
-            z -= other.getZ();
+        constexpr Vector3D<T>& operator-=(const Vector3D<T>& other) {
+            x -= other.x;
+            y -= other.y;
+            z -= other.z;
             return (*this);
         }
 
@@ -185,7 +191,7 @@ template <isQuantity T> class Vector3D {
          * @param factor scalar to multiply by
          * @return Vector3D<T>&
          */
-        Vector3D<T>& operator*=(double factor) {
+        constexpr Vector3D<T>& operator*=(double factor) {
             x *= factor;
             y *= factor;
             z *= factor;
@@ -202,13 +208,23 @@ template <isQuantity T> class Vector3D {
          * @param factor scalar to divide by
          * @return Vector3D<T>&
          */
-        Vector3D<T>& operator/=(double factor) {
+        constexpr Vector3D<T>& operator/=(double factor) {
             x /= factor;
             y /= factor;
             z /= factor;
             return (*this);
         }
 
+        /**
+         * @brief == operator overload
+         *
+         * @param other vector to compare with
+         * @return true if every component is equal
+         */
+        constexpr bool operator==(const Vector3D<T>& other) const {
+            return x == other.x && y == other.y && z == other.z;
+        }
+
         /**
          * @brief dot product of 2 Vector3D objects
          *
@@ -220,7 +236,7 @@ template <isQuantity T> class Vector3D {
          * @param other the vector to calculate the dot product with
          * @return R the dot product
          */
-        template <isQuantity Q, isQuantity R = Multiplied<T, Q>> R dot(Vector3D<Q>& other) {
+        template <isQuantity Q, isQuantity R = Multiplied<T, Q>> constexpr R dot(const Vector3D<Q>& other) const {
             return (x * other.getX()) + (y * other.getY()) + (z * other.getZ());
         }
 
@@ -237,16 +253,18 @@ template <isQuantity T> class Vector3D {
          * @param other the vector to calculate the cross product with
          * @return Vector3D<R> the cross product
          */
-        template <isQuantity Q, isQuantity R = Multiplied<T, Q>> Vector3D<R> cross(Vector3D<Q>& other) {
-            return Vector3D<R>(y * other.z - z * other.y, z * other.x - x * other.z, x * other.y - y * other.x);
+        template <isQuantity Q, isQuantity R = Multiplied<T, Q>>
+        constexpr Vector3D<R> cross(const Vector3D<Q>& other) const {
+            return Vector3D<R>(y * other.getZ() - z * other.getY(), z * other.getX() - x * other.getZ(),
+                               x * other.getY() - y * other.getX());
         }
 
         /**
-         * @brief angle of the vector
+         * @brief direction angles of the vector
          *
-         * @return Angle
+         * @return Vector3D<Angle> the angles between the vector and the x, y, and z axes
          */
-        Vector3D<Angle> theta() {
+        constexpr Vector3D<Angle> theta() const {
             const T mag = magnitude();
             return Vector3D<Angle>(acos(x / mag), acos(y / mag), acos(z / mag));
         }
@@ -256,22 +274,18 @@ template <isQuantity T> class Vector3D {
          *
          * @return T
          */
-        T magnitude() { return sqrt(square(x) + square(y) + square(z)); }
+        constexpr T magnitude() const { return sqrt(square(x) + square(y) + square(z)); }
 
         /**
          * @brief difference between two vectors
          *
-         * TODO: figure out if this is even necessary, you could just use the - operator overload
-         *
          * This function calculates the difference between two vectors
          * a.vectorTo(b) = {b.x - a.x, b.y - a.y, b.z - a.z}
          *
          * @param other the other vector
          * @return Vector3D<T>
          */
-        Vector3D<T> vectorTo(Vector3D<T>& other) {
-            return Vector2D<T>(other.getX() - x, other.getY() - y, other.getZ() - z);
-        }
+        constexpr Vector3D<T> vectorTo(const Vector3D<T>& other) const { return other - *this; }
 
         /**
          * @brief the angle between two vectors
@@ -279,7 +293,9 @@ template <isQuantity T> class Vector3D {
          * @param other the other vector
          * @return Angle
          */
-        Angle angleTo(Vector3D<T>& other) { return units::acos(dot(other) / (magnitude() * other.magnitude())); }
+        constexpr Angle angleTo(const Vector3D<T>& other) const {
+            return units::acos(dot(other) / (magnitude() * other.magnitude()));
+        }
 
         /**
          * @brief get the distance between two vectors
@@ -287,7 +303,7 @@ template <isQuantity T> class Vector3D {
          * @param other the other vector
          * @return T
          */
-        T distanceTo(Vector3D<T>& other) { return vectorTo(other).magnitude(); }
+        constexpr T distanceTo(const Vector3D<T>& other) const { return vectorTo(other).magnitude(); }
 
         /**
          * @brief normalize the vector
@@ -296,57 +312,9 @@ template <isQuantity T> class Vector3D {
          *
          * @return Vector3D<T>
          */
-        Vector3D<T> normalize() {
-            T m = magnitude();
-            return Vector2D<T>(x / m, y / m, z / m);
-        }
-
-        /**
-         * @brief rotate the vector by an angle
-         *
-         * @param angle
-         */
-        void rotateBy(Vector3D<Angle>& angle) {
+        constexpr Vector3D<T> normalize() const {
             const T m = magnitude();
-            const Vector3D<Angle> t = theta() + angle;
-            x = m * cos(t.x);
-            y = m * cos(t.y);
-            z = m * cos(t.z);
-        }
-
-        /**
-         * @brief rotate the vector to an angle
-         *
-         * @param angle
-         */
-        void rotateTo(Vector3D<Angle>& angle) {
-            const T m = magnitude();
-            x = m * cos(angle.x);
-            y = m * cos(angle.y);
-            z = m * cos(angle.z);
-        }
-
-        /**
-         * @brief get a copy of this vector rotated by an angle
-         *
-         * @param angle
-         * @return Vector3D<T>
-         */
-        Vector3D<T> rotatedBy(Vector3D<Angle> angle) {
-            T m = magnitude();
-            Angle t = theta() + angle;
-            return fromPolar(t, m);
-        }
-
-        /**
-         * @brief get a copy of this vector rotated to an angle
-         *
-         * @param angle
-         * @return Vector3D<T>
-         */
-        Vector3D<T> rotatedTo(Angle angle) {
-            T m = magnitude();
-            return fromPolar(angle, m);
+            return Vector3D<T>(unit_cast<T>(x / m), unit_cast<T>(y / m), unit_cast<T>(z / m));
         }
 };
 
@@ -3,15 +3,23 @@
 #include <array>
 #include <cmath>
 #include <ratio>
+#include <string_view>
 #include <iostream>
 #include <utility>
 #include <algorithm>
+#include <type_traits>
+#include "units/Fixed.hpp"
 
 // define M_PI if not already defined
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
+// define M_TWOPI if not already defined
+#ifndef M_TWOPI
+#define M_TWOPI (M_PI * 2.0)
+#endif
+
 // define typenames
 
 /**
@@ -19,14 +27,22 @@
  *
  * This class is a template class that represents a quantity with a value and units.
  *
+ * The value is stored as a double by default. Quantities stored as a float, like LengthF, use half the memory and can
+ * be vectorized with NEON on the V5 brain, at the cost of precision. Quantities stored as a fixed point number, like
+ * units::Q16_16, only use integer math and saturate instead of overflowing, so they give exactly the same results on
+ * the V5 brain and the host. Quantities with different storage types can't be mixed without an explicit conversion.
+ *
  * @tparam TYPENAMES the types of the units
+ * @tparam Rep the type the value is stored as
  */
 template <typename Mass = std::ratio<0>, typename Length = std::ratio<0>, typename Time = std::ratio<0>,
           typename Current = std::ratio<0>, typename Angle = std::ratio<0>, typename Temperature = std::ratio<0>,
-          typename Luminosity = std::ratio<0>, typename Moles = std::ratio<0>>
+          typename Luminosity = std::ratio<0>, typename Moles = std::ratio<0>, typename Rep = double>
 class Quantity {
+        static_assert(std::is_floating_point_v<Rep> || units::isFixed<Rep>,
+                      "Quantities must be stored as a floating point or fixed point type");
     protected:
-        double value; /** the value stored in its base unit type */
+        Rep value; /** the value stored in its base unit type */
     public:
         typedef Mass mass; /** mass unit type */
         typedef Length length; /** length unit type */
@@ -36,8 +52,9 @@ class Quantity {
         typedef Temperature temperature; /** temperature unit type */
         typedef Luminosity luminosity; /** luminosity unit type */
         typedef Moles moles; /** moles unit type */
+        typedef Rep rep; /** storage type */
 
-        using Self = Quantity<Mass, Length, Time, Current, Angle, Temperature, Luminosity, Moles>;
+        using Self = Quantity<Mass, Length, Time, Current, Angle, Temperature, Luminosity, Moles, Rep>;
 
         /**
          * @brief construct a new Quantity object
@@ -51,7 +68,18 @@ class Quantity {
          *
          * @param value the value to initialize the quantity with
          */
-        explicit constexpr Quantity(double value) : value(value) {}
+        explicit constexpr Quantity(Rep value) : value(value) {}
+
+        /**
+         * @brief construct a new Quantity object from a quantity stored as a different type
+         *
+         * @param other the quantity to convert
+         */
+        template <typename R>
+            requires(!std::is_same_v<R, Rep>)
+        explicit constexpr Quantity(
+            const Quantity<Mass, Length, Time, Current, Angle, Temperature, Luminosity, Moles, R>& other)
+            : value(static_cast<Rep>(other.internal())) {}
 
         /**
          * @brief construct a new Quantity object
@@ -60,15 +88,22 @@ class Quantity {
          */
         constexpr Quantity(Self const& other) : value(other.value) {}
 
+        /**
+         * @brief copy the value of another quantity into this one
+         *
+         * @param other the quantity to copy
+         */
+        constexpr Self& operator=(Self const& other) = default;
+
         /**
          * @brief get the value of the quantity in its base unit type
          *
-         * @return constexpr double
+         * @return constexpr Rep
          */
-        constexpr double internal() const { return value; }
+        constexpr Rep internal() const { return value; }
 
         // TODO: document this
-        constexpr double convert(Self quantity) { return value / quantity.value; }
+        constexpr Rep convert(Self quantity) const { return value / quantity.value; }
 
         /**
          * @brief set the value of this quantity to its current value plus another quantity
@@ -85,25 +120,25 @@ class Quantity {
         constexpr void operator-=(Self other) { value -= other.value; }
 
         /**
-         * @brief set the value of this quantity to its current value times a double
+         * @brief set the value of this quantity to its current value times a scalar
          *
          * @param multiple the multiple to multiply by
          */
-        constexpr void operator*=(double multiple) { value *= multiple; }
+        constexpr void operator*=(Rep multiple) { value *= multiple; }
 
         /**
-         * @brief set the value of this quantity to its current value divided by a double
+         * @brief set the value of this quantity to its current value divided by a scalar
          *
          * @param dividend the dividend to divide by
          */
-        constexpr void operator/=(double dividend) { value /= dividend; }
+        constexpr void operator/=(Rep dividend) { value /= dividend; }
 
         /**
-         * @brief set the value of this quantity to a double, only if the quantity is a number
+         * @brief set the value of this quantity to a scalar, only if the quantity is a number
          *
-         * @param rhs the double to assign
+         * @param rhs the scalar to assign
          */
-        constexpr void operator=(const double& rhs) {
+        constexpr void operator=(const Rep& rhs) {
             static_assert(std::ratio_equal<mass, std::ratio<0>>() && std::ratio_equal<length, std::ratio<0>>() &&
                               std::ratio_equal<time, std::ratio<0>>() && std::ratio_equal<current, std::ratio<0>>() &&
                               std::ratio_equal<angle, std::ratio<0>>() &&
@@ -123,8 +158,8 @@ template <typename Q> using Named = typename LookupName<Q>::Named;
 // quantity checker. Used by the isQuantity concept
 template <typename Mass = std::ratio<0>, typename Length = std::ratio<0>, typename Time = std::ratio<0>,
           typename Current = std::ratio<0>, typename Angle = std::ratio<0>, typename Temperature = std::ratio<0>,
-          typename Luminosity = std::ratio<0>, typename Moles = std::ratio<0>>
-void quantityChecker(Quantity<Mass, Length, Time, Current, Angle, Temperature, Luminosity, Moles>) {}
+          typename Luminosity = std::ratio<0>, typename Moles = std::ratio<0>, typename Rep = double>
+void quantityChecker(Quantity<Mass, Length, Time, Current, Angle, Temperature, Luminosity, Moles, Rep>) {}
 
 // isQuantity concept
 template <typename Q>
@@ -134,8 +169,10 @@ concept isQuantity = requires(Q q) { quantityChecker(q); };
 template <typename Q, typename... Quantities>
 concept Isomorphic = ((std::convertible_to<Q, Quantities> && std::convertible_to<Quantities, Q>) && ...);
 
-// Un(type)safely coerce the a unit into a different unit
-template <isQuantity Q1, isQuantity Q2> constexpr inline Q1 unit_cast(Q2 quantity) { return Q1(quantity.internal()); }
+// Un(type)safely coerce the a unit into a different unit. Also converts between storage types
+template <isQuantity Q1, isQuantity Q2> constexpr inline Q1 unit_cast(Q2 quantity) {
+    return Q1(static_cast<typename Q1::rep>(quantity.internal()));
+}
 
 template <isQuantity Q1, isQuantity Q2> using Multiplied = Named<Quantity<
     std::ratio_add<typename Q1::mass, typename Q2::mass>, std::ratio_add<typename Q1::length, typename Q2::length>,
@@ -143,7 +180,7 @@ template <isQuantity Q1, isQuantity Q2> using Multiplied = Named<Quantity<
     std::ratio_add<typename Q1::angle, typename Q2::angle>,
     std::ratio_add<typename Q1::temperature, typename Q2::temperature>,
     std::ratio_add<typename Q1::luminosity, typename Q2::luminosity>,
-    std::ratio_add<typename Q1::moles, typename Q2::moles>>>;
+    std::ratio_add<typename Q1::moles, typename Q2::moles>, typename Q1::rep>>;
 
 template <isQuantity Q1, isQuantity Q2> using Divided =
     Named<Quantity<std::ratio_subtract<typename Q1::mass, typename Q2::mass>,
@@ -153,49 +190,130 @@ template <isQuantity Q1, isQuantity Q2> using Divided =
                    std::ratio_subtract<typename Q1::angle, typename Q2::angle>,
                    std::ratio_subtract<typename Q1::temperature, typename Q2::temperature>,
                    std::ratio_subtract<typename Q1::luminosity, typename Q2::luminosity>,
-                   std::ratio_subtract<typename Q1::moles, typename Q2::moles>>>;
+                   std::ratio_subtract<typename Q1::moles, typename Q2::moles>, typename Q1::rep>>;
 
 template <isQuantity Q, typename factor> using Exponentiated = Named<
     Quantity<std::ratio_multiply<typename Q::mass, factor>, std::ratio_multiply<typename Q::length, factor>,
              std::ratio_multiply<typename Q::time, factor>, std::ratio_multiply<typename Q::current, factor>,
              std::ratio_multiply<typename Q::angle, factor>, std::ratio_multiply<typename Q::temperature, factor>,
-             std::ratio_multiply<typename Q::luminosity, factor>, std::ratio_multiply<typename Q::moles, factor>>>;
+             std::ratio_multiply<typename Q::luminosity, factor>, std::ratio_multiply<typename Q::moles, factor>,
+             typename Q::rep>>;
 
 template <isQuantity Q, typename quotient> using Rooted = Named<
     Quantity<std::ratio_divide<typename Q::mass, quotient>, std::ratio_divide<typename Q::length, quotient>,
              std::ratio_divide<typename Q::time, quotient>, std::ratio_divide<typename Q::current, quotient>,
              std::ratio_divide<typename Q::angle, quotient>, std::ratio_divide<typename Q::temperature, quotient>,
-             std::ratio_divide<typename Q::luminosity, quotient>, std::ratio_divide<typename Q::moles, quotient>>>;
-
-inline void unit_printer_helper(std::ostream& os, double quantity,
-                                const std::array<std::pair<intmax_t, intmax_t>, 8>& dims) {
-    static constinit std::array<const char*, 8> prefixes {"_kg", "_m", "_s", "_A", "_rad", "_K", "_cd", "_mol"};
-    os << quantity;
-    for (size_t i = 0; i != 8; i++) {
-        if (dims[i].first != 0) {
-            os << prefixes[i];
-            if (dims[i].first != 1 || dims[i].second != 1) os << '^' << dims[i].first;
-            if (dims[i].second != 1) os << '/' << dims[i].second;
+             std::ratio_divide<typename Q::luminosity, quotient>, std::ratio_divide<typename Q::moles, quotient>,
+             typename Q::rep>>;
+
+namespace units {
+/**
+ * @brief string which can be built at compile time
+ *
+ * @tparam N the length of the string, including the null terminator
+ */
+template <std::size_t N> struct FixedString {
+        constexpr FixedString() = default;
+
+        constexpr FixedString(const char (&str)[N]) { std::copy_n(str, N, value); }
+
+        constexpr const char* c_str() const { return value; }
+
+        constexpr operator std::string_view() const { return std::string_view(value, N - 1); }
+
+        char value[N] {};
+};
+
+namespace detail {
+/**
+ * @brief write the suffix of an unnamed unit, like _kg_m^2_s^-2, or count its length if out is null
+ */
+constexpr std::size_t writeDimensions(char* out, const std::array<std::pair<intmax_t, intmax_t>, 8>& dims) {
+    constexpr std::array<const char*, 8> prefixes {"_kg", "_m", "_s", "_A", "_rad", "_K", "_cd", "_mol"};
+    std::size_t length = 0;
+    const auto put = [&](char c) {
+        if (out != nullptr) out[length] = c;
+        length++;
+    };
+    const auto putInt = [&](intmax_t value) {
+        if (value < 0) put('-');
+        char digits[24] {};
+        int count = 0;
+        for (uintmax_t v = value < 0 ? -uintmax_t(value) : uintmax_t(value); v != 0 || count == 0; v /= 10) {
+            digits[count++] = char('0' + v % 10);
+        }
+        while (count > 0) put(digits[--count]);
+    };
+    for (std::size_t i = 0; i != 8; i++) {
+        if (dims[i].first == 0) continue;
+        for (const char* c = prefixes[i]; *c != '\0'; c++) put(*c);
+        if (dims[i].first != 1 || dims[i].second != 1) {
+            put('^');
+            putInt(dims[i].first);
+        }
+        if (dims[i].second != 1) {
+            put('/');
+            putInt(dims[i].second);
         }
     }
+    return length;
+}
+
+template <isQuantity Q> constexpr auto dimensionSuffix() {
+    constexpr std::array<std::pair<intmax_t, intmax_t>, 8> dims {{
+        {Q::mass::num, Q::mass::den},
+        {Q::length::num, Q::length::den},
+        {Q::time::num, Q::time::den},
+        {Q::current::num, Q::current::den},
+        {Q::angle::num, Q::angle::den},
+        {Q::temperature::num, Q::temperature::den},
+        {Q::luminosity::num, Q::luminosity::den},
+        {Q::moles::num, Q::moles::den},
+    }};
+    FixedString<writeDimensions(nullptr, dims) + 1> result;
+    writeDimensions(result.value, dims);
+    return result;
+}
+} // namespace detail
+} // namespace units
+
+/**
+ * @brief the suffix of a set of dimensions, given as a Quantity stored as a double
+ *
+ * Named units specialize this with their own suffix, like " m". Other units get a suffix generated from their
+ * dimensions at compile time, like "_kg_m^2_s^-2", so printing a quantity never builds a string at runtime.
+ */
+template <typename Dimensions> struct DimensionSuffix {
+        static constexpr auto value = units::detail::dimensionSuffix<Dimensions>();
+};
+
+/**
+ * @brief the suffix printed after the value of a quantity
+ *
+ * The suffix only depends on the dimensions, so a length prints as " m" whether it is stored as a double, a float, or a
+ * fixed point number.
+ */
+template <typename Q> struct UnitSuffix {
+        static constexpr const auto& value =
+            DimensionSuffix<Quantity<typename Q::mass, typename Q::length, typename Q::time, typename Q::current,
+                                     typename Q::angle, typename Q::temperature, typename Q::luminosity,
+                                     typename Q::moles>>::value;
+};
+
+/**
+ * @brief get the suffix printed after the value of a quantity
+ *
+ * The string has static storage, so it can be passed to deferred logging.
+ *
+ * @param quantity the quantity
+ * @return const char* the suffix, like " m" or "_kg_m^2_s^-2"
+ */
+template <isQuantity Q> constexpr const char* unitSuffix([[maybe_unused]] const Q& quantity) {
+    return UnitSuffix<Named<Q>>::value.c_str();
 }
 
 template <isQuantity Q> inline std::ostream& operator<<(std::ostream& os, const Q& quantity) {
-    if constexpr (!std::is_same_v<Named<Q>, Q>) {
-        os << Named<Q>(quantity);
-    } else {
-        constinit static std::array<std::pair<intmax_t, intmax_t>, 8> dims {{
-            {Q::mass::num, Q::mass::den},
-            {Q::length::num, Q::length::den},
-            {Q::time::num, Q::time::den},
-            {Q::current::num, Q::current::den},
-            {Q::angle::num, Q::angle::den},
-            {Q::temperature::num, Q::temperature::den},
-            {Q::luminosity::num, Q::luminosity::den},
-            {Q::moles::num, Q::moles::den},
-        }};
-        unit_printer_helper(os, quantity.internal(), dims);
-    }
+    os << static_cast<double>(quantity.internal()) << UnitSuffix<Named<Q>>::value.c_str();
     return os;
 }
 
@@ -211,17 +329,28 @@ template <isQuantity Q, isQuantity R> constexpr Q operator-(Q lhs, R rhs)
     return Q(lhs.internal() - rhs.internal());
 }
 
-template <isQuantity Q> constexpr Q operator*(Q quantity, double multiple) { return Q(quantity.internal() * multiple); }
+// scalars are converted to the storage type first, so float quantities are never promoted to double
+template <isQuantity Q> constexpr Q operator*(Q quantity, typename Q::rep multiple) {
+    return Q(quantity.internal() * multiple);
+}
 
-template <isQuantity Q> constexpr Q operator*(double multiple, Q quantity) { return Q(quantity.internal() * multiple); }
+template <isQuantity Q> constexpr Q operator*(typename Q::rep multiple, Q quantity) {
+    return Q(quantity.internal() * multiple);
+}
 
-template <isQuantity Q> constexpr Q operator/(Q quantity, double divisor) { return Q(quantity.internal() / divisor); }
+template <isQuantity Q> constexpr Q operator/(Q quantity, typename Q::rep divisor) {
+    return Q(quantity.internal() / divisor);
+}
 
 template <isQuantity Q1, isQuantity Q2, isQuantity Q3 = Multiplied<Q1, Q2>> Q3 constexpr operator*(Q1 lhs, Q2 rhs) {
+    static_assert(std::is_same_v<typename Q1::rep, typename Q2::rep>,
+                  "Quantities with different storage types can't be mixed without an explicit conversion");
     return Q3(lhs.internal() * rhs.internal());
 }
 
 template <isQuantity Q1, isQuantity Q2, isQuantity Q3 = Divided<Q1, Q2>> Q3 constexpr operator/(Q1 lhs, Q2 rhs) {
+    static_assert(std::is_same_v<typename Q1::rep, typename Q2::rep>,
+                  "Quantities with different storage types can't be mixed without an explicit conversion");
     return Q3(lhs.internal() / rhs.internal());
 }
 
@@ -261,23 +390,34 @@ template <isQuantity Q, isQuantity R> constexpr bool operator>(const Q& lhs, con
     return (lhs.internal() > rhs.internal());
 }
 
-#define NEW_UNIT(Name, suffix, m, l, t, i, a, o, j, n)                                                                 \
+#define NEW_UNIT_CLASS(Name, Rep, OtherRep, m, l, t, i, a, o, j, n)                                                    \
     class Name : public Quantity<std::ratio<m>, std::ratio<l>, std::ratio<t>, std::ratio<i>, std::ratio<a>,            \
-                                 std::ratio<o>, std::ratio<j>, std::ratio<n>> {                                        \
+                                 std::ratio<o>, std::ratio<j>, std::ratio<n>, Rep> {                                   \
         public:                                                                                                        \
-            explicit constexpr Name(double value)                                                                      \
+            explicit constexpr Name(Rep value)                                                                         \
                 : Quantity<std::ratio<m>, std::ratio<l>, std::ratio<t>, std::ratio<i>, std::ratio<a>, std::ratio<o>,   \
-                           std::ratio<j>, std::ratio<n>>(value) {}                                                     \
+                           std::ratio<j>, std::ratio<n>, Rep>(value) {}                                                \
             constexpr Name(Quantity<std::ratio<m>, std::ratio<l>, std::ratio<t>, std::ratio<i>, std::ratio<a>,         \
-                                    std::ratio<o>, std::ratio<j>, std::ratio<n>>                                       \
+                                    std::ratio<o>, std::ratio<j>, std::ratio<n>, Rep>                                  \
                                value)                                                                                  \
                 : Quantity<std::ratio<m>, std::ratio<l>, std::ratio<t>, std::ratio<i>, std::ratio<a>, std::ratio<o>,   \
-                           std::ratio<j>, std::ratio<n>>(value) {};                                                    \
+                           std::ratio<j>, std::ratio<n>, Rep>(value) {};                                               \
+            explicit constexpr Name(Quantity<std::ratio<m>, std::ratio<l>, std::ratio<t>, std::ratio<i>, std::ratio<a>,\
+                                             std::ratio<o>, std::ratio<j>, std::ratio<n>, OtherRep>                    \
+                                        value)                                                                         \
+                : Quantity<std::ratio<m>, std::ratio<l>, std::ratio<t>, std::ratio<i>, std::ratio<a>, std::ratio<o>,   \
+                           std::ratio<j>, std::ratio<n>, Rep>(value) {};                                               \
     };                                                                                                                 \
     template <> struct LookupName<Quantity<std::ratio<m>, std::ratio<l>, std::ratio<t>, std::ratio<i>, std::ratio<a>,  \
-                                           std::ratio<o>, std::ratio<j>, std::ratio<n>>> {                             \
+                                           std::ratio<o>, std::ratio<j>, std::ratio<n>, Rep>> {                        \
             using Named = Name;                                                                                        \
-    };                                                                                                                 \
+    };
+
+// Each unit is defined twice: Name stores its value as a double, and Name##F stores it as a float. Float literals
+// have an _f suffix, like 1.5_in_f
+#define NEW_UNIT(Name, suffix, m, l, t, i, a, o, j, n)                                                                 \
+    NEW_UNIT_CLASS(Name, double, float, m, l, t, i, a, o, j, n)                                                        \
+    NEW_UNIT_CLASS(Name##F, float, double, m, l, t, i, a, o, j, n)                                                     \
     [[maybe_unused]] constexpr Name suffix = Name(1.0);                                                                \
     constexpr Name operator""_##suffix(long double value) {                                                            \
         return Name(Quantity<std::ratio<m>, std::ratio<l>, std::ratio<t>, std::ratio<i>, std::ratio<a>, std::ratio<o>, \
@@ -287,19 +427,37 @@ template <isQuantity Q, isQuantity R> constexpr bool operator>(const Q& lhs, con
         return Name(Quantity<std::ratio<m>, std::ratio<l>, std::ratio<t>, std::ratio<i>, std::ratio<a>, std::ratio<o>, \
                              std::ratio<j>, std::ratio<n>>(static_cast<double>(value)));                               \
     }                                                                                                                  \
+    constexpr Name##F operator""_##suffix##_f(long double value) { return Name##F(static_cast<float>(value)); }        \
+    constexpr Name##F operator""_##suffix##_f(unsigned long long value) { return Name##F(static_cast<float>(value)); } \
+    template <> struct DimensionSuffix<Quantity<std::ratio<m>, std::ratio<l>, std::ratio<t>, std::ratio<i>,            \
+                                                std::ratio<a>, std::ratio<o>, std::ratio<j>, std::ratio<n>>> {         \
+            static constexpr units::FixedString value = " " #suffix;                                                   \
+    };                                                                                                                 \
     inline std::ostream& operator<<(std::ostream& os, const Name& quantity) {                                          \
-        os << quantity.internal() << " " << #suffix;                                                                   \
+        os << quantity.internal() << UnitSuffix<Name>::value.c_str();                                                  \
+        return os;                                                                                                     \
+    }                                                                                                                  \
+    inline std::ostream& operator<<(std::ostream& os, const Name##F& quantity) {                                       \
+        os << quantity.internal() << UnitSuffix<Name##F>::value.c_str();                                               \
         return os;                                                                                                     \
     }                                                                                                                  \
     constexpr inline Name from_##suffix(double value) { return Name(value); }                                          \
-    constexpr inline double to_##suffix(Name quantity) { return quantity.internal(); }
+    constexpr inline double to_##suffix(Name quantity) { return quantity.internal(); }                                 \
+    constexpr inline float to_##suffix(Name##F quantity) { return quantity.internal(); }
 
 #define NEW_UNIT_LITERAL(Name, suffix, multiple)                                                                       \
     [[maybe_unused]] constexpr Name suffix = multiple;                                                                 \
     constexpr Name operator""_##suffix(long double value) { return static_cast<double>(value) * multiple; }            \
     constexpr Name operator""_##suffix(unsigned long long value) { return static_cast<double>(value) * multiple; }     \
+    constexpr Name##F operator""_##suffix##_f(long double value) {                                                     \
+        return Name##F(static_cast<double>(value) * multiple);                                                         \
+    }                                                                                                                  \
+    constexpr Name##F operator""_##suffix##_f(unsigned long long value) {                                              \
+        return Name##F(static_cast<double>(value) * multiple);                                                         \
+    }                                                                                                                  \
     constexpr inline Name from_##suffix(double value) { return value * multiple; }                                     \
-    constexpr inline double to_##suffix(Name quantity) { return quantity.convert(multiple); }
+    constexpr inline double to_##suffix(Name quantity) { return quantity.convert(multiple); }                          \
+    constexpr inline float to_##suffix(Name##F quantity) { return quantity.convert(Name##F(multiple)); }
 
 #define NEW_METRIC_PREFIXES(Name, base)                                                                                \
     NEW_UNIT_LITERAL(Name, T##base, base * 1E12)                                                                       \
@@ -324,6 +482,9 @@ NEW_UNIT_LITERAL(Time, min, sec * 60)
 NEW_UNIT_LITERAL(Time, hr, min * 60)
 NEW_UNIT_LITERAL(Time, day, hr * 24)
 
+NEW_UNIT(Frequency, Hz, 0, 0, -1, 0, 0, 0, 0, 0)
+NEW_UNIT_LITERAL(Frequency, kHz, Hz * 1E3)
+
 NEW_UNIT(Length, m, 0, 1, 0, 0, 0, 0, 0, 0)
 NEW_METRIC_PREFIXES(Length, m)
 NEW_UNIT_LITERAL(Length, in, cm * 2.54)
@@ -392,7 +553,16 @@ NEW_UNIT(Luminosity, candela, 0, 0, 0, 0, 0, 0, 1, 0);
 NEW_UNIT(Moles, mol, 0, 0, 0, 0, 0, 0, 0, 1);
 
 namespace units {
-template <isQuantity Q> constexpr Q abs(const Q& lhs) { return Q(std::abs(lhs.internal())); }
+// Quantity with the same units as Q, stored as Rep
+template <isQuantity Q, typename Rep> using WithRep =
+    Named<Quantity<typename Q::mass, typename Q::length, typename Q::time, typename Q::current, typename Q::angle,
+                   typename Q::temperature, typename Q::luminosity, typename Q::moles, Rep>>;
+
+template <isQuantity Q> constexpr Q abs(const Q& lhs) {
+    // fixed point overloads are found by argument dependent lookup
+    using std::abs;
+    return Q(abs(lhs.internal()));
+}
 
 template <isQuantity Q, isQuantity R> constexpr Q max(const Q& lhs, const R& rhs)
     requires Isomorphic<Q, R>
@@ -407,7 +577,14 @@ template <isQuantity Q, isQuantity R> constexpr Q min(const Q& lhs, const R& rhs
 }
 
 template <int R, isQuantity Q, isQuantity S = Exponentiated<Q, std::ratio<R>>> constexpr S pow(const Q& lhs) {
-    return S(std::pow(lhs.internal(), R));
+    // integer powers are expanded into multiplications, since std::pow is only inlined for a power of 2
+    if constexpr (R < 0) {
+        return S(typename Q::rep(1) / pow<-R>(lhs).internal());
+    } else {
+        typename Q::rep result(1);
+        for (int i = 0; i < R; i++) result *= lhs.internal();
+        return S(result);
+    }
 }
 
 template <isQuantity Q, isQuantity S = Exponentiated<Q, std::ratio<2>>> constexpr S square(const Q& lhs) {
@@ -419,12 +596,17 @@ template <isQuantity Q, isQuantity S = Exponentiated<Q, std::ratio<3>>> constexp
 }
 
 template <int R, isQuantity Q, isQuantity S = Rooted<Q, std::ratio<R>>> constexpr S root(const Q& lhs) {
-    return S(std::pow(lhs.internal(), 1.0 / R));
+    return S(std::pow(lhs.internal(), typename Q::rep(1) / R));
 }
 
-template <isQuantity Q, isQuantity S = Rooted<Q, std::ratio<2>>> constexpr S sqrt(const Q& lhs) { return root<2>(lhs); }
+template <isQuantity Q, isQuantity S = Rooted<Q, std::ratio<2>>> constexpr S sqrt(const Q& lhs) {
+    using std::sqrt;
+    return S(sqrt(lhs.internal()));
+}
 
-template <isQuantity Q, isQuantity S = Rooted<Q, std::ratio<3>>> constexpr S cbrt(const Q& lhs) { return root<3>(lhs); }
+template <isQuantity Q, isQuantity S = Rooted<Q, std::ratio<3>>> constexpr S cbrt(const Q& lhs) {
+    return S(std::cbrt(lhs.internal()));
+}
 
 template <isQuantity Q, isQuantity R> constexpr Q hypot(const Q& lhs, const R& rhs)
     requires Isomorphic<Q, R>
@@ -444,7 +626,10 @@ template <isQuantity Q1, isQuantity Q2> constexpr Q1 copysign(const Q1& lhs, con
 
 template <isQuantity Q> constexpr int sgn(const Q& lhs) { return lhs.internal() < 0 ? -1 : 1; }
 
-template <isQuantity Q> constexpr bool signbit(const Q& lhs) { return std::signbit(lhs.internal()); }
+template <isQuantity Q> constexpr bool signbit(const Q& lhs) {
+    if constexpr (isFixed<typename Q::rep>) return lhs.internal().raw() < 0;
+    else return std::signbit(lhs.internal());
+}
 
 template <isQuantity Q, isQuantity R, isQuantity S> constexpr Q clamp(const Q& lhs, const R& lo, const S& hi)
     requires Isomorphic<Q, R, S>
@@ -0,0 +1,100 @@
+################################################################################
+############################ Host simulation build #############################
+# Builds everything in LemLib that doesn't depend on the PROS kernel for the
+# host machine, along with the simulated devices in src/lemlib/sim. This lets
+# motion code and control loops be run and profiled on a workstation or in CI.
+# Host tools in tools/ are built against the same library.
+#
+# The bench target runs the benchmarks in bench/, and checks that the units
+# library compiles to the same instructions as hand written double math, for
+# the host and, if the PROS toolchain is installed, for the V5 brain.
+#
+# usage: make -f sim.mk [bench]
+################################################################################
+HOSTCXX?=g++
+HOSTAR?=ar
+SIMDIR:=./bin/sim
+
+HOST_CXXFLAGS?=-O2 -g
+HOST_WARNFLAGS?=-Wall -Wextra -Wno-unused-parameter
+HOST_CXXFLAGS+=--std=gnu++20 $(HOST_WARNFLAGS) -I./include
+
+# sources which can be compiled without the PROS kernel
+HOST_SRC:=$(wildcard ./src/lemlib/sim/*.cpp) ./src/LemLog/logger/ringbuffer.cpp ./src/LemLog/logger/topic.cpp \
+	./src/LemLog/logger/telemetry.cpp ./src/lemlib/TiltCompensator.cpp \
+	./src/lemlib/MotionProfile.cpp ./src/hardware/encoder/VelocityEstimator.cpp \
+	./src/lemlib/VelocityController.cpp ./src/lemlib/FeedforwardCharacterization.cpp \
+	./src/lemlib/DrivetrainCharacterization.cpp
+HOST_OBJ:=$(patsubst ./src/%.cpp,$(SIMDIR)/obj/%.o,$(HOST_SRC))
+SIMLIB:=$(SIMDIR)/libLemLibSim.a
+
+.DEFAULT_GOAL:=sim
+.PHONY: sim tools bench codegen clean-sim
+
+# host tools, one directory per tool
+TOOLS:=$(patsubst ./tools/%/,$(SIMDIR)/%,$(dir $(wildcard ./tools/*/main.cpp)))
+
+sim: $(SIMLIB) tools
+
+tools: $(TOOLS)
+
+$(SIMDIR)/%: ./tools/%/main.cpp $(SIMLIB)
+	@mkdir -p $(dir $@)
+	$(HOSTCXX) $(HOST_CXXFLAGS) -MMD -MP $< $(SIMLIB) -o $@
+
+# benchmarks are always optimized, since they measure the generated code
+BENCHDIR:=$(SIMDIR)/bench
+BENCH_CXXFLAGS:=--std=gnu++20 -O2 $(HOST_WARNFLAGS) -I./include
+ARMCXX?=arm-none-eabi-g++
+# the V5 check uses the optimization level of the real build
+ARM_CXXFLAGS:=--std=gnu++20 -mcpu=cortex-a9 -mfpu=neon-fp16 -mfloat-abi=softfp -Os -I./include
+HAVE_ARMCXX:=$(shell command -v $(ARMCXX) 2>/dev/null)
+
+# every source in bench/ is a benchmark, except the kernels and the codegen checker
+BENCHES:=$(filter-out kernels codegen,$(basename $(notdir $(wildcard ./bench/*.cpp))))
+
+bench: codegen $(addprefix $(BENCHDIR)/,$(BENCHES))
+	$(foreach b,$(BENCHES),$(BENCHDIR)/$(b) &&) true
+
+codegen: $(BENCHDIR)/codegen $(BENCHDIR)/kernels.host.s $(if $(HAVE_ARMCXX),$(BENCHDIR)/kernels.arm.s)
+	$(BENCHDIR)/codegen $(BENCHDIR)/kernels.host.s
+ifneq ($(HAVE_ARMCXX),)
+	$(BENCHDIR)/codegen $(BENCHDIR)/kernels.arm.s
+else
+	@echo "$(ARMCXX) not found, skipping V5 codegen check"
+endif
+
+$(BENCHDIR)/units: ./bench/units.cpp ./bench/kernels.cpp
+	@mkdir -p $(dir $@)
+	$(HOSTCXX) $(BENCH_CXXFLAGS) -MMD -MP $(filter %.cpp,$^) -o $@
+
+# benchmarks of library code which is compiled into the simulation library
+LIBRARY_BENCHES:=tilt profile velocity feedforward telemetry
+$(addprefix $(BENCHDIR)/,$(LIBRARY_BENCHES)): $(BENCHDIR)/%: ./bench/%.cpp $(SIMLIB)
+	@mkdir -p $(dir $@)
+	$(HOSTCXX) $(BENCH_CXXFLAGS) -MMD -MP $(filter %.cpp %.a,$^) -o $@
+
+$(BENCHDIR)/%: ./bench/%.cpp
+	@mkdir -p $(dir $@)
+	$(HOSTCXX) $(BENCH_CXXFLAGS) -MMD -MP $< -o $@
+
+$(BENCHDIR)/kernels.host.s: ./bench/kernels.cpp
+	@mkdir -p $(dir $@)
+	$(HOSTCXX) $(BENCH_CXXFLAGS) -MMD -MP -S $< -o $@
+
+$(BENCHDIR)/kernels.arm.s: ./bench/kernels.cpp
+	@mkdir -p $(dir $@)
+	$(ARMCXX) $(ARM_CXXFLAGS) -MMD -MP -S $< -o $@
+
+$(SIMLIB): $(HOST_OBJ)
+	@mkdir -p $(dir $@)
+	$(HOSTAR) rcs $@ $^
+
+$(SIMDIR)/obj/%.o: ./src/%.cpp
+	@mkdir -p $(dir $@)
+	$(HOSTCXX) $(HOST_CXXFLAGS) -MMD -MP -c $< -o $@
+
+clean-sim:
+	rm -rf $(SIMDIR)
+
+-include $(HOST_OBJ:.o=.d) $(TOOLS:=.d) $(wildcard $(BENCHDIR)/*.d)
@@ -0,0 +1,116 @@
+#include "LemLog/logger/ringbuffer.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace logger {
+static std::size_t roundUpToPowerOf2(std::size_t n) {
+    std::size_t result = 1;
+    while (result < n) result <<= 1;
+    return result;
+}
+
+/**
+ * @brief copy a string into a fixed size buffer, truncating it if necessary
+ *
+ * @return true if the string was truncated
+ */
+template <std::size_t N> static bool copyTruncated(char (&dest)[N], std::string_view src) {
+    const std::size_t length = std::min(src.size(), N - 1);
+    std::memcpy(dest, src.data(), length);
+    dest[length] = '\0';
+    return length < src.size();
+}
+
+/**
+ * @brief replace the end of a truncated message with "..."
+ *
+ * @param message the message, which fills a buffer of the given size
+ * @param size the size of the buffer, including the null terminator
+ */
+static void markTruncated(char* message, std::size_t size) {
+    if (size >= 4) std::memcpy(message + size - 4, "...", 3);
+}
+
+RingBuffer::RingBuffer(std::size_t capacity)
+    : m_mask(roundUpToPowerOf2(std::max<std::size_t>(capacity, 2)) - 1),
+      m_slots(new Slot[m_mask + 1]) {
+    for (std::size_t i = 0; i <= m_mask; i++) m_slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+const char* Record::getMessage(char* out, std::size_t outSize) const {
+    if (formatter == nullptr) return message;
+    const int length = formatter(out, outSize, format, message);
+    if (length >= 0 && std::size_t(length) >= outSize) markTruncated(out, outSize);
+    return out;
+}
+
+RingBuffer::Slot* RingBuffer::claim(std::size_t& pos) {
+    pos = m_head.load(std::memory_order_relaxed);
+    while (true) {
+        Slot* slot = &m_slots[pos & m_mask];
+        const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const std::intptr_t diff = std::intptr_t(sequence) - std::intptr_t(pos);
+        if (diff == 0) {
+            // the slot is free, try to claim it
+            if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) return slot;
+        } else if (diff < 0) {
+            // the slot hasn't been read yet, so the buffer is full
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        } else {
+            // another task claimed the slot first, try again
+            pos = m_head.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void RingBuffer::publish(Slot* slot, std::size_t pos) { slot->sequence.store(pos + 1, std::memory_order_release); }
+
+bool RingBuffer::push(Level level, std::string_view topic, std::string_view message) {
+    std::size_t pos;
+    Slot* slot = claim(pos);
+    if (slot == nullptr) return false;
+    slot->record.level = level;
+    slot->record.formatter = nullptr;
+    slot->record.format = nullptr;
+    copyTruncated(slot->record.topic, topic);
+    if (copyTruncated(slot->record.message, message)) {
+        markTruncated(slot->record.message, MAX_MESSAGE_LENGTH);
+        m_truncated.fetch_add(1, std::memory_order_relaxed);
+    }
+    publish(slot, pos);
+    return true;
+}
+
+bool RingBuffer::push(Level level, std::string_view topic, Formatter formatter, const char* format, const void* args,
+                      std::size_t size) {
+    std::size_t pos;
+    Slot* slot = claim(pos);
+    if (slot == nullptr) return false;
+    slot->record.level = level;
+    slot->record.formatter = formatter;
+    slot->record.format = format;
+    copyTruncated(slot->record.topic, topic);
+    std::memcpy(slot->record.message, args, std::min(size, MAX_MESSAGE_LENGTH));
+    publish(slot, pos);
+    return true;
+}
+
+bool RingBuffer::pop(Record& record) {
+    const std::size_t pos = m_tail.load(std::memory_order_relaxed);
+    Slot& slot = m_slots[pos & m_mask];
+    // the slot hasn't been published yet, so the buffer is empty
+    if (slot.sequence.load(std::memory_order_acquire) != pos + 1) return false;
+    record = slot.record;
+    m_tail.store(pos + 1, std::memory_order_relaxed);
+    // hand the slot back to the writers
+    slot.sequence.store(pos + m_mask + 1, std::memory_order_release);
+    return true;
+}
+
+std::uint32_t RingBuffer::getDropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+std::uint32_t RingBuffer::getTruncated() const { return m_truncated.load(std::memory_order_relaxed); }
+
+std::size_t RingBuffer::getCapacity() const { return m_mask + 1; }
+} // namespace logger
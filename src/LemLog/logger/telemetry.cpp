@@ -0,0 +1,242 @@
+#include "LemLog/logger/telemetry.hpp"
+#include <algorithm>
+
+namespace logger {
+std::size_t cobsEncode(const std::uint8_t* in, std::size_t length, std::uint8_t* out) {
+    std::size_t codeIndex = 0;
+    std::size_t outIndex = 1;
+    std::uint8_t code = 1;
+    for (std::size_t i = 0; i < length; i++) {
+        if (in[i] != 0) {
+            out[outIndex++] = in[i];
+            code++;
+        }
+        // end the block at a zero byte, or when it is as long as a block can be
+        if (in[i] == 0 || code == 0xFF) {
+            out[codeIndex] = code;
+            code = 1;
+            codeIndex = outIndex++;
+        }
+    }
+    out[codeIndex] = code;
+    return outIndex;
+}
+
+std::size_t cobsDecode(const std::uint8_t* in, std::size_t length, std::uint8_t* out) {
+    std::size_t outIndex = 0;
+    std::size_t i = 0;
+    while (i < length) {
+        const std::uint8_t code = in[i++];
+        if (code == 0 || i + code - 1 > length) return 0;
+        for (std::uint8_t j = 1; j < code; j++) out[outIndex++] = in[i++];
+        // a zero byte follows every block that isn't full, except the last
+        if (code != 0xFF && i < length) out[outIndex++] = 0;
+    }
+    return outIndex;
+}
+
+Telemetry::Telemetry(std::FILE* stream, std::uint32_t (*clock)())
+    : m_stream(stream),
+      m_clock(clock) {}
+
+std::uint8_t Telemetry::addChannel(std::string_view name,
+                                   std::initializer_list<std::pair<std::string_view, telemetry::FieldType>> fields) {
+    ChannelInfo info;
+    info.name = name;
+    for (const auto& [fieldName, type] : fields) info.fields.emplace_back(fieldName, type);
+    m_channels.push_back(std::move(info));
+    const std::uint8_t id = m_channels.size() - 1;
+    sendSchema(id);
+    return id;
+}
+
+void Telemetry::resendSchemas() {
+    for (std::size_t i = 0; i < m_channels.size(); i++) sendSchema(i);
+}
+
+std::uint32_t Telemetry::getDropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+/**
+ * @brief append a length-prefixed string to a packet, truncating it to 255 characters
+ */
+static void appendString(std::uint8_t* packet, std::size_t& length, std::string_view str) {
+    const std::size_t size = std::min<std::size_t>(str.size(), 0xFF);
+    packet[length++] = size;
+    std::memcpy(packet + length, str.data(), size);
+    length += size;
+}
+
+void Telemetry::sendSchema(std::uint8_t id) {
+    const ChannelInfo& info = m_channels[id];
+    // check the schema fits in a packet before building it. After the stream ID come the packet type, the channel
+    // ID, the length of the name, the name, and the number of fields
+    std::size_t size = telemetry::STREAM_ID.size() + 4 + std::min<std::size_t>(info.name.size(), 0xFF);
+    for (const auto& field : info.fields) size += 2 + std::min<std::size_t>(field.first.size(), 0xFF);
+    if (size > MAX_TELEMETRY_PACKET) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    std::uint8_t packet[MAX_TELEMETRY_PACKET];
+    std::memcpy(packet, telemetry::STREAM_ID.data(), telemetry::STREAM_ID.size());
+    std::size_t length = telemetry::STREAM_ID.size();
+    packet[length++] = std::uint8_t(telemetry::PacketType::SCHEMA);
+    packet[length++] = id;
+    appendString(packet, length, info.name);
+    packet[length++] = info.fields.size();
+    for (const auto& [fieldName, type] : info.fields) {
+        packet[length++] = std::uint8_t(type);
+        appendString(packet, length, fieldName);
+    }
+    if (!writePacket(packet, length)) m_dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Telemetry::sendSample(std::uint8_t id, const std::uint8_t* payload, std::size_t length) {
+    std::uint8_t packet[MAX_TELEMETRY_PACKET];
+    std::memcpy(packet, telemetry::STREAM_ID.data(), telemetry::STREAM_ID.size());
+    std::size_t size = telemetry::STREAM_ID.size();
+    packet[size++] = std::uint8_t(telemetry::PacketType::SAMPLE);
+    packet[size++] = id;
+    const std::uint32_t timestamp = m_clock();
+    std::memcpy(packet + size, &timestamp, sizeof(timestamp));
+    size += sizeof(timestamp);
+    std::memcpy(packet + size, payload, length);
+    size += length;
+    if (!writePacket(packet, size)) m_dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool Telemetry::writePacket(const std::uint8_t* packet, std::size_t length) {
+    // leading and trailing delimiter, plus COBS overhead
+    std::uint8_t frame[MAX_TELEMETRY_PACKET + MAX_TELEMETRY_PACKET / 254 + 3];
+    frame[0] = 0;
+    std::size_t size = 1 + cobsEncode(packet, length, frame + 1);
+    frame[size++] = 0;
+    // a single write, so frames from different tasks don't interleave
+    return std::fwrite(frame, 1, size, m_stream) == size;
+}
+
+TelemetryDecoder::TelemetryDecoder(
+    std::function<void(const Schema&)> onSchema,
+    std::function<void(const Schema&, std::uint32_t, const std::vector<double>&)> onSample)
+    : m_onSchema(std::move(onSchema)),
+      m_onSample(std::move(onSample)) {}
+
+std::uint32_t TelemetryDecoder::getMalformed() const { return m_malformed; }
+
+void TelemetryDecoder::feed(const std::uint8_t* data, std::size_t length) {
+    for (std::size_t i = 0; i < length; i++) {
+        if (data[i] != 0) {
+            m_frame.push_back(data[i]);
+            continue;
+        }
+        if (!m_frame.empty()) decodeFrame(m_frame, 0);
+        m_frame.clear();
+    }
+}
+
+void TelemetryDecoder::decodeFrame(const std::vector<std::uint8_t>& frame, int depth) {
+    std::vector<std::uint8_t> decoded(frame.size());
+    const std::size_t length = cobsDecode(frame.data(), frame.size(), decoded.data());
+    if (length < telemetry::STREAM_ID.size()) {
+        m_malformed++;
+        return;
+    }
+    if (std::equal(telemetry::STREAM_ID.begin(), telemetry::STREAM_ID.end(), decoded.begin())) {
+        decodePacket(decoded.data() + telemetry::STREAM_ID.size(), length - telemetry::STREAM_ID.size());
+    } else if (depth == 0 &&
+               std::equal(telemetry::PROS_STDOUT_ID.begin(), telemetry::PROS_STDOUT_ID.end(), decoded.begin())) {
+        // stdout wrapped by the kernel. Telemetry frames may be split across several kernel frames
+        for (std::size_t i = telemetry::PROS_STDOUT_ID.size(); i < length; i++) {
+            if (decoded[i] != 0) {
+                m_innerFrame.push_back(decoded[i]);
+                continue;
+            }
+            if (!m_innerFrame.empty()) decodeFrame(m_innerFrame, depth + 1);
+            m_innerFrame.clear();
+        }
+    }
+}
+
+void TelemetryDecoder::decodePacket(const std::uint8_t* packet, std::size_t length) {
+    std::size_t i = 0;
+    auto remaining = [&] { return length - i; };
+    auto readString = [&](std::string& out) {
+        if (remaining() < 1 || remaining() - 1 < packet[i]) return false;
+        const std::size_t size = packet[i++];
+        out.assign(reinterpret_cast<const char*>(packet + i), size);
+        i += size;
+        return true;
+    };
+    if (remaining() < 2) {
+        m_malformed++;
+        return;
+    }
+    const auto type = telemetry::PacketType(packet[i++]);
+    const std::uint8_t id = packet[i++];
+
+    if (type == telemetry::PacketType::SCHEMA) {
+        Schema schema;
+        schema.id = id;
+        if (!readString(schema.name) || remaining() < 1) {
+            m_malformed++;
+            return;
+        }
+        const std::size_t count = packet[i++];
+        for (std::size_t f = 0; f < count; f++) {
+            std::string name;
+            if (remaining() < 1) {
+                m_malformed++;
+                return;
+            }
+            const auto fieldType = telemetry::FieldType(packet[i++]);
+            if (!readString(name)) {
+                m_malformed++;
+                return;
+            }
+            schema.fields.emplace_back(std::move(name), fieldType);
+        }
+        // replace the old schema if it is being resent
+        auto existing = std::find_if(m_schemas.begin(), m_schemas.end(), [&](const Schema& s) { return s.id == id; });
+        if (existing != m_schemas.end()) *existing = schema;
+        else m_schemas.push_back(schema);
+        if (m_onSchema) m_onSchema(schema);
+    } else if (type == telemetry::PacketType::SAMPLE) {
+        auto schema = std::find_if(m_schemas.begin(), m_schemas.end(), [&](const Schema& s) { return s.id == id; });
+        // samples received before their schema can't be decoded
+        if (schema == m_schemas.end()) return;
+        std::uint32_t timestamp;
+        if (remaining() != sizeof(timestamp) + schema->fields.size() * 4) {
+            m_malformed++;
+            return;
+        }
+        std::memcpy(&timestamp, packet + i, sizeof(timestamp));
+        i += sizeof(timestamp);
+        m_values.clear();
+        for (const auto& field : schema->fields) {
+            switch (field.second) {
+                case telemetry::FieldType::F32: {
+                    float value;
+                    std::memcpy(&value, packet + i, sizeof(value));
+                    m_values.push_back(value);
+                    break;
+                }
+                case telemetry::FieldType::I32: {
+                    std::int32_t value;
+                    std::memcpy(&value, packet + i, sizeof(value));
+                    m_values.push_back(value);
+                    break;
+                }
+                default: {
+                    std::uint32_t value;
+                    std::memcpy(&value, packet + i, sizeof(value));
+                    m_values.push_back(value);
+                    break;
+                }
+            }
+            i += 4;
+        }
+        if (m_onSample) m_onSample(*schema, timestamp, m_values);
+    } else {
+        m_malformed++;
+    }
+}
+} // namespace logger
@@ -0,0 +1,78 @@
+#include "LemLog/logger/topic.hpp"
+#include <string>
+
+namespace logger {
+/**
+ * IDs of interned topics. The slot of a topic is its index in this array. Slots are claimed in order with a compare
+ * and swap, so two tasks interning the same topic at the same time always agree on its slot.
+ */
+static std::array<std::atomic<std::uint32_t>, MAX_TOPICS> topicIds {};
+
+/** filter bits, one per slot */
+static constexpr std::size_t FILTER_WORDS = (MAX_TOPICS + 31) / 32;
+static std::array<std::atomic<std::uint32_t>, FILTER_WORDS> whitelist {};
+static std::array<std::atomic<std::uint32_t>, FILTER_WORDS> blacklist {};
+
+/** ring buffers of Async sinks. Deferred records are pushed to the first one */
+static constexpr std::size_t MAX_DEFERRED_BUFFERS = 4;
+static std::array<std::atomic<RingBuffer*>, MAX_DEFERRED_BUFFERS> deferredBuffers {};
+
+std::size_t internTopic(std::uint32_t id) {
+    for (std::size_t i = 0; i < MAX_TOPICS; i++) {
+        std::uint32_t current = topicIds[i].load(std::memory_order_acquire);
+        if (current == 0 && topicIds[i].compare_exchange_strong(current, id, std::memory_order_acq_rel)) return i;
+        // either the slot was already taken, or another task just took it
+        if (current == id) return i;
+    }
+    // out of slots, share the last one
+    return MAX_TOPICS - 1;
+}
+
+static bool testBit(const std::array<std::atomic<std::uint32_t>, FILTER_WORDS>& bits, std::size_t slot) {
+    return bits[slot / 32].load(std::memory_order_relaxed) & (1u << (slot % 32));
+}
+
+static void setBit(std::array<std::atomic<std::uint32_t>, FILTER_WORDS>& bits, std::size_t slot) {
+    bits[slot / 32].fetch_or(1u << (slot % 32), std::memory_order_relaxed);
+}
+
+bool isTopicEnabled(std::size_t slot, Level level) {
+    if (level == Level::DEBUG) return testBit(whitelist, slot);
+    return !testBit(blacklist, slot);
+}
+
+void whitelistTopic(std::string_view topic) {
+    setBit(whitelist, internTopic(hashTopic(topic)));
+    addWhitelist(std::string(topic));
+}
+
+void blacklistTopic(std::string_view topic) {
+    setBit(blacklist, internTopic(hashTopic(topic)));
+    addBlacklist(std::string(topic));
+}
+
+void registerDeferredBuffer(RingBuffer* buffer) {
+    for (std::atomic<RingBuffer*>& slot : deferredBuffers) {
+        RingBuffer* expected = nullptr;
+        if (slot.compare_exchange_strong(expected, buffer)) return;
+    }
+}
+
+void unregisterDeferredBuffer(RingBuffer* buffer) {
+    for (std::atomic<RingBuffer*>& slot : deferredBuffers) {
+        RingBuffer* expected = buffer;
+        slot.compare_exchange_strong(expected, nullptr);
+    }
+}
+
+bool pushDeferred(Level level, std::string_view topic, Formatter formatter, const char* format, const void* args,
+                  std::size_t size) {
+    for (std::atomic<RingBuffer*>& slot : deferredBuffers) {
+        RingBuffer* buffer = slot.load(std::memory_order_acquire);
+        if (buffer == nullptr) continue;
+        buffer->push(level, topic, formatter, format, args, size);
+        return true;
+    }
+    return false;
+}
+} // namespace logger
@@ -0,0 +1,124 @@
+#include "hardware/encoder/VelocityEstimator.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+
+namespace lemlib {
+VelocityEstimator::VelocityEstimator(Method method)
+    : m_method(method) {}
+
+VelocityEstimator VelocityEstimator::tracker(double alpha, double beta, double gamma) {
+    VelocityEstimator estimator(Method::TRACKER);
+    estimator.m_alpha = std::clamp(alpha, 0.0, 1.0);
+    estimator.m_beta = std::clamp(beta, 0.0, 1.0);
+    estimator.m_gamma = std::clamp(gamma, 0.0, 1.0);
+    return estimator;
+}
+
+VelocityEstimator VelocityEstimator::window(std::size_t size) {
+    VelocityEstimator estimator(Method::WINDOW);
+    estimator.m_size = std::clamp(size, std::size_t(3), MAX_VELOCITY_WINDOW);
+    return estimator;
+}
+
+int VelocityEstimator::update(Angle angle, Time time) {
+    const double z = angle.internal();
+    const double t = time.internal();
+    // NaN fails the comparison, so it is rejected too
+    if (!std::isfinite(z) || !std::isfinite(t) || (m_count > 0 && !(t > m_time))) {
+        errno = EINVAL;
+        return INT_MAX;
+    }
+    if (m_method == Method::TRACKER) updateTracker(z, t);
+    else updateWindow(z, t);
+    m_time = t;
+    return 0;
+}
+
+void VelocityEstimator::updateTracker(double angle, double time) {
+    if (m_count == 0) {
+        m_angle = angle;
+        m_count = 1;
+        return;
+    }
+    const double dt = time - m_time;
+    // predict the sample from the previous estimate, then correct the estimate by a fraction of the error
+    const double predicted = m_angle + m_velocity * dt + m_acceleration * dt * dt / 2;
+    const double error = angle - predicted;
+    m_angle = predicted + m_alpha * error;
+    m_velocity += m_acceleration * dt + m_beta * error / dt;
+    m_acceleration += 2 * m_gamma * error / (dt * dt);
+}
+
+void VelocityEstimator::updateWindow(double angle, double time) {
+    if (m_count == 0) m_origin = {time, angle};
+    if (m_count == m_size) {
+        accumulate(m_samples[m_head], -1);
+        m_samples[m_head] = {time, angle};
+        m_head = (m_head + 1) % m_size;
+    } else {
+        m_samples[(m_head + m_count) % m_size] = {time, angle};
+        m_count++;
+    }
+    accumulate({time, angle}, 1);
+    if (++m_sinceRebase >= m_size) rebase();
+
+    const auto& [s0, s1, s2, s3, s4] = m_timeSums;
+    const auto& [y0, y1, y2] = m_angleSums;
+    const double t = time - m_origin.time;
+    double c0 = y0 / s0;
+    double c1 = 0;
+    double c2 = 0;
+    // fit angle = c0 + c1 * t + c2 * t^2 with Cramer's rule, or a line if there aren't enough samples for a parabola
+    const double det = s0 * (s2 * s4 - s3 * s3) - s1 * (s1 * s4 - s2 * s3) + s2 * (s1 * s3 - s2 * s2);
+    if (m_count >= 3 && det != 0) {
+        c0 = (y0 * (s2 * s4 - s3 * s3) - s1 * (y1 * s4 - s3 * y2) + s2 * (y1 * s3 - s2 * y2)) / det;
+        c1 = (s0 * (y1 * s4 - s3 * y2) - y0 * (s1 * s4 - s2 * s3) + s2 * (s1 * y2 - y1 * s2)) / det;
+        c2 = (s0 * (s2 * y2 - y1 * s3) - s1 * (s1 * y2 - y1 * s2) + y0 * (s1 * s3 - s2 * s2)) / det;
+    } else if (m_count == 2) {
+        c1 = (s0 * y1 - s1 * y0) / (s0 * s2 - s1 * s1);
+        c0 = (y0 - c1 * s1) / s0;
+    }
+    m_angle = m_origin.angle + c0 + c1 * t + c2 * t * t;
+    m_velocity = c1 + 2 * c2 * t;
+    m_acceleration = 2 * c2;
+}
+
+void VelocityEstimator::rebase() {
+    m_sinceRebase = 0;
+    m_origin = m_samples[(m_head + m_count - 1) % m_size];
+    m_timeSums.fill(0);
+    m_angleSums.fill(0);
+    for (std::size_t i = 0; i < m_count; i++) accumulate(m_samples[(m_head + i) % m_size], 1);
+}
+
+void VelocityEstimator::accumulate(const Sample& sample, double sign) {
+    const double t = sample.time - m_origin.time;
+    const double y = sample.angle - m_origin.angle;
+    double power = sign;
+    for (std::size_t k = 0; k < m_timeSums.size(); k++) {
+        m_timeSums[k] += power;
+        if (k < m_angleSums.size()) m_angleSums[k] += power * y;
+        power *= t;
+    }
+}
+
+Angle VelocityEstimator::getAngle() const { return Angle(m_angle); }
+
+AngularVelocity VelocityEstimator::getVelocity() const { return AngularVelocity(m_velocity); }
+
+AngularAcceleration VelocityEstimator::getAcceleration() const { return AngularAcceleration(m_acceleration); }
+
+void VelocityEstimator::reset() {
+    m_angle = 0;
+    m_velocity = 0;
+    m_acceleration = 0;
+    m_time = 0;
+    m_count = 0;
+    m_head = 0;
+    m_sinceRebase = 0;
+    m_timeSums.fill(0);
+    m_angleSums.fill(0);
+}
+} // namespace lemlib
@@ -0,0 +1,381 @@
+#include "lemlib/CachedMotorGroup.hpp"
+#include "pros/device.h"
+#include "pros/error.h"
+#include "pros/rtos.hpp"
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <cmath>
+#include <errno.h>
+
+namespace lemlib {
+CachedMotorGroup::CachedMotorGroup(std::initializer_list<int> ports, AngularVelocity outputVelocity)
+    : m_outputVelocity(outputVelocity) {
+    for (const int port : ports) {
+        if (m_size == MAX_GROUP_MOTORS) break;
+        m_motors[m_size++] = {.port = port, .offset = 0_stDeg};
+    }
+}
+
+CachedMotorGroup::CachedMotorGroup(const pros::MotorGroup group, AngularVelocity outputVelocity)
+    : m_outputVelocity(outputVelocity) {
+    for (const int port : group.get_port_all()) {
+        if (m_size == MAX_GROUP_MOTORS) break;
+        m_motors[m_size++] = {.port = port, .offset = 0_stDeg};
+    }
+}
+
+Motor CachedMotorGroup::makeMotor(std::size_t i) const {
+    Motor motor(m_motors[i].port, m_outputVelocity);
+    motor.setOffset(m_motors[i].offset);
+    return motor;
+}
+
+/**
+ * @brief get the maximum velocity of the cartridge of a motor
+ */
+static AngularVelocity cartridgeVelocity(int port) {
+    switch (pros::c::motor_get_gearing(port)) {
+        case pros::E_MOTOR_GEARSET_36: return 100_rpm;
+        case pros::E_MOTOR_GEARSET_06: return 600_rpm;
+        default: return 200_rpm;
+    }
+}
+
+bool CachedMotorGroup::sample(std::size_t i, Motor& motor) {
+    const int port = m_motors[i].port;
+    // make sure the motor is using the brake mode of the group
+    if (m_brakeMode != BrakeMode::INVALID && motor.getBrakeMode() != m_brakeMode &&
+        motor.setBrakeMode(m_brakeMode) != 0)
+        return false;
+    m_snapshot.connected[i] = 1;
+    m_snapshot.angles[i] = motor.getAngle();
+    m_snapshot.velocities[i] =
+        m_outputVelocity * pros::c::motor_get_actual_velocity(port) / to_rpm(cartridgeVelocity(port));
+    const std::int32_t current = pros::c::motor_get_current_draw(port);
+    m_snapshot.currents[i] = current == PROS_ERR ? from_amp(INFINITY) : from_amp(current / 1000.0);
+    m_snapshot.temperatures[i] = motor.getTemperature();
+    return true;
+}
+
+Angle CachedMotorGroup::medianAngle() {
+    std::array<double, MAX_GROUP_MOTORS> angles;
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < m_size; i++) {
+        if (m_snapshot.connected[i] && to_stDeg(m_snapshot.angles[i]) != INFINITY) {
+            angles[count++] = m_snapshot.angles[i].internal();
+        }
+    }
+    if (count == 0) return m_lastAngle;
+    const auto middle = angles.begin() + count / 2;
+    std::nth_element(angles.begin(), middle, angles.begin() + count);
+    double median = *middle;
+    // the median of an even number of angles is the mean of the two in the middle
+    if (count % 2 == 0) median = (median + *std::max_element(angles.begin(), middle)) / 2;
+    m_lastAngle = Angle(median);
+    return m_lastAngle;
+}
+
+int CachedMotorGroup::update() {
+    m_snapshot.count = m_size;
+    m_snapshot.time = pros::millis();
+    m_stale = false;
+
+    // read the motors which are still configured, and find the ones which have just reconnected
+    std::uint8_t connected = 0;
+    std::uint8_t reconnected = 0;
+    for (std::size_t i = 0; i < m_size; i++) {
+        const std::uint8_t bit = 1 << i;
+        m_snapshot.ports[i] = m_motors[i].port;
+        m_snapshot.connected[i] = 0;
+        m_snapshot.angles[i] = from_stDeg(INFINITY);
+        m_snapshot.velocities[i] = from_rpm(INFINITY);
+        m_snapshot.currents[i] = from_amp(INFINITY);
+        m_snapshot.temperatures[i] = units::from_kelvin(INFINITY);
+
+        Motor motor = makeMotor(i);
+        if (!motor.isConnected()) {
+            // the motor may have lost its angle and brake mode, so it has to be configured again when it reconnects
+            m_unconfigured |= bit;
+            continue;
+        }
+        if (m_unconfigured & bit) reconnected |= bit;
+        else if (sample(i, motor)) connected |= bit;
+    }
+
+    // re-zero the reconnected motors against the motors read in this sweep, so it takes a single sweep
+    if (reconnected) {
+        const Angle reference = medianAngle();
+        for (std::size_t i = 0; i < m_size; i++) {
+            const std::uint8_t bit = 1 << i;
+            if (!(reconnected & bit)) continue;
+            Motor motor = makeMotor(i);
+            if (motor.setAngle(reference) != 0) continue;
+            m_motors[i].offset = motor.getOffset();
+            m_unconfigured &= ~bit;
+            if (sample(i, motor)) connected |= bit;
+        }
+    }
+    m_connected = connected;
+
+    Angle total = 0_stDeg;
+    int measured = 0;
+    for (std::size_t i = 0; i < m_size; i++) {
+        if (!m_snapshot.connected[i] || to_stDeg(m_snapshot.angles[i]) == INFINITY) continue;
+        total += m_snapshot.angles[i];
+        measured++;
+    }
+    if (m_connected == 0) {
+        errno = ENODEV;
+        return INT_MAX;
+    }
+    if (measured > 0) m_velocityEstimator.update(total / measured, from_sec(pros::micros() / 1e6));
+    return 0;
+}
+
+void CachedMotorGroup::refresh() {
+    if (m_stale || m_snapshot.time != pros::millis()) update();
+}
+
+const CachedMotorGroup::Snapshot& CachedMotorGroup::getSnapshot() {
+    refresh();
+    return m_snapshot;
+}
+
+int CachedMotorGroup::move(double percent) {
+    refresh();
+    m_controlling = false;
+    int success = INT_MAX;
+    for (std::size_t i = 0; i < m_size; i++) {
+        if (m_snapshot.connected[i] && makeMotor(i).move(percent) == 0) success = 0;
+    }
+    return success;
+}
+
+int CachedMotorGroup::moveVelocity(AngularVelocity velocity) {
+    refresh();
+    if (m_velocityController) return controlVelocity(velocity, std::nullopt);
+    int success = INT_MAX;
+    for (std::size_t i = 0; i < m_size; i++) {
+        if (m_snapshot.connected[i] && makeMotor(i).moveVelocity(velocity) == 0) success = 0;
+    }
+    return success;
+}
+
+int CachedMotorGroup::moveVelocity(AngularVelocity velocity, AngularAcceleration acceleration) {
+    refresh();
+    if (m_velocityController) return controlVelocity(velocity, acceleration);
+    return moveVelocity(velocity);
+}
+
+int CachedMotorGroup::controlVelocity(AngularVelocity target, std::optional<AngularAcceleration> acceleration) {
+    const AngularVelocity measured = getVelocity();
+    if (to_rpm(measured) == INFINITY) return INT_MAX;
+    const Time now = from_sec(pros::micros() / 1e6);
+    const Time dt = now - m_lastControl;
+    Voltage output = 0_volt;
+    if (m_controlling && dt > 0_sec && dt <= VELOCITY_CONTROL_TIMEOUT) {
+        // a step in the target would be a huge acceleration, so the estimate is limited to what the motors can do
+        const AngularAcceleration limit = m_velocityController->maxAcceleration();
+        const AngularAcceleration estimate = units::clamp((target - m_lastTarget) / dt, -1.0 * limit, limit);
+        output = m_velocityController->update(target, acceleration.value_or(estimate), measured, dt);
+    } else {
+        // the integral and previous error are stale, so start again, assuming a typical period
+        m_velocityController->reset();
+        output = m_velocityController->update(target, acceleration.value_or(0_rpm2), measured, 10_msec);
+    }
+    if (to_volt(output) == INFINITY) return INT_MAX;
+    m_controlling = true;
+    m_lastTarget = target;
+    m_lastControl = now;
+    // full power is the full 12 volts of the battery
+    const double percent = to_volt(output) / 12;
+    int success = INT_MAX;
+    for (std::size_t i = 0; i < m_size; i++) {
+        if (m_snapshot.connected[i] && makeMotor(i).move(percent) == 0) success = 0;
+    }
+    return success;
+}
+
+void CachedMotorGroup::setVelocityController(std::optional<VelocityController> controller) {
+    // the controller has constant gains, so it is replaced rather than assigned
+    if (controller) m_velocityController.emplace(*controller);
+    else m_velocityController.reset();
+    m_controlling = false;
+}
+
+int CachedMotorGroup::brake() {
+    refresh();
+    m_controlling = false;
+    int success = INT_MAX;
+    for (std::size_t i = 0; i < m_size; i++) {
+        if (m_snapshot.connected[i] && makeMotor(i).brake() == 0) success = 0;
+    }
+    return success;
+}
+
+int CachedMotorGroup::setBrakeMode(BrakeMode mode) {
+    m_brakeMode = mode;
+    // the brake mode is applied to every motor by the next sweep
+    update();
+    return 0;
+}
+
+BrakeMode CachedMotorGroup::getBrakeMode() { return m_brakeMode; }
+
+int CachedMotorGroup::isConnected() {
+    refresh();
+    return m_connected != 0;
+}
+
+Angle CachedMotorGroup::getAngle() {
+    refresh();
+    Angle total = 0_stDeg;
+    int count = 0;
+    for (std::size_t i = 0; i < m_snapshot.count; i++) {
+        if (!m_snapshot.connected[i] || to_stDeg(m_snapshot.angles[i]) == INFINITY) continue;
+        total += m_snapshot.angles[i];
+        count++;
+    }
+    if (count == 0) {
+        errno = ENODEV;
+        return from_stDeg(INFINITY);
+    }
+    return total / count;
+}
+
+AngularVelocity CachedMotorGroup::getVelocity() {
+    refresh();
+    AngularVelocity total = 0_rpm;
+    int count = 0;
+    for (std::size_t i = 0; i < m_snapshot.count; i++) {
+        if (!m_snapshot.connected[i] || to_rpm(m_snapshot.velocities[i]) == INFINITY) continue;
+        total += m_snapshot.velocities[i];
+        count++;
+    }
+    if (count == 0) {
+        errno = ENODEV;
+        return from_rpm(INFINITY);
+    }
+    return total / count;
+}
+
+int CachedMotorGroup::setAngle(Angle angle) {
+    refresh();
+    int success = INT_MAX;
+    for (std::size_t i = 0; i < m_size; i++) {
+        if (!m_snapshot.connected[i]) continue;
+        Motor motor = makeMotor(i);
+        if (motor.setAngle(angle) != 0) continue;
+        success = 0;
+        m_motors[i].offset = motor.getOffset();
+    }
+    // the average angle jumps, which isn't a real velocity
+    m_velocityEstimator.reset();
+    m_stale = true;
+    return success;
+}
+
+AngularAcceleration CachedMotorGroup::getAcceleration() {
+    refresh();
+    return m_velocityEstimator.getAcceleration();
+}
+
+void CachedMotorGroup::setVelocityEstimator(const VelocityEstimator& estimator) { m_velocityEstimator = estimator; }
+
+Current CachedMotorGroup::getCurrentLimit() {
+    refresh();
+    Current total = 0_amp;
+    int count = 0;
+    for (std::size_t i = 0; i < m_size; i++) {
+        if (!m_snapshot.connected[i]) continue;
+        const Current limit = makeMotor(i).getCurrentLimit();
+        if (to_amp(limit) == INFINITY) continue;
+        total += limit;
+        count++;
+    }
+    if (count == 0) return from_amp(INFINITY);
+    return total;
+}
+
+int CachedMotorGroup::setCurrentLimit(Current limit) {
+    const int size = getSize();
+    if (size == 0) {
+        errno = ENODEV;
+        return INT_MAX;
+    }
+    // split the limit evenly between the connected motors
+    int success = INT_MAX;
+    for (std::size_t i = 0; i < m_size; i++) {
+        if (m_snapshot.connected[i] && makeMotor(i).setCurrentLimit(limit / size) != INT_MAX) success = 0;
+    }
+    return success;
+}
+
+std::vector<Temperature> CachedMotorGroup::getTemperatures() {
+    refresh();
+    std::vector<Temperature> temperatures;
+    for (std::size_t i = 0; i < m_snapshot.count; i++) {
+        if (m_snapshot.connected[i]) temperatures.push_back(m_snapshot.temperatures[i]);
+    }
+    return temperatures;
+}
+
+int CachedMotorGroup::getSize() {
+    refresh();
+    return std::popcount(m_connected);
+}
+
+int CachedMotorGroup::addMotor(int port) {
+    // check that the motor isn't already in the group
+    for (std::size_t i = 0; i < m_size; i++) {
+        if (std::abs(m_motors[i].port) == std::abs(port)) {
+            errno = EEXIST;
+            return INT_MAX;
+        }
+    }
+    if (m_size == MAX_GROUP_MOTORS) {
+        errno = ENOMEM;
+        return INT_MAX;
+    }
+    // zero the motor against the angles the group has already read
+    refresh();
+    const std::size_t i = m_size++;
+    m_motors[i] = {.port = port, .offset = 0_stDeg};
+    Motor motor = makeMotor(i);
+    const bool configured = motor.isConnected() && motor.setAngle(medianAngle()) == 0;
+    // if the motor couldn't be configured, it is configured by the first sweep after it connects
+    if (configured) m_motors[i].offset = motor.getOffset();
+    else m_unconfigured |= 1 << i;
+    m_stale = true;
+    if (configured) return 0;
+    errno = ENODEV;
+    return INT_MAX;
+}
+
+int CachedMotorGroup::addMotor(Motor motor) { return addMotor(motor.getPort()); }
+
+int CachedMotorGroup::addMotor(Motor motor, bool reversed) {
+    motor.setReversed(reversed);
+    return addMotor(motor);
+}
+
+void CachedMotorGroup::removeMotor(int port) {
+    for (std::size_t i = 0; i < m_size; i++) {
+        if (std::abs(m_motors[i].port) != std::abs(port)) continue;
+        std::move(m_motors.begin() + i + 1, m_motors.begin() + m_size, m_motors.begin() + i);
+        m_size--;
+        // the bits of the motors after the removed one move down with them
+        const auto remove = [i](std::uint8_t mask) {
+            const std::uint8_t below = (1 << i) - 1;
+            return std::uint8_t((mask & below) | ((mask >> 1) & ~below));
+        };
+        m_connected = remove(m_connected);
+        m_unconfigured = remove(m_unconfigured);
+        break;
+    }
+    m_stale = true;
+}
+
+void CachedMotorGroup::removeMotor(Motor motor) { removeMotor(motor.getPort()); }
+} // namespace lemlib
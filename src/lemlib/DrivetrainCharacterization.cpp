@@ -0,0 +1,143 @@
+#include "lemlib/DrivetrainCharacterization.hpp"
+#include <array>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+
+namespace lemlib {
+DrivetrainFit::DrivetrainFit(std::size_t window, AngularVelocity minimumVelocity)
+    : m_sampler(window),
+      m_fit(minimumVelocity) {}
+
+int DrivetrainFit::add(const DrivetrainRecord& record) {
+    const double left = record.leftAngle.internal();
+    const double right = record.rightAngle.internal();
+    const double rotation = record.rotation.internal();
+    const bool valid = std::isfinite(left) && std::isfinite(right) && std::isfinite(rotation) &&
+                       std::isfinite(record.time.internal()) && (!m_started || record.time > m_previous.time);
+    if (valid) {
+        // the voltages of the previous sample were applied until this one
+        const Voltage voltage = (m_previous.leftVoltage + m_previous.rightVoltage) / 2;
+        m_sampler.update(voltage, Angle((left + right) / 2), record.time, m_fit);
+        const bool turning = m_previous.test == DrivetrainTest::TURN_COUNTERCLOCKWISE ||
+                             m_previous.test == DrivetrainTest::TURN_CLOCKWISE;
+        if (m_started && turning) {
+            const double difference = (right - left) - (m_previous.rightAngle - m_previous.leftAngle).internal();
+            const double turned = rotation - m_previous.rotation.internal();
+            m_turnProduct += difference * turned;
+            m_turnSquare += turned * turned;
+        }
+        if (record.test == DrivetrainTest::QUASISTATIC_FORWARD && !m_forwardStarted) {
+            m_forwardStart = (left + right) / 2;
+            m_forwardStarted = true;
+        }
+        if (record.test == DrivetrainTest::QUASISTATIC_BACKWARD) m_forwardEnded = m_forwardStarted;
+        if (m_forwardStarted && !m_forwardEnded) m_forwardEnd = (left + right) / 2;
+        m_previous.leftAngle = record.leftAngle;
+        m_previous.rightAngle = record.rightAngle;
+        m_previous.rotation = record.rotation;
+        m_previous.time = record.time;
+        m_started = true;
+    }
+    // the voltages of a skipped sample were still applied, and the next valid sample measures how far the robot
+    // moved since the last valid one
+    if (record.test != m_previous.test) m_sampler.restart();
+    m_previous.test = record.test;
+    m_previous.leftVoltage = record.leftVoltage;
+    m_previous.rightVoltage = record.rightVoltage;
+    if (valid) return 0;
+    errno = EINVAL;
+    return INT_MAX;
+}
+
+DrivetrainConstants DrivetrainFit::solve(Length wheelDiameter, Length distance) const {
+    const DrivetrainConstants failed = {from_volt(INFINITY), from_volt(INFINITY) / 1_mps, from_volt(INFINITY) / 1_mps2,
+                                        from_m(INFINITY), from_m(INFINITY)};
+    const FeedforwardGains wheel = m_fit.solve();
+    if (to_volt(wheel.kS) == INFINITY) return failed;
+    const double travelled = std::abs(m_forwardEnd - m_forwardStart);
+    if (m_turnSquare == 0 || (distance != 0_in && travelled == 0)) {
+        errno = EDOM;
+        return failed;
+    }
+    // the robot moves a radius for every radian its wheels turn
+    const double radius = distance != 0_in ? to_m(distance) / travelled : to_m(wheelDiameter) / 2;
+    // turning in place, the difference between the velocities of the sides is the angular velocity times the track
+    // width
+    const double trackWidth = radius * std::abs(m_turnProduct / m_turnSquare);
+    return {wheel.kS, from_volt(to_volt(wheel.kV * 1_radps) / radius) / 1_mps,
+            from_volt(to_volt(wheel.kA * 1_radps2) / radius) / 1_mps2, from_m(trackWidth), from_m(2 * radius)};
+}
+
+const FeedforwardFit& DrivetrainFit::getFeedforwardFit() const { return m_fit; }
+
+DrivetrainCharacterization::DrivetrainCharacterization(Encoder& left, Encoder& right, Imu& imu,
+                                                       logger::Telemetry& telemetry, CharacterizationConfig config)
+    : m_left(left),
+      m_right(right),
+      m_imu(imu),
+      m_channel(telemetry, "characterization/drivetrain",
+                {"test", "left_V", "right_V", "left_rad", "right_rad", "rotation_rad"}),
+      m_config(config),
+      m_fit(config.window) {}
+
+/**
+ * @brief get the test running at a time since the start of a characterization, and how long it has been running
+ */
+static std::pair<DrivetrainTest, Time> schedule(const CharacterizationConfig& config, Time elapsed) {
+    const std::array<std::pair<DrivetrainTest, Time>, 6> tests = {{
+        {DrivetrainTest::QUASISTATIC_FORWARD, config.rampDuration},
+        {DrivetrainTest::QUASISTATIC_BACKWARD, config.rampDuration},
+        {DrivetrainTest::DYNAMIC_FORWARD, config.stepDuration},
+        {DrivetrainTest::DYNAMIC_BACKWARD, config.stepDuration},
+        {DrivetrainTest::TURN_COUNTERCLOCKWISE, config.rampDuration},
+        {DrivetrainTest::TURN_CLOCKWISE, config.rampDuration},
+    }};
+    for (const auto& [test, duration] : tests) {
+        if (elapsed < duration) return {test, elapsed};
+        elapsed -= duration;
+        if (elapsed < config.restDuration) return {DrivetrainTest::REST, elapsed};
+        elapsed -= config.restDuration;
+    }
+    return {DrivetrainTest::DONE, elapsed};
+}
+
+std::pair<Voltage, Voltage> DrivetrainCharacterization::update(Time time) {
+    if (m_test == DrivetrainTest::DONE) return {0_volt, 0_volt};
+    if (!m_started) {
+        m_start = time;
+        m_started = true;
+    }
+    const auto [test, running] = schedule(m_config, time - m_start);
+    const Voltage ramp = from_volt(m_config.rampRate * to_sec(running));
+    const Voltage step = m_config.stepVoltage;
+    std::pair<Voltage, Voltage> output = {0_volt, 0_volt};
+    switch (test) {
+        case DrivetrainTest::QUASISTATIC_FORWARD: output = {ramp, ramp}; break;
+        case DrivetrainTest::QUASISTATIC_BACKWARD: output = {-1.0 * ramp, -1.0 * ramp}; break;
+        case DrivetrainTest::DYNAMIC_FORWARD: output = {step, step}; break;
+        case DrivetrainTest::DYNAMIC_BACKWARD: output = {-1.0 * step, -1.0 * step}; break;
+        case DrivetrainTest::TURN_COUNTERCLOCKWISE: output = {-1.0 * ramp, ramp}; break;
+        case DrivetrainTest::TURN_CLOCKWISE: output = {ramp, -1.0 * ramp}; break;
+        default: break;
+    }
+    const DrivetrainRecord record = {.test = test,
+                                     .leftVoltage = output.first,
+                                     .rightVoltage = output.second,
+                                     .leftAngle = m_left.getAngle(),
+                                     .rightAngle = m_right.getAngle(),
+                                     .rotation = m_imu.getRotation(),
+                                     .time = time};
+    m_channel.send(std::uint32_t(record.test), record.leftVoltage, record.rightVoltage, record.leftAngle,
+                   record.rightAngle, record.rotation);
+    m_fit.add(record);
+    m_test = test;
+    return output;
+}
+
+bool DrivetrainCharacterization::isDone() const { return m_test == DrivetrainTest::DONE; }
+
+DrivetrainTest DrivetrainCharacterization::getTest() const { return m_test; }
+
+const DrivetrainFit& DrivetrainCharacterization::getFit() const { return m_fit; }
+} // namespace lemlib
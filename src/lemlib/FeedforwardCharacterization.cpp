@@ -0,0 +1,136 @@
+#include "lemlib/FeedforwardCharacterization.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+
+namespace lemlib {
+FeedforwardFit::FeedforwardFit(AngularVelocity minimumVelocity)
+    : m_minimumVelocity(units::abs(minimumVelocity)) {}
+
+int FeedforwardFit::add(Voltage voltage, AngularVelocity velocity, AngularAcceleration acceleration) {
+    const double y = to_volt(voltage);
+    const std::array<double, 3> x = {double(units::sgn(velocity)), velocity.internal(), acceleration.internal()};
+    if (!std::isfinite(y) || !std::isfinite(x[1]) || !std::isfinite(x[2])) {
+        errno = EINVAL;
+        return INT_MAX;
+    }
+    if (units::abs(velocity) < m_minimumVelocity) return 0;
+    for (std::size_t i = 0; i < 3; i++) {
+        for (std::size_t j = 0; j < 3; j++) m_xx[i][j] += x[i] * x[j];
+        m_xy[i] += x[i] * y;
+    }
+    m_yy += y * y;
+    m_count++;
+    return 0;
+}
+
+FeedforwardGains FeedforwardFit::solve() const {
+    // solve the normal equations with Cramer's rule
+    const auto det = [](const std::array<std::array<double, 3>, 3>& m) {
+        return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+               m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+    };
+    const double d = det(m_xx);
+    // the determinant scales with the sums, so compare it to the product of the diagonal to tell if it is singular
+    if (m_count < 3 || !(std::abs(d) > 1e-9 * m_xx[0][0] * m_xx[1][1] * m_xx[2][2])) {
+        errno = EDOM;
+        return {from_volt(INFINITY), from_volt(INFINITY) / 1_radps, from_volt(INFINITY) / 1_radps2};
+    }
+    std::array<double, 3> gains;
+    for (std::size_t k = 0; k < 3; k++) {
+        std::array<std::array<double, 3>, 3> m = m_xx;
+        for (std::size_t i = 0; i < 3; i++) m[i][k] = m_xy[i];
+        gains[k] = det(m) / d;
+    }
+    return {from_volt(gains[0]), from_volt(gains[1]) / 1_radps, from_volt(gains[2]) / 1_radps2};
+}
+
+Voltage FeedforwardFit::rmsError(const FeedforwardGains& gains) const {
+    if (m_count == 0) return 0_volt;
+    const std::array<double, 3> b = {to_volt(gains.kS), to_volt(gains.kV * 1_radps), to_volt(gains.kA * 1_radps2)};
+    // sum of (V - x.b)^2 = sum V^2 - 2 b.(sum x V) + b.(sum x x^T).b
+    double error = m_yy;
+    for (std::size_t i = 0; i < 3; i++) {
+        error -= 2 * b[i] * m_xy[i];
+        for (std::size_t j = 0; j < 3; j++) error += b[i] * m_xx[i][j] * b[j];
+    }
+    // rounding can make a perfect fit slightly negative
+    return from_volt(std::sqrt(std::max(error, 0.0) / m_count));
+}
+
+std::size_t FeedforwardFit::getCount() const { return m_count; }
+
+void FeedforwardFit::reset() {
+    m_count = 0;
+    m_xx = {};
+    m_xy = {};
+    m_yy = 0;
+}
+
+CharacterizationSampler::CharacterizationSampler(std::size_t window)
+    : m_estimator(VelocityEstimator::window(window)),
+      m_delay((std::clamp(window, std::size_t(3), MAX_VELOCITY_WINDOW) - 1) / 2) {}
+
+int CharacterizationSampler::update(Voltage voltage, Angle angle, Time time, FeedforwardFit& fit) {
+    if (m_estimator.update(angle, time) != 0) return INT_MAX;
+    m_history[m_samples++ % m_history.size()] = {to_volt(voltage), m_estimator.getVelocity().internal()};
+    if (voltage == 0_volt || ++m_settled <= MAX_VELOCITY_WINDOW) return 0;
+    const Sample& middle = m_history[(m_samples - 1 - m_delay) % m_history.size()];
+    return fit.add(from_volt(middle.voltage), AngularVelocity(middle.velocity), m_estimator.getAcceleration());
+}
+
+void CharacterizationSampler::restart() { m_settled = 0; }
+
+FeedforwardCharacterization::FeedforwardCharacterization(CharacterizationConfig config, FeedforwardFit fit)
+    : m_config(config),
+      m_sampler(config.window),
+      m_fit(fit) {}
+
+int FeedforwardCharacterization::phase(Time elapsed) const {
+    // each test is followed by a rest, in the order: quasistatic forwards and backwards, dynamic forwards and backwards
+    const std::array<Time, 8> durations = {m_config.rampDuration, m_config.restDuration, m_config.rampDuration,
+                                           m_config.restDuration, m_config.stepDuration, m_config.restDuration,
+                                           m_config.stepDuration, m_config.restDuration};
+    for (std::size_t i = 0; i < durations.size(); i++) {
+        if (elapsed < durations[i]) return i;
+        elapsed -= durations[i];
+    }
+    return -1;
+}
+
+Voltage FeedforwardCharacterization::voltage(Time elapsed) const {
+    const int current = phase(elapsed);
+    // the rests, and the end, coast the motor
+    if (current < 0 || current % 2 == 1) return 0_volt;
+    const double direction = current % 4 == 0 ? 1 : -1;
+    if (current >= 4) return direction * m_config.stepVoltage;
+    const Time start = current == 0 ? 0_sec : m_config.rampDuration + m_config.restDuration;
+    return direction * from_volt(m_config.rampRate * to_sec(elapsed - start));
+}
+
+Voltage FeedforwardCharacterization::update(Angle angle, Time time) {
+    // the voltage from the last update was applied until this sample, so this sample shows how the motor responded
+    if (m_sampler.update(m_voltage, angle, time, m_fit) != 0) return from_volt(INFINITY);
+    if (!m_started) {
+        m_start = time;
+        m_started = true;
+    }
+    if (m_done) return 0_volt;
+    const Time elapsed = time - m_start;
+    const int next = phase(elapsed);
+    if (next != m_phase) {
+        m_phase = next;
+        m_sampler.restart();
+    }
+    m_done = next < 0;
+    m_voltage = voltage(elapsed);
+    return m_voltage;
+}
+
+bool FeedforwardCharacterization::isDone() const { return m_done; }
+
+FeedforwardGains FeedforwardCharacterization::getGains() const { return m_fit.solve(); }
+
+const FeedforwardFit& FeedforwardCharacterization::getFit() const { return m_fit; }
+} // namespace lemlib
@@ -1,23 +1,71 @@
 #include "lemlib/MotionCancelHelper.hpp"
+#include "lemlib/MotionHandler.hpp"
 #include "pros/rtos.hpp"
 #include "pros/misc.h"
+#include "LemLog/logger/topic.hpp"
+#include <algorithm>
+#include <cmath>
 
 namespace lemlib {
 MotionCancelHelper::MotionCancelHelper()
     : originalCompStatus(pros::c::competition_get_status()),
       prevTime(pros::millis()) {}
 
-bool MotionCancelHelper::wait(Time timeout) {
+using TimingLog = logger::Topic<"lemlib/motions/timing">;
+
+Time LoopStats::meanExecutionTime() const {
+    if (iterations == 0) return 0_sec;
+    return totalExecutionTime / iterations;
+}
+
+Time LoopStats::meanJitter() const {
+    if (iterations == 0) return 0_sec;
+    return totalJitter / iterations;
+}
+
+bool MotionCancelHelper::wait(Time timeout, bool exitCondition) {
+    // record how long the last iteration took
+    const std::uint64_t start = pros::micros();
+    if (!firstIteration) {
+        const Time executionTime = from_usec(start - iterationStart);
+        stats.iterations++;
+        stats.totalExecutionTime += executionTime;
+        stats.maxExecutionTime = units::max(stats.maxExecutionTime, executionTime);
+        if (executionTime > timeout) stats.overruns++;
+        const std::size_t bucket = std::size_t(to_usec(executionTime) * 4 / std::max(to_usec(timeout), 1.0));
+        stats.histogram[std::min(bucket, LoopStats::HISTOGRAM_BUCKETS - 1)]++;
+    }
+
+    // hand off to the next motion right away, without waiting for the rest of the period
+    if (exitCondition && motion_handler::queued() > 0) {
+        earlyExit = true;
+        return false;
+    }
+
     const std::uint32_t processedTimeout = to_msec(timeout);
     // if current time - previous time > timeout
     // then set previous time to current time
     // this is to prevent the motion iterating multiple times
     // with no delay in between
     const int64_t now = int64_t(pros::millis());
-    if (now - int64_t(prevTime) > int64_t(processedTimeout)) prevTime = now - processedTimeout;
+    if (now - int64_t(prevTime) > int64_t(processedTimeout)) {
+        prevTime = now - processedTimeout;
+        // the loop fell behind, so the schedule starts again
+        wakeTime = 0;
+    }
     // only delay if this is not the first iteration
-    if (!firstIteration) pros::Task::delay_until(&prevTime, processedTimeout);
-    else firstIteration = false;
+    if (!firstIteration) {
+        pros::Task::delay_until(&prevTime, processedTimeout);
+        const std::uint64_t woke = pros::micros();
+        // the millisecond ticks the scheduler wakes the loop on don't line up with the microsecond clock, so the
+        // scheduled wake times are anchored to the earliest wake, and are a period apart
+        if (wakeTime == 0 || woke < wakeTime) wakeTime = woke;
+        const Time jitter = from_usec(woke - wakeTime);
+        stats.totalJitter += jitter;
+        stats.maxJitter = units::max(stats.maxJitter, jitter);
+        wakeTime += std::uint64_t(processedTimeout) * 1000;
+    } else firstIteration = false;
+    iterationStart = pros::micros();
 
     // if the competition state is not the same as when the motion started, then stop the motion
     if (pros::c::competition_get_status() != originalCompStatus) return 0;
@@ -25,4 +73,16 @@ bool MotionCancelHelper::wait(Time timeout) {
     // check if there was a notification
     return pros::Task::notify_take(true, 0) == 0;
 }
+
+bool MotionCancelHelper::exitedEarly() const { return earlyExit; }
+
+const LoopStats& MotionCancelHelper::getStats() const { return stats; }
+
+void MotionCancelHelper::logStats(const char* name) const {
+    TimingLog::log(stats.overruns > 0 ? logger::Level::WARN : logger::Level::DEBUG,
+                   "%s: %u iters, exec %.2f/%.2f ms, jitter %.2f/%.2f ms, %u overruns",
+                   name, unsigned(stats.iterations), to_msec(stats.meanExecutionTime()),
+                   to_msec(stats.maxExecutionTime), to_msec(stats.meanJitter()), to_msec(stats.maxJitter),
+                   unsigned(stats.overruns));
+}
 } // namespace lemlib
\ No newline at end of file
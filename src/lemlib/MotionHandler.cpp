@@ -1,30 +1,134 @@
 #include "lemlib/MotionHandler.hpp"
+#include "pros/apix.h"
 #include "pros/rtos.hpp"
+#include <array>
+#include <mutex>
 
 namespace lemlib::motion_handler {
-// initialize tasks
-static std::optional<pros::Task> motionTask = std::nullopt;
+/**
+ * @brief state shared between the motion executor task and the tasks submitting motions
+ */
+struct Executor {
+        Executor()
+            : idle(pros::c::sem_create(1, 0)),
+              ready(pros::c::sem_create(1, 0)),
+              task([this] { run(); }, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, "LemLib motion executor") {}
 
-void move(std::function<void(void)> f) {
-    // wait until there is no motion running
-    while (isMoving()) pros::delay(5);
+        /**
+         * @brief run motions as they are queued, forever
+         */
+        void run() {
+            Motion motion;
+            while (true) {
+                std::unique_lock lock(mutex);
+                if (count == 0) {
+                    // sleep until a motion is queued
+                    lock.unlock();
+                    pros::c::sem_wait(ready, TIMEOUT_MAX);
+                    continue;
+                }
+                motion = std::move(motions[head]);
+                head = (head + 1) % MOTION_QUEUE_SIZE;
+                count--;
+                running = true;
+                lock.unlock();
+                // only start the motion if it hasn't been cancelled yet
+                if (pros::Task::notify_take(true, 0) == 0) motion();
+                motion.reset();
+                // clear notifications sent while the motion was ending, so they don't cancel the next motion
+                lock.lock();
+                pros::Task::notify_take(true, 0);
+                running = false;
+                const bool nowIdle = count == 0;
+                lock.unlock();
+                if (nowIdle) pros::c::sem_post(idle);
+            }
+        }
+
+        /**
+         * @brief add a motion to the queue. The mutex must be held
+         */
+        bool push(Motion&& motion) {
+            if (count == MOTION_QUEUE_SIZE) return false;
+            motions[(head + count) % MOTION_QUEUE_SIZE] = std::move(motion);
+            count++;
+            return true;
+        }
+
+        /** given when the executor finishes its last queued motion */
+        pros::c::sem_t idle;
+        /** given when a motion is queued, to wake up the executor */
+        pros::c::sem_t ready;
+        /** protects the queue and the running flag */
+        pros::Mutex mutex;
+        bool running = false;
+        std::array<Motion, MOTION_QUEUE_SIZE> motions;
+        std::size_t head = 0;
+        std::size_t count = 0;
+        pros::Task task;
+};
+
+/**
+ * @brief get the motion executor, creating it if it doesn't exist yet
+ */
+static Executor& executor() {
+    static Executor instance;
+    return instance;
+}
+
+void submit(Motion&& motion) {
+    Executor& e = executor();
+    // wait until there are no motions running or queued. The idle semaphore can be given while another task
+    // submits a motion, so check again after waking up
+    while (true) {
+        {
+            std::lock_guard lock(e.mutex);
+            if (!e.running && e.count == 0) {
+                e.push(std::move(motion));
+                break;
+            }
+        }
+        pros::c::sem_wait(e.idle, TIMEOUT_MAX);
+    }
     // start the new motion
-    motionTask = pros::Task([=] {
-        // only start the motion if it hasn't been cancelled yet
-        if (pros::Task::notify_take(true, 0) == 0) f();
-    });
+    pros::c::sem_post(e.ready);
+}
+
+bool enqueue(Motion&& motion) {
+    Executor& e = executor();
+    {
+        std::lock_guard lock(e.mutex);
+        if (!e.push(std::move(motion))) return false;
+    }
+    pros::c::sem_post(e.ready);
+    return true;
+}
+
+std::size_t queued() {
+    Executor& e = executor();
+    std::lock_guard lock(e.mutex);
+    return e.count;
 }
 
 bool isMoving() {
-    // check if the task exists
-    if (motionTask == std::nullopt) return false;
-    // check if the task is currently running
-    const std::uint32_t state = motionTask->get_state();
-    return state != pros::E_TASK_STATE_DELETED && state != pros::E_TASK_STATE_INVALID;
+    Executor& e = executor();
+    std::lock_guard lock(e.mutex);
+    return e.running || e.count != 0;
 }
 
 void cancel() {
-    // if the task is currently running, notify the task
-    if (isMoving()) motionTask->notify();
+    Executor& e = executor();
+    std::lock_guard lock(e.mutex);
+    // if a motion is currently running, notify the task
+    if (e.running) e.task.notify();
+}
+
+void cancelAll() {
+    Executor& e = executor();
+    std::lock_guard lock(e.mutex);
+    for (std::size_t i = 0; i < e.count; i++) e.motions[(e.head + i) % MOTION_QUEUE_SIZE].reset();
+    e.count = 0;
+    if (e.running) e.task.notify();
+    else pros::c::sem_post(e.idle);
 }
-} // namespace lemlib::motion_handler
\ No newline at end of file
+} // namespace lemlib::motion_handler
@@ -0,0 +1,286 @@
+#include "lemlib/MotionProfile.hpp"
+#include <algorithm>
+#include <cerrno>
+
+namespace lemlib {
+/** maximum distance between nodes of a subdivided path, in meters */
+constexpr double RESOLUTION = 0.01;
+/** minimum number of nodes each segment of a path is divided into. A move that starts and ends at rest needs a node
+ * in between, where the velocity limit isn't 0, or a trapezoidal profile could never cross it */
+constexpr int MIN_STEPS = 2;
+/** points of a path closer together than this are skipped, in meters */
+constexpr double MIN_SPACING = 1e-4;
+/** an S-curve profile is finished once it stops within this distance of the end, in meters */
+constexpr double END_TOLERANCE = 1e-3;
+/** slack on the squared velocity limits of an S-curve profile, in square meters per second squared */
+constexpr double LIMIT_TOLERANCE = 1e-9;
+/** times this close to an entry, as a fraction of the period, use that entry. A time calculated as n * period can
+ * round down to just before entry n, which would otherwise return the acceleration of entry n - 1 */
+constexpr double INDEX_EPSILON = 1e-6;
+/** upper limit on the number of entries in a table, so invalid input can't run forever */
+constexpr std::size_t MAX_ENTRIES = 1000000;
+
+/**
+ * @brief position of the cursor along a subdivided path
+ *
+ * Setpoints are generated in order of distance, so the node before a distance is found by moving the cursor forwards
+ * instead of searching.
+ */
+struct Cursor {
+        std::size_t node = 0;
+
+        template <typename Node> double fraction(const std::vector<Node>& nodes, double distance) {
+            while (node + 2 < nodes.size() && nodes[node + 1].distance <= distance) node++;
+            const double length = nodes[node + 1].distance - nodes[node].distance;
+            return std::clamp((distance - nodes[node].distance) / length, 0.0, 1.0);
+        }
+};
+
+MotionProfile MotionProfile::generate(const units::Vector2DArray<Length>& path, const ProfileConstraints& constraints,
+                                      Time period) {
+    // skip duplicate points, which have no direction
+    std::vector<std::pair<double, double>> points;
+    points.reserve(path.size());
+    for (std::size_t i = 0; i < path.size(); i++) {
+        const double x = path.xData()[i];
+        const double y = path.yData()[i];
+        if (!points.empty() && std::hypot(x - points.back().first, y - points.back().second) < MIN_SPACING) continue;
+        points.emplace_back(x, y);
+    }
+    if (points.size() < 2) {
+        errno = EINVAL;
+        return MotionProfile();
+    }
+    const std::size_t n = points.size();
+    // heading from the neighbouring points, unwrapped so it can be interpolated
+    std::vector<double> headings(n), curvatures(n);
+    for (std::size_t i = 0; i < n; i++) {
+        const auto& [x0, y0] = points[i == 0 ? 0 : i - 1];
+        const auto& [x1, y1] = points[i + 1 == n ? n - 1 : i + 1];
+        headings[i] = std::atan2(y1 - y0, x1 - x0);
+        if (i > 0) headings[i] = headings[i - 1] + std::remainder(headings[i] - headings[i - 1], 2 * M_PI);
+    }
+    // signed curvature of the circle through each point and its neighbours. The ends use the curvature next to them
+    for (std::size_t i = 1; i + 1 < n; i++) {
+        const auto& [ax, ay] = points[i - 1];
+        const auto& [bx, by] = points[i];
+        const auto& [cx, cy] = points[i + 1];
+        const double cross = (bx - ax) * (cy - by) - (by - ay) * (cx - bx);
+        curvatures[i] = 2 * cross / (std::hypot(bx - ax, by - ay) * std::hypot(cx - bx, cy - by) *
+                                     std::hypot(cx - ax, cy - ay));
+    }
+    if (n > 2) {
+        curvatures[0] = curvatures[1];
+        curvatures[n - 1] = curvatures[n - 2];
+    }
+    // subdivide the path, so the velocity limits are fine enough to interpolate
+    std::vector<Node> nodes;
+    double distance = 0;
+    for (std::size_t i = 0; i + 1 < n; i++) {
+        const auto& [x0, y0] = points[i];
+        const auto& [x1, y1] = points[i + 1];
+        const double length = std::hypot(x1 - x0, y1 - y0);
+        const int steps = std::max(MIN_STEPS, int(std::ceil(length / RESOLUTION)));
+        for (int j = 0; j < steps; j++) {
+            const double f = double(j) / steps;
+            nodes.push_back({distance + length * f, x0 + (x1 - x0) * f, y0 + (y1 - y0) * f,
+                             headings[i] + (headings[i + 1] - headings[i]) * f,
+                             curvatures[i] + (curvatures[i + 1] - curvatures[i]) * f, 0});
+        }
+        distance += length;
+    }
+    nodes.push_back({distance, points.back().first, points.back().second, headings.back(), curvatures.back(), 0});
+    return generate(nodes, constraints, period);
+}
+
+MotionProfile MotionProfile::generate(Length distance, const ProfileConstraints& constraints, Time period) {
+    if (!(distance > 0_m)) {
+        errno = EINVAL;
+        return MotionProfile();
+    }
+    const int steps = std::max(MIN_STEPS, int(std::ceil(distance.internal() / RESOLUTION)));
+    std::vector<Node> nodes;
+    nodes.reserve(steps + 1);
+    for (int i = 0; i <= steps; i++) {
+        const double s = distance.internal() * i / steps;
+        nodes.push_back({s, s, 0, 0, 0, 0});
+    }
+    return generate(nodes, constraints, period);
+}
+
+MotionProfile MotionProfile::generate(std::vector<Node>& nodes, const ProfileConstraints& constraints, Time period) {
+    const double maxVelocity = constraints.maxVelocity.internal();
+    const double maxAcceleration = constraints.maxAcceleration.internal();
+    const double maxJerk = constraints.maxJerk.internal();
+    const double maxLateral = constraints.maxLateralAcceleration.internal();
+    const double trackWidth = constraints.trackWidth.internal();
+    const double startVelocity = constraints.startVelocity.internal();
+    const double endVelocity = constraints.endVelocity.internal();
+    const double dt = period.internal();
+    // NaN fails every comparison, so it is rejected too
+    if (!(maxVelocity > 0) || !(maxAcceleration > 0) || !(maxJerk > 0) || !(maxLateral > 0) || !(trackWidth >= 0) ||
+        !(startVelocity >= 0) || !(endVelocity >= 0) || !(dt > 0) || std::isinf(maxVelocity) ||
+        std::isinf(maxAcceleration)) {
+        errno = EINVAL;
+        return MotionProfile();
+    }
+
+    // velocity limits from the curvature. Limits are stored squared, since v^2 is linear in distance at a constant
+    // acceleration
+    for (Node& node : nodes) {
+        const double curvature = std::abs(node.curvature);
+        double v = std::min(maxVelocity, maxVelocity / (1 + curvature * trackWidth / 2));
+        if (curvature > 0) v = std::min(v, std::sqrt(maxLateral / curvature));
+        node.limit = v * v;
+    }
+    nodes.front().limit = std::min(nodes.front().limit, startVelocity * startVelocity);
+    nodes.back().limit = std::min(nodes.back().limit, endVelocity * endVelocity);
+    // limit the velocity to what can be reached by accelerating from the start, and what can still decelerate to the
+    // end
+    for (std::size_t i = 0; i + 1 < nodes.size(); i++) {
+        const double ds = nodes[i + 1].distance - nodes[i].distance;
+        nodes[i + 1].limit = std::min(nodes[i + 1].limit, nodes[i].limit + 2 * maxAcceleration * ds);
+    }
+    for (std::size_t i = nodes.size() - 1; i > 0; i--) {
+        const double ds = nodes[i].distance - nodes[i - 1].distance;
+        nodes[i - 1].limit = std::min(nodes[i - 1].limit, nodes[i].limit + 2 * maxAcceleration * ds);
+    }
+
+    MotionProfile profile;
+    profile.m_period = period;
+    Cursor geometry;
+    const auto emit = [&](double distance, double velocity, double acceleration) {
+        const double f = geometry.fraction(nodes, distance);
+        const Node& a = nodes[geometry.node];
+        const Node& b = nodes[geometry.node + 1];
+        profile.m_entries.push_back({LengthF(distance), LinearVelocityF(velocity), LinearAccelerationF(acceleration),
+                                     CurvatureF(a.curvature + (b.curvature - a.curvature) * f),
+                                     LengthF(a.x + (b.x - a.x) * f), LengthF(a.y + (b.y - a.y) * f),
+                                     AngleF(a.heading + (b.heading - a.heading) * f)});
+    };
+    const double length = nodes.back().distance;
+
+    if (std::isinf(maxJerk)) {
+        // trapezoidal: the acceleration is constant between nodes, so the velocity limits are followed exactly
+        double segmentStart = 0;
+        std::size_t tick = 0;
+        for (std::size_t i = 0; i + 1 < nodes.size(); i++) {
+            const double ds = nodes[i + 1].distance - nodes[i].distance;
+            const double v0 = std::sqrt(nodes[i].limit);
+            const double v1 = std::sqrt(nodes[i + 1].limit);
+            const double acceleration = (nodes[i + 1].limit - nodes[i].limit) / (2 * ds);
+            const double segmentEnd = segmentStart + 2 * ds / (v0 + v1);
+            for (; tick * dt < segmentEnd && tick < MAX_ENTRIES; tick++) {
+                const double t = tick * dt - segmentStart;
+                emit(std::min(nodes[i].distance + v0 * t + acceleration * t * t / 2, nodes[i + 1].distance),
+                     v0 + acceleration * t, acceleration);
+            }
+            segmentStart = segmentEnd;
+        }
+        emit(length, endVelocity, 0);
+        profile.m_duration = Time(segmentStart);
+        return profile;
+    }
+
+    // S-curve: simulate the robot one period at a time, applying the largest jerk from which it can still brake
+    // without exceeding the velocity limits
+    const auto limitAt = [&](Cursor& cursor, double distance) {
+        const double f = cursor.fraction(nodes, distance);
+        return nodes[cursor.node].limit + (nodes[cursor.node + 1].limit - nodes[cursor.node].limit) * f;
+    };
+    struct State {
+            double distance;
+            double velocity;
+            double acceleration;
+    };
+    const auto step = [&](State state, double jerk) {
+        const double acceleration = std::clamp(state.acceleration + jerk * dt, -maxAcceleration, maxAcceleration);
+        const double velocity = state.velocity + (state.acceleration + acceleration) / 2 * dt;
+        // the acceleration changes linearly during the step
+        state.distance += state.velocity * dt + (2 * state.acceleration + acceleration) * dt * dt / 6;
+        if (velocity <= 0) return State {state.distance, 0, std::max(acceleration, 0.0)};
+        return State {state.distance, velocity, acceleration};
+    };
+    // jerk which brakes as hard as possible, but ramps the acceleration back to 0 as the velocity reaches the end
+    // velocity, instead of stopping with the acceleration at its limit. The ramp starts when braking for one more
+    // period would make it too late
+    const auto brake = [&](const State& state) {
+        if (state.acceleration < 0) {
+            const double acceleration = std::max(state.acceleration - maxJerk * dt, -maxAcceleration);
+            const double velocity = state.velocity + (state.acceleration + acceleration) / 2 * dt;
+            if (velocity - endVelocity <= acceleration * acceleration / (2 * maxJerk)) {
+                return std::min(maxJerk, -state.acceleration / dt);
+            }
+        }
+        return -maxJerk;
+    };
+    // whether braking from a state stays under every later velocity limit
+    const auto safe = [&](State state, Cursor cursor) {
+        for (std::size_t i = 0; i < MAX_ENTRIES; i++) {
+            const double squared = state.velocity * state.velocity;
+            if (state.distance >= length) return squared <= nodes.back().limit + LIMIT_TOLERANCE;
+            if (squared > limitAt(cursor, state.distance) + LIMIT_TOLERANCE) return false;
+            if (state.velocity == 0) return true;
+            state = step(state, brake(state));
+        }
+        return true;
+    };
+    State state {0, std::sqrt(nodes.front().limit), 0};
+    Cursor cursor;
+    while (profile.m_entries.size() < MAX_ENTRIES) {
+        emit(state.distance, state.velocity, state.acceleration);
+        if (length - state.distance < END_TOLERANCE &&
+            state.velocity * state.velocity <= nodes.back().limit + LIMIT_TOLERANCE) {
+            break;
+        }
+        // bisect for the largest jerk which is still safe
+        double jerk = maxJerk;
+        if (!safe(step(state, jerk), cursor)) {
+            double low = -maxJerk;
+            double high = maxJerk;
+            for (int i = 0; i < 16; i++) {
+                const double mid = (low + high) / 2;
+                if (safe(step(state, mid), cursor)) low = mid;
+                else high = mid;
+            }
+            jerk = low;
+        }
+        state = step(state, jerk);
+        limitAt(cursor, state.distance);
+        if (state.distance >= length) {
+            state.distance = length;
+            state.velocity = std::min(state.velocity, std::sqrt(nodes.back().limit));
+            state.acceleration = 0;
+        }
+    }
+    profile.m_entries.back().distance = LengthF(length);
+    profile.m_duration = period * double(profile.m_entries.size() - 1);
+    return profile;
+}
+
+ProfilePoint MotionProfile::sample(Time time) const {
+    if (m_entries.empty()) return ProfilePoint();
+    const double t = std::clamp(time, 0_sec, m_duration).internal();
+    const double period = m_period.internal();
+    const std::size_t i =
+        std::min(std::size_t(t / period + INDEX_EPSILON), m_entries.size() - (m_entries.size() > 1 ? 2 : 1));
+    const Entry& a = m_entries[i];
+    const Entry& b = m_entries[std::min(i + 1, m_entries.size() - 1)];
+    // the last interval is shorter than a period if the duration isn't a multiple of it
+    const double span = std::min(period, m_duration.internal() - i * period);
+    const float f = span > 0 ? float(std::max(t - i * period, 0.0) / span) : 0.0f;
+    const auto lerp = [f](auto x, auto y) { return x + (y - x) * f; };
+    return {Time(t),
+            Length(lerp(a.distance, b.distance)),
+            LinearVelocity(lerp(a.velocity, b.velocity)),
+            LinearAcceleration(a.acceleration),
+            Curvature(lerp(a.curvature, b.curvature)),
+            units::Pose(Length(lerp(a.x, b.x)), Length(lerp(a.y, b.y)), Angle(lerp(a.heading, b.heading)))};
+}
+
+Time MotionProfile::getDuration() const { return m_duration; }
+
+Length MotionProfile::getLength() const { return m_entries.empty() ? 0_m : Length(m_entries.back().distance); }
+
+std::size_t MotionProfile::size() const { return m_entries.size(); }
+} // namespace lemlib
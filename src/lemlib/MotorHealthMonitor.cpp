@@ -0,0 +1,149 @@
+#include "lemlib/MotorHealthMonitor.hpp"
+#include "LemLog/logger/topic.hpp"
+#include "pros/error.h"
+#include "pros/motors.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+
+namespace lemlib {
+using HealthLog = logger::Topic<"lemlib/motors/health">;
+
+MotorHealthMonitor::MotorHealthMonitor(DeratingConfig config, Time period, std::uint32_t priority)
+    : m_config(config),
+      m_period(std::max<std::uint32_t>(1, std::round(to_msec(period)))),
+      m_priority(priority) {}
+
+int MotorHealthMonitor::addMotor(int port) {
+    if (m_running) {
+        errno = EBUSY;
+        return INT_MAX;
+    }
+    if (m_count == MAX_MONITORED_MOTORS) {
+        errno = ENOMEM;
+        return INT_MAX;
+    }
+    m_entries[m_count] = {
+        .temperature = EmaFilter<Temperature>::fromCutoff(m_config.temperatureCutoff, from_msec(m_period)),
+        .limit = from_amp(INFINITY)};
+    m_working.motors[m_count] = {.port = port};
+    return m_count++;
+}
+
+int MotorHealthMonitor::addGroup(CachedMotorGroup& group) {
+    if (m_running) {
+        errno = EBUSY;
+        return INT_MAX;
+    }
+    const CachedMotorGroup::Snapshot& snapshot = group.getSnapshot();
+    if (m_count + snapshot.count > MAX_MONITORED_MOTORS) {
+        errno = ENOMEM;
+        return INT_MAX;
+    }
+    const int first = m_count;
+    for (std::size_t i = 0; i < snapshot.count; i++) addMotor(snapshot.ports[i]);
+    return first;
+}
+
+int MotorHealthMonitor::start() {
+    if (m_running) {
+        errno = EBUSY;
+        return INT_MAX;
+    }
+    m_running = true;
+    // publish the first readings before returning, so they are never read before the motors are
+    sweep();
+    m_task.emplace(
+        [this] {
+            std::uint32_t now = pros::millis();
+            while (m_running) {
+                pros::Task::delay_until(&now, m_period);
+                sweep();
+            }
+        },
+        m_priority, TASK_STACK_DEPTH_DEFAULT, "LemLib motor health");
+    return 0;
+}
+
+void MotorHealthMonitor::stop() {
+    if (!m_running) return;
+    m_running = false;
+    m_task->join();
+    m_task.reset();
+}
+
+Current MotorHealthMonitor::deratedLimit(Temperature temperature) const {
+    const Temperature span = m_config.endTemperature - m_config.startTemperature;
+    // a span of 0 derates all at once
+    const double progress = span > 0_kelvin ? ((temperature - m_config.startTemperature) / span).internal()
+                                            : double(temperature >= m_config.endTemperature);
+    const double fraction = 1 - std::clamp(progress, 0.0, 1.0) * (1 - m_config.minimumFraction);
+    return m_config.currentLimit * fraction;
+}
+
+void MotorHealthMonitor::sweep() {
+    const Current step = from_amp(m_config.slewRate * m_period / 1000.0);
+    for (std::size_t i = 0; i < m_count; i++) {
+        Entry& entry = m_entries[i];
+        MotorHealth& health = m_working.motors[i];
+        const MotorHealthState previous = health.state;
+        // the output velocity doesn't affect any of the measurements used here
+        Motor motor(health.port, 200_rpm);
+        const Temperature measured = motor.getTemperature();
+        if (motor.isConnected() != 1 || units::to_kelvin(measured) == INFINITY) {
+            if (previous != MotorHealthState::DISCONNECTED) HealthLog::warn("motor %d disconnected", health.port);
+            health.state = MotorHealthState::DISCONNECTED;
+            health.current = 0_amp;
+            health.limit = 0_amp;
+            // a reconnected motor may have lost its current limit, and its temperature changed while it was gone
+            entry.limit = from_amp(INFINITY);
+            entry.temperature.reset();
+            continue;
+        }
+        health.temperature = entry.temperature.update(measured);
+        const std::int32_t current = pros::c::motor_get_current_draw(health.port);
+        health.current = current == PROS_ERR ? from_amp(INFINITY) : from_amp(current / 1000.0);
+
+        // move towards the limit for the temperature, or jump to it if the limit has to be applied again
+        const Current target = deratedLimit(health.temperature);
+        const Current limit = to_amp(entry.limit) == INFINITY
+                                  ? target
+                                  : entry.limit + std::clamp(target - entry.limit, -1.0 * step, step);
+        if (limit != entry.limit && motor.setCurrentLimit(limit) == 0) entry.limit = limit;
+        health.limit = entry.limit;
+
+        if (health.temperature >= m_config.overheatTemperature) health.state = MotorHealthState::OVERHEATED;
+        else if (target < m_config.currentLimit) health.state = MotorHealthState::DERATED;
+        else health.state = MotorHealthState::NORMAL;
+        if (health.state == previous) continue;
+        const double celsius = units::to_celsius(health.temperature);
+        switch (health.state) {
+            case MotorHealthState::OVERHEATED:
+                HealthLog::error("motor %d overheated at %.1f C", health.port, celsius);
+                break;
+            case MotorHealthState::DERATED:
+                HealthLog::warn("motor %d derating at %.1f C, limit %.2f A", health.port, celsius, to_amp(target));
+                break;
+            default:
+                if (previous == MotorHealthState::DISCONNECTED) {
+                    HealthLog::info("motor %d connected at %.1f C", health.port, celsius);
+                } else {
+                    HealthLog::info("motor %d recovered at %.1f C", health.port, celsius);
+                }
+                break;
+        }
+    }
+    m_working.sweep++;
+    m_published.write(m_working);
+}
+
+MotorHealthSnapshot MotorHealthMonitor::getSnapshot() const { return m_published.read(); }
+
+MotorHealth MotorHealthMonitor::getMotor(int id) const {
+    if (id < 0 || std::size_t(id) >= m_count) return {};
+    return getSnapshot().motors[id];
+}
+
+MotorHealthMonitor::~MotorHealthMonitor() { stop(); }
+} // namespace lemlib
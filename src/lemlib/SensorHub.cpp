@@ -0,0 +1,116 @@
+#include "lemlib/SensorHub.hpp"
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <utility>
+
+namespace lemlib {
+SensorHub::SensorHub(Time period, std::uint32_t priority)
+    : m_period(std::max<std::uint32_t>(1, std::round(to_msec(period)))),
+      m_priority(priority),
+      m_estimators([]<std::size_t... I>(std::index_sequence<I...>) {
+          // the estimator has no default constructor, so every element is made explicitly
+          return std::array {((void)I, VelocityEstimator::window())...};
+      }(std::make_index_sequence<MAX_HUB_ENCODERS>())) {}
+
+int SensorHub::addEncoder(Encoder& encoder) {
+    if (m_running) {
+        errno = EBUSY;
+        return INT_MAX;
+    }
+    if (m_encoderCount == MAX_HUB_ENCODERS) {
+        errno = ENOMEM;
+        return INT_MAX;
+    }
+    m_encoders[m_encoderCount] = &encoder;
+    return m_encoderCount++;
+}
+
+int SensorHub::addImu(Imu& imu) {
+    if (m_running) {
+        errno = EBUSY;
+        return INT_MAX;
+    }
+    if (m_imuCount == MAX_HUB_IMUS) {
+        errno = ENOMEM;
+        return INT_MAX;
+    }
+    m_imus[m_imuCount] = &imu;
+    return m_imuCount++;
+}
+
+int SensorHub::setVelocityEstimator(int id, const VelocityEstimator& estimator) {
+    if (m_running) {
+        errno = EBUSY;
+        return INT_MAX;
+    }
+    if (id < 0 || std::size_t(id) >= m_encoderCount) {
+        errno = EINVAL;
+        return INT_MAX;
+    }
+    m_estimators[id] = estimator;
+    return 0;
+}
+
+int SensorHub::start() {
+    if (m_running) {
+        errno = EBUSY;
+        return INT_MAX;
+    }
+    m_running = true;
+    // publish the first readings before returning, so they are never read before the sensors are
+    sweep();
+    m_task.emplace(
+        [this] {
+            std::uint32_t now = pros::millis();
+            while (m_running) {
+                pros::Task::delay_until(&now, m_period);
+                sweep();
+            }
+        },
+        m_priority, TASK_STACK_DEPTH_DEFAULT, "LemLib sensor hub");
+    return 0;
+}
+
+void SensorHub::stop() {
+    if (!m_running) return;
+    m_running = false;
+    m_task->join();
+    m_task.reset();
+}
+
+void SensorHub::sweep() {
+    for (std::size_t i = 0; i < m_encoderCount; i++) {
+        SensorReading& reading = m_working.encoders[i];
+        reading.angle = m_encoders[i]->getAngle();
+        reading.time = pros::micros();
+        reading.valid = to_stDeg(reading.angle) != INFINITY;
+        // the estimates are only published through the snapshot, so other tasks never read a half written estimator
+        if (reading.valid) m_estimators[i].update(reading.angle, from_sec(reading.time / 1e6));
+        reading.velocity = m_estimators[i].getVelocity();
+        reading.acceleration = m_estimators[i].getAcceleration();
+    }
+    for (std::size_t i = 0; i < m_imuCount; i++) {
+        SensorReading& reading = m_working.imus[i];
+        reading.angle = m_imus[i]->getRotation();
+        reading.time = pros::micros();
+        reading.valid = to_stDeg(reading.angle) != INFINITY;
+    }
+    m_working.sweep++;
+    m_published.write(m_working);
+}
+
+SensorSnapshot SensorHub::getSnapshot() const { return m_published.read(); }
+
+SensorReading SensorHub::getEncoder(int id) const {
+    if (id < 0 || std::size_t(id) >= m_encoderCount) return {};
+    return getSnapshot().encoders[id];
+}
+
+SensorReading SensorHub::getImu(int id) const {
+    if (id < 0 || std::size_t(id) >= m_imuCount) return {};
+    return getSnapshot().imus[id];
+}
+
+SensorHub::~SensorHub() { stop(); }
+} // namespace lemlib
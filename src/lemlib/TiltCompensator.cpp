@@ -0,0 +1,60 @@
+#include "lemlib/TiltCompensator.hpp"
+#include <cerrno>
+#include <climits>
+#include <cmath>
+
+namespace lemlib {
+/** standard gravity, in meters per second squared */
+constexpr double GRAVITY = 9.80665;
+
+TiltCompensator::TiltCompensator(double accelWeight, double gravityTolerance)
+    : m_accelWeight(std::clamp(accelWeight, 0.0, 1.0)),
+      m_gravityTolerance(gravityTolerance) {}
+
+int TiltCompensator::update(Angle roll, Angle pitch, Angle yaw, units::V3Acceleration accel) {
+    if (!std::isfinite(roll.internal()) || !std::isfinite(pitch.internal()) || !std::isfinite(yaw.internal())) {
+        errno = EINVAL;
+        return INT_MAX;
+    }
+    const double ax = accel.getX().internal();
+    const double ay = accel.getY().internal();
+    const double az = accel.getZ().internal();
+    const double horizontal = ay * ay + az * az;
+    const double magnitude = std::sqrt(horizontal + ax * ax);
+    // the accelerometer only measures the direction of gravity while the robot isn't accelerating. A NaN reading fails
+    // the comparison, and is ignored too
+    if (std::abs(magnitude - GRAVITY) <= m_gravityTolerance * GRAVITY) {
+        const double accelRoll = std::atan2(ay, az);
+        const double accelPitch = std::atan2(-ax, std::sqrt(horizontal));
+        m_rollOffset += m_accelWeight * std::remainder(accelRoll - (roll.internal() + m_rollOffset), 2 * M_PI);
+        m_pitchOffset += m_accelWeight * (accelPitch - (pitch.internal() + m_pitchOffset));
+    }
+    m_roll = roll.internal() + m_rollOffset;
+    m_pitch = pitch.internal() + m_pitchOffset;
+    m_yaw = yaw.internal();
+    m_tilt = units::RotationMatrix::fromEuler(Angle(m_roll), Angle(m_pitch), 0_stRad);
+    return 0;
+}
+
+units::V2Position TiltCompensator::compensate(units::V2Position displacement) const {
+    // the displacement is in the plane of the robot, so it has no z component, and the third column isn't needed
+    return units::V2Position(displacement.getX() * m_tilt(0, 0) + displacement.getY() * m_tilt(0, 1),
+                             displacement.getX() * m_tilt(1, 0) + displacement.getY() * m_tilt(1, 1));
+}
+
+Angle TiltCompensator::getRoll() const { return Angle(m_roll); }
+
+Angle TiltCompensator::getPitch() const { return Angle(m_pitch); }
+
+units::Quaternion TiltCompensator::getOrientation() const {
+    return units::Quaternion::fromEuler(Angle(m_roll), Angle(m_pitch), Angle(m_yaw));
+}
+
+void TiltCompensator::reset() {
+    m_roll -= m_rollOffset;
+    m_pitch -= m_pitchOffset;
+    m_rollOffset = 0;
+    m_pitchOffset = 0;
+    m_tilt = units::RotationMatrix::fromEuler(Angle(m_roll), Angle(m_pitch), 0_stRad);
+}
+} // namespace lemlib
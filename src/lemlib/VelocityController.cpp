@@ -0,0 +1,51 @@
+#include "lemlib/VelocityController.hpp"
+#include <cerrno>
+#include <cmath>
+
+namespace lemlib {
+VelocityController::VelocityController(FeedforwardGains feedforward, VelocityPidGains pid, Voltage maxVoltage)
+    : m_feedforward(feedforward),
+      m_pid(pid),
+      m_maxVoltage(units::abs(maxVoltage)) {}
+
+Voltage VelocityController::feedforward(AngularVelocity velocity, AngularAcceleration acceleration) const {
+    // there's no friction to overcome when the target is to stand still
+    const Voltage friction = velocity == 0_radps ? 0_volt : m_feedforward.kS * double(units::sgn(velocity));
+    return friction + m_feedforward.kV * velocity + m_feedforward.kA * acceleration;
+}
+
+AngularAcceleration VelocityController::maxAcceleration() const {
+    const double available = to_volt(m_maxVoltage - m_feedforward.kS);
+    const double kA = to_volt(m_feedforward.kA * 1_radps2);
+    if (!(kA > 0) || !(available > 0)) return from_radps2(INFINITY);
+    return from_radps2(available / kA);
+}
+
+Voltage VelocityController::update(AngularVelocity target, AngularAcceleration targetAcceleration,
+                                   AngularVelocity measured, Time dt) {
+    if (!std::isfinite(target.internal()) || !std::isfinite(targetAcceleration.internal()) ||
+        !std::isfinite(measured.internal()) || !std::isfinite(dt.internal()) || !(dt > 0_sec)) {
+        errno = EINVAL;
+        return from_volt(INFINITY);
+    }
+    const AngularVelocity error = target - measured;
+    // the error has no rate of change before there's a previous error to compare against
+    const AngularAcceleration derivative = m_started ? (error - m_previousError) / dt : 0_radps2;
+    const Angle integral = m_integral + error * dt;
+    const Voltage partial = feedforward(target, targetAcceleration) + m_pid.kP * error + m_pid.kD * derivative;
+    const Voltage output = partial + m_pid.kI * integral;
+    // only integrate while the output isn't saturated, or while the error would bring it back
+    if (units::abs(output) <= m_maxVoltage || units::sgn(output) != units::sgn(error)) m_integral = integral;
+    m_previousError = error;
+    m_started = true;
+    return units::clamp(partial + m_pid.kI * m_integral, -1.0 * m_maxVoltage, m_maxVoltage);
+}
+
+void VelocityController::reset() {
+    m_integral = 0_stRad;
+    m_previousError = 0_radps;
+    m_started = false;
+}
+
+FeedforwardGains VelocityController::getFeedforward() const { return m_feedforward; }
+} // namespace lemlib
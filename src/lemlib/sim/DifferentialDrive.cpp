@@ -0,0 +1,60 @@
+#include "lemlib/sim/DifferentialDrive.hpp"
+#include "units/Integrator.hpp"
+
+namespace lemlib::sim {
+DifferentialDrive::DifferentialDrive(DifferentialDriveModel model, units::Pose pose)
+    : m_model(model),
+      m_pose(pose) {}
+
+void DifferentialDrive::setVoltage(Voltage left, Voltage right) {
+    m_leftVoltage = units::clamp(left, -1.0 * m_model.maxVoltage, m_model.maxVoltage);
+    m_rightVoltage = units::clamp(right, -1.0 * m_model.maxVoltage, m_model.maxVoltage);
+}
+
+LinearVelocity DifferentialDrive::integrateSide(LinearVelocity velocity, Voltage voltage, Time dt) const {
+    // static friction holds the side still until the applied voltage can overcome it
+    if (velocity == 0_mps && units::abs(voltage) <= m_model.kS) return 0_mps;
+    // friction opposes the direction of motion, or the applied voltage if the side is stationary
+    const int direction = velocity == 0_mps ? units::sgn(voltage) : units::sgn(velocity);
+    const Voltage friction = m_model.kS * double(direction);
+    const LinearAcceleration acceleration = (voltage - friction - m_model.kV * velocity) / m_model.kA;
+    const LinearVelocity next = velocity + acceleration * dt;
+    // kinetic friction can stop the side, but never reverse it
+    if (velocity != 0_mps && units::signbit(next) != units::signbit(velocity) &&
+        units::abs(voltage) <= m_model.kS) {
+        return 0_mps;
+    }
+    return next;
+}
+
+void DifferentialDrive::update(Time dt) {
+    m_leftVelocity = integrateSide(m_leftVelocity, m_leftVoltage, dt);
+    m_rightVelocity = integrateSide(m_rightVelocity, m_rightVoltage, dt);
+    m_leftDistance += m_leftVelocity * dt;
+    m_rightDistance += m_rightVelocity * dt;
+    // integrate along an arc, which is exact for constant wheel velocities
+    const AngularVelocity angularVelocity =
+        AngularVelocity(((m_rightVelocity - m_leftVelocity) / m_model.trackWidth).internal());
+    m_pose = units::integrate(m_pose, units::VelocityPose((m_leftVelocity + m_rightVelocity) / 2.0, 0_mps,
+                                                          angularVelocity),
+                              dt);
+}
+
+units::Pose DifferentialDrive::getPose() const { return m_pose.toPose(); }
+
+void DifferentialDrive::setPose(units::Pose pose) { m_pose = units::Transform2D(pose); }
+
+LinearVelocity DifferentialDrive::getLeftVelocity() const { return m_leftVelocity; }
+
+LinearVelocity DifferentialDrive::getRightVelocity() const { return m_rightVelocity; }
+
+Angle DifferentialDrive::getLeftAngle() const {
+    return Angle((m_leftDistance / (m_model.wheelDiameter / 2.0)).internal());
+}
+
+Angle DifferentialDrive::getRightAngle() const {
+    return Angle((m_rightDistance / (m_model.wheelDiameter / 2.0)).internal());
+}
+
+Angle DifferentialDrive::getHeading() const { return m_pose.getTheta(); }
+} // namespace lemlib::sim
@@ -0,0 +1,32 @@
+#include "lemlib/sim/SimEncoder.hpp"
+#include <cerrno>
+#include <climits>
+
+namespace lemlib::sim {
+SimEncoder::SimEncoder(std::function<Angle()> source, bool reversed)
+    : m_source(source),
+      m_reversed(reversed) {}
+
+int SimEncoder::isConnected() { return m_connected; }
+
+Angle SimEncoder::getAngle() {
+    if (!m_connected) {
+        errno = ENODEV;
+        return Angle(INFINITY);
+    }
+    const Angle raw = m_source();
+    return (m_reversed ? -1.0 * raw : raw) + m_offset;
+}
+
+int SimEncoder::setAngle(Angle angle) {
+    if (!m_connected) {
+        errno = ENODEV;
+        return INT_MAX;
+    }
+    const Angle raw = m_source();
+    m_offset = angle - (m_reversed ? -1.0 * raw : raw);
+    return 0;
+}
+
+void SimEncoder::setConnected(bool connected) { m_connected = connected; }
+} // namespace lemlib::sim
@@ -0,0 +1,68 @@
+#include "lemlib/sim/SimImu.hpp"
+#include <cerrno>
+#include <climits>
+
+namespace lemlib::sim {
+SimImu::SimImu(std::function<Angle()> source, Time calibrationTime, AngularVelocity drift)
+    : m_source(source),
+      m_calibrationTime(calibrationTime),
+      m_drift(drift) {}
+
+int SimImu::calibrate() {
+    if (isCalibrating()) {
+        errno = EAGAIN;
+        return INT_MAX;
+    }
+    m_calibrated = false;
+    m_calibrationRemaining = m_calibrationTime;
+    return 0;
+}
+
+int SimImu::isCalibrated() { return m_connected && m_calibrated; }
+
+int SimImu::isCalibrating() { return m_connected && m_calibrationRemaining > 0_sec; }
+
+int SimImu::isConnected() { return m_connected; }
+
+Angle SimImu::getRotation() {
+    if (!m_connected) {
+        errno = ENODEV;
+        return Angle(INFINITY);
+    }
+    if (isCalibrating()) {
+        errno = EAGAIN;
+        return Angle(INFINITY);
+    }
+    return m_source() + m_offset;
+}
+
+int SimImu::setRotation(Angle rotation) {
+    if (!m_connected) {
+        errno = ENODEV;
+        return INT_MAX;
+    }
+    if (isCalibrating()) {
+        errno = EAGAIN;
+        return INT_MAX;
+    }
+    m_offset = rotation - m_source();
+    return 0;
+}
+
+void SimImu::update(Time dt) {
+    if (m_calibrationRemaining > 0_sec) {
+        m_calibrationRemaining -= dt;
+        // calibration resets the measured rotation to 0
+        if (m_calibrationRemaining <= 0_sec) {
+            m_calibrationRemaining = 0_sec;
+            m_calibrated = true;
+            m_offset = -1.0 * m_source();
+        }
+        return;
+    }
+    // a real inertial sensor only drifts while it is integrating
+    if (m_calibrated) m_offset += m_drift * dt;
+}
+
+void SimImu::setConnected(bool connected) { m_connected = connected; }
+} // namespace lemlib::sim
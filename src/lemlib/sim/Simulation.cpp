@@ -0,0 +1,27 @@
+#include "lemlib/sim/Simulation.hpp"
+
+namespace lemlib::sim {
+Simulation::Simulation(Time period)
+    : m_period(period) {}
+
+void Simulation::add(Device& device) { m_devices.push_back(&device); }
+
+void Simulation::step() {
+    for (Device* device : m_devices) device->update(m_period);
+    m_ticks++;
+}
+
+void Simulation::advance(Time duration) {
+    // round up so the simulation never runs for less time than requested
+    const std::uint64_t ticks = std::uint64_t(std::ceil(duration.internal() / m_period.internal()));
+    for (std::uint64_t i = 0; i < ticks; i++) step();
+}
+
+// simulated time is calculated from the tick count, rather than accumulated,
+// so it doesn't drift due to floating point error over long simulations
+Time Simulation::getTime() const { return m_period * double(m_ticks); }
+
+std::uint64_t Simulation::getTicks() const { return m_ticks; }
+
+Time Simulation::getPeriod() const { return m_period; }
+} // namespace lemlib::sim
@@ -0,0 +1,137 @@
+// Fits the constants of a drivetrain to a recorded drivetrain characterization.
+//
+// usage: drivetrain-characterize <recording> [wheel diameter in] [distance in]
+//        drivetrain-characterize --simulate <recording>
+//
+// The recording is the telemetry stream written by lemlib::DrivetrainCharacterization, captured with e.g
+// `pros terminal --raw > recording.bin`. The wheel diameter is the nominal diameter of the wheels, 3.25 in by default.
+// If the distance the robot drove in the forward quasistatic test is given, the effective wheel diameter is
+// calculated from it instead.
+//
+// With --simulate, a characterization of a simulated drivetrain is recorded instead, so the whole process can be
+// tried without a robot.
+#include "LemLog/logger/telemetry.hpp"
+#include "lemlib/DrivetrainCharacterization.hpp"
+#include "lemlib/sim/DifferentialDrive.hpp"
+#include "lemlib/sim/SimEncoder.hpp"
+#include "lemlib/sim/SimImu.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// the telemetry clock is a plain function, so the simulation it reads has to be global
+static lemlib::sim::Simulation simulation(1_msec);
+
+static int simulate(const char* path) {
+    std::FILE* output = std::fopen(path, "wb");
+    if (output == nullptr) {
+        std::perror(path);
+        return 1;
+    }
+    logger::Telemetry telemetry(output, [] { return std::uint32_t(std::llround(to_sec(simulation.getTime()) * 1e6)); });
+    const lemlib::sim::DifferentialDriveModel model;
+    lemlib::sim::DifferentialDrive drive(model);
+    lemlib::sim::SimEncoder left([&] { return drive.getLeftAngle(); });
+    lemlib::sim::SimEncoder right([&] { return drive.getRightAngle(); });
+    lemlib::sim::SimImu imu([&] { return drive.getHeading(); }, 0_sec);
+    simulation.add(drive);
+    simulation.add(imu);
+
+    lemlib::DrivetrainCharacterization characterization(left, right, imu, telemetry);
+    // the distance someone would measure with a tape measure, for trying the distance argument. The robot starts at
+    // the origin, and has stopped by the time the backward quasistatic test starts
+    Length distance = 0_in;
+    while (!characterization.isDone()) {
+        const auto [leftVoltage, rightVoltage] = characterization.update(simulation.getTime());
+        if (characterization.getTest() == lemlib::DrivetrainTest::QUASISTATIC_BACKWARD && distance == 0_in) {
+            distance = units::abs(drive.getPose().getX());
+        }
+        drive.setVoltage(leftVoltage, rightVoltage);
+        simulation.advance(10_msec);
+    }
+    std::fclose(output);
+    std::fprintf(stderr, "recorded %.1f s of simulated characterization to %s\n", to_sec(simulation.getTime()), path);
+    std::fprintf(stderr, "simulated model: kS %.3f V, kV %.3f V/(m/s), kA %.3f V/(m/s^2), track width %.2f in, "
+                         "wheel diameter %.2f in\n",
+                 to_volt(model.kS), to_volt(model.kV * 1_mps), to_volt(model.kA * 1_mps2), to_in(model.trackWidth),
+                 to_in(model.wheelDiameter));
+    std::fprintf(stderr, "distance driven in the forward quasistatic test: %.3f in\n", to_in(distance));
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc == 3 && std::strcmp(argv[1], "--simulate") == 0) return simulate(argv[2]);
+    if (argc < 2 || argc > 4) {
+        std::fprintf(stderr, "usage: %s <recording> [wheel diameter in] [distance in]\n", argv[0]);
+        std::fprintf(stderr, "       %s --simulate <recording>\n", argv[0]);
+        return 2;
+    }
+    std::FILE* input = std::fopen(argv[1], "rb");
+    if (input == nullptr) {
+        std::perror(argv[1]);
+        return 1;
+    }
+    const Length wheelDiameter = from_in(argc >= 3 ? std::atof(argv[2]) : 3.25);
+    const Length distance = from_in(argc == 4 ? std::atof(argv[3]) : 0);
+
+    // fields are looked up by name, so channels with extra fields can still be read
+    const std::vector<std::string> names = {"test", "left_V", "right_V", "left_rad", "right_rad", "rotation_rad"};
+    std::vector<int> columns(names.size(), -1);
+    int channel = -1;
+    lemlib::DrivetrainFit fit;
+    std::size_t samples = 0;
+    std::size_t skipped = 0;
+    auto onSchema = [&](const logger::TelemetryDecoder::Schema& schema) {
+        if (schema.name != "characterization/drivetrain") return;
+        channel = schema.id;
+        for (std::size_t i = 0; i < names.size(); i++) {
+            const auto field = std::find_if(schema.fields.begin(), schema.fields.end(),
+                                            [&](const auto& field) { return field.first == names[i]; });
+            columns[i] = field == schema.fields.end() ? -1 : field - schema.fields.begin();
+        }
+    };
+    auto onSample = [&](const logger::TelemetryDecoder::Schema& schema, std::uint32_t timestamp,
+                        const std::vector<double>& values) {
+        if (schema.id != channel) return;
+        const auto value = [&](std::size_t i) { return columns[i] < 0 ? double(NAN) : values[columns[i]]; };
+        const lemlib::DrivetrainRecord record = {.test = lemlib::DrivetrainTest(value(0)),
+                                                 .leftVoltage = from_volt(value(1)),
+                                                 .rightVoltage = from_volt(value(2)),
+                                                 .leftAngle = Angle(value(3)),
+                                                 .rightAngle = Angle(value(4)),
+                                                 .rotation = Angle(value(5)),
+                                                 .time = from_sec(timestamp / 1e6)};
+        if (fit.add(record) != 0) skipped++;
+        samples++;
+    };
+
+    logger::TelemetryDecoder decoder(onSchema, onSample);
+    std::uint8_t buffer[4096];
+    std::size_t read;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), input)) > 0) decoder.feed(buffer, read);
+    std::fclose(input);
+    std::fprintf(stderr, "decoded %zu samples, skipped %zu, %u malformed frames\n", samples, skipped,
+                 decoder.getMalformed());
+    if (channel < 0) {
+        std::fprintf(stderr, "no characterization/drivetrain channel in %s\n", argv[1]);
+        return 1;
+    }
+
+    const lemlib::DrivetrainConstants constants = fit.solve(wheelDiameter, distance);
+    if (to_volt(constants.kS) == INFINITY) {
+        std::fprintf(stderr, "the samples don't vary enough to fit the constants, was the test cut short?\n");
+        return 1;
+    }
+    const lemlib::FeedforwardFit& wheel = fit.getFeedforwardFit();
+    std::printf("kS             %.4f V\n", to_volt(constants.kS));
+    std::printf("kV             %.4f V/(m/s)\n", to_volt(constants.kV * 1_mps));
+    std::printf("kA             %.4f V/(m/s^2)\n", to_volt(constants.kA * 1_mps2));
+    std::printf("track width    %.3f in\n", to_in(constants.trackWidth));
+    std::printf("wheel diameter %.3f in%s\n", to_in(constants.wheelDiameter), distance == 0_in ? " (nominal)" : "");
+    std::printf("rms error      %.4f V over %zu samples\n", to_volt(wheel.rmsError(wheel.solve())), wheel.getCount());
+    return 0;
+}
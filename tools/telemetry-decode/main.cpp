@@ -0,0 +1,64 @@
+// Converts a recorded telemetry stream into one CSV file per channel.
+//
+// usage: telemetry-decode <recording> [output directory]
+//
+// The recording can be captured with e.g `pros terminal --raw > recording.bin`, or by redirecting the output of a
+// simulation. Each channel is written to <output directory>/<channel>.csv, with a `time_us` column followed by one
+// column per field. Slashes in channel names are replaced with underscores.
+#include "LemLog/logger/telemetry.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <string>
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        std::fprintf(stderr, "usage: %s <recording> [output directory]\n", argv[0]);
+        return 2;
+    }
+    std::FILE* input = std::fopen(argv[1], "rb");
+    if (input == nullptr) {
+        std::perror(argv[1]);
+        return 1;
+    }
+    const std::string directory = argc == 3 ? argv[2] : ".";
+
+    std::map<std::uint8_t, std::FILE*> outputs;
+    std::size_t samples = 0;
+    auto onSchema = [&](const logger::TelemetryDecoder::Schema& schema) {
+        // a resent schema for a channel which is already open doesn't start a new file
+        if (outputs.contains(schema.id)) return;
+        std::string name = schema.name;
+        std::replace(name.begin(), name.end(), '/', '_');
+        const std::string path = directory + "/" + name + ".csv";
+        std::FILE* output = std::fopen(path.c_str(), "w");
+        if (output == nullptr) {
+            std::perror(path.c_str());
+            return;
+        }
+        std::fprintf(output, "time_us");
+        for (const auto& field : schema.fields) std::fprintf(output, ",%s", field.first.c_str());
+        std::fprintf(output, "\n");
+        outputs[schema.id] = output;
+    };
+    auto onSample = [&](const logger::TelemetryDecoder::Schema& schema, std::uint32_t timestamp,
+                        const std::vector<double>& values) {
+        auto output = outputs.find(schema.id);
+        if (output == outputs.end()) return;
+        std::fprintf(output->second, "%u", timestamp);
+        for (const double value : values) std::fprintf(output->second, ",%.9g", value);
+        std::fprintf(output->second, "\n");
+        samples++;
+    };
+
+    logger::TelemetryDecoder decoder(onSchema, onSample);
+    std::uint8_t buffer[4096];
+    std::size_t read;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), input)) > 0) decoder.feed(buffer, read);
+    std::fclose(input);
+    for (const auto& output : outputs) std::fclose(output.second);
+
+    std::fprintf(stderr, "decoded %zu samples on %zu channels, %u malformed frames\n", samples, outputs.size(),
+                 decoder.getMalformed());
+    return 0;
+}